@@ -0,0 +1,177 @@
+//##########################################################################
+//#                                                                        #
+//#                              CloudComPy                                #
+//#                                                                        #
+//#  This program is free software; you can redistribute it and/or modify  #
+//#  it under the terms of the GNU General Public License as published by  #
+//#  the Free Software Foundation; either version 3 of the License, or     #
+//#  any later version.                                                    #
+//#                                                                        #
+//#  This program is distributed in the hope that it will be useful,       #
+//#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+//#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+//#  GNU General Public License for more details.                          #
+//#                                                                        #
+//#  You should have received a copy of the GNU General Public License     #
+//#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+//#                                                                        #
+//#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+//#                                                                        #
+//##########################################################################
+
+#ifndef CLOUDCOMPY_PYAPI_SYMEIGEN3X3_H_
+#define CLOUDCOMPY_PYAPI_SYMEIGEN3X3_H_
+
+#include <algorithm>
+#include <cmath>
+
+//! Closed-form eigen decomposition of batches of 3x3 symmetric matrices
+/*! Non iterative algorithm from D. Eberly, "A Robust Eigensolver for 3x3 Symmetric Matrices" (Geometric Tools):
+ *  the eigen values are the roots of the characteristic polynomial (trigonometric solution),
+ *  the eigen vector of the most isolated eigen value is obtained from cross products of the rows of A - l.I,
+ *  the second one is an eigen vector of the restriction of A to the orthogonal plane (2x2).
+ *
+ *  The matrices are stored by batches, as a structure of arrays, and all the lanes of a batch follow
+ *  the same instructions (selections instead of data dependent branches). With the default build options,
+ *  the loop over the lanes stays scalar (calls to std::acos, std::cos and std::sqrt): the gain over Jacobi
+ *  comes from the non iterative algorithm, the layout only keeps the data of a batch contiguous.
+ *  The eigen values are refined by the Rayleigh quotients of the eigen vectors (close eigen values).
+ */
+namespace SymEigen3x3
+{
+    constexpr unsigned BatchSize = 16;
+
+    //! a batch of symmetric matrices (upper triangle) and their eigen decomposition
+    struct Batch
+    {
+        double a00[BatchSize], a01[BatchSize], a02[BatchSize];
+        double a11[BatchSize], a12[BatchSize], a22[BatchSize];
+        double values[3][BatchSize];        //!< eigen values, in decreasing order
+        double vectors[3][3][BatchSize];    //!< vectors[k][c][i]: component c of the eigen vector k of the matrix i (unit length)
+    };
+
+    //! eigen decomposition of the count first matrices of the batch (count <= BatchSize)
+    /*! the unused lanes are set to null matrices
+     */
+    inline void Solve(Batch& b, unsigned count)
+    {
+        for (unsigned i = count; i < BatchSize; ++i)
+        {
+            b.a00[i] = b.a01[i] = b.a02[i] = 0;
+            b.a11[i] = b.a12[i] = b.a22[i] = 0;
+        }
+
+        const double twoThirdsPi = 2.0943951023931954923; // 2.pi/3
+        for (unsigned i = 0; i < BatchSize; ++i)
+        {
+            //scaling by the largest coefficient, to avoid overflows and underflows
+            double maxAbs = std::max(std::max(std::max(std::abs(b.a00[i]), std::abs(b.a01[i])), std::max(std::abs(b.a02[i]), std::abs(b.a11[i]))),
+                                     std::max(std::abs(b.a12[i]), std::abs(b.a22[i])));
+            double s = (maxAbs > 0 ? 1.0 / maxAbs : 1.0);
+            double m00 = b.a00[i] * s, m01 = b.a01[i] * s, m02 = b.a02[i] * s;
+            double m11 = b.a11[i] * s, m12 = b.a12[i] * s, m22 = b.a22[i] * s;
+
+            //eigen values of B = (A - q.I) / p, with q = trace(A) / 3 and p² = trace((A - q.I)²) / 6
+            double q = (m00 + m11 + m22) / 3.0;
+            double c00 = m00 - q, c11 = m11 - q, c22 = m22 - q;
+            double p = std::sqrt((c00 * c00 + c11 * c11 + c22 * c22 + 2.0 * (m01 * m01 + m02 * m02 + m12 * m12)) / 6.0);
+            double invP = (p > 0 ? 1.0 / p : 0.0);
+            double b00 = c00 * invP, b11 = c11 * invP, b22 = c22 * invP;
+            double b01 = m01 * invP, b02 = m02 * invP, b12 = m12 * invP;
+            double halfDet = 0.5 * (b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02) + b02 * (b01 * b12 - b11 * b02));
+            halfDet = std::min(std::max(halfDet, -1.0), 1.0);
+            double angle = std::acos(halfDet) / 3.0;
+            double beta2 = 2.0 * std::cos(angle);
+            double beta0 = 2.0 * std::cos(angle + twoThirdsPi);
+            double eval0 = q + p * beta0; // smallest
+            double eval2 = q + p * beta2; // largest
+
+            //the most isolated eigen value first: the largest one if halfDet >= 0, else the smallest one
+            const bool largestFirst = (halfDet >= 0);
+            double l = (largestFirst ? eval2 : eval0);
+
+            //eigen vector: the largest cross product of two rows of A - l.I
+            double r0x = m00 - l, r0y = m01, r0z = m02;
+            double r1x = m01, r1y = m11 - l, r1z = m12;
+            double r2x = m02, r2y = m12, r2z = m22 - l;
+            double x01 = r0y * r1z - r0z * r1y, y01 = r0z * r1x - r0x * r1z, z01 = r0x * r1y - r0y * r1x;
+            double x02 = r0y * r2z - r0z * r2y, y02 = r0z * r2x - r0x * r2z, z02 = r0x * r2y - r0y * r2x;
+            double x12 = r1y * r2z - r1z * r2y, y12 = r1z * r2x - r1x * r2z, z12 = r1x * r2y - r1y * r2x;
+            double d01 = x01 * x01 + y01 * y01 + z01 * z01;
+            double d02 = x02 * x02 + y02 * y02 + z02 * z02;
+            double d12 = x12 * x12 + y12 * y12 + z12 * z12;
+            const bool use01 = (d01 >= d02 && d01 >= d12);
+            const bool use02 = (!use01 && d02 >= d12);
+            double wx = (use01 ? x01 : (use02 ? x02 : x12));
+            double wy = (use01 ? y01 : (use02 ? y02 : y12));
+            double wz = (use01 ? z01 : (use02 ? z02 : z12));
+            double dMax = (use01 ? d01 : (use02 ? d02 : d12));
+            //multiple eigen value (A = l.I): any vector
+            const bool anyW = !(dMax > 0);
+            double invW = (anyW ? 0.0 : 1.0 / std::sqrt(dMax));
+            wx = (anyW ? 1.0 : wx * invW);
+            wy = (anyW ? 0.0 : wy * invW);
+            wz = (anyW ? 0.0 : wz * invW);
+
+            //orthonormal basis (U, V) of the plane orthogonal to W
+            const bool xLarger = (std::abs(wx) > std::abs(wy));
+            double ux = (xLarger ? -wz : 0.0);
+            double uy = (xLarger ? 0.0 : wz);
+            double uz = (xLarger ? wx : -wy);
+            double invU = 1.0 / std::sqrt(ux * ux + uy * uy + uz * uz);
+            ux *= invU; uy *= invU; uz *= invU;
+            double vx = wy * uz - wz * uy, vy = wz * ux - wx * uz, vz = wx * uy - wy * ux;
+
+            //second eigen vector: restriction C = [U V]^T A [U V] of A to the orthogonal plane,
+            //closed-form 2x2 decomposition (more accurate than the null vector of C - eval1.I for close eigen values)
+            double aux = m00 * ux + m01 * uy + m02 * uz, auy = m01 * ux + m11 * uy + m12 * uz, auz = m02 * ux + m12 * uy + m22 * uz;
+            double avx = m00 * vx + m01 * vy + m02 * vz, avy = m01 * vx + m11 * vy + m12 * vz, avz = m02 * vx + m12 * vy + m22 * vz;
+            double n00 = ux * aux + uy * auy + uz * auz;
+            double n01 = ux * avx + uy * avy + uz * avz;
+            double n11 = vx * avx + vy * avy + vz * avz;
+            double hd = 0.5 * (n00 - n11);
+            double hr = std::sqrt(hd * hd + n01 * n01);
+            double cu = (hd >= 0 ? hd + hr : n01);
+            double cv = (hd >= 0 ? n01 : hr - hd);
+            double dc = cu * cu + cv * cv;
+            //C = c.I (double eigen value): any vector of the plane
+            const bool anyUV = !(dc > 0);
+            double invC = (anyUV ? 0.0 : 1.0 / std::sqrt(dc));
+            cu = (anyUV ? 1.0 : cu * invC);
+            cv = (anyUV ? 0.0 : cv * invC);
+            //(cu, cv) is for the largest eigen value of C: the middle one of A if W is for the largest one, else the orthogonal one
+            double tu = cu;
+            cu = (largestFirst ? tu : -cv);
+            cv = (largestFirst ? cv : tu);
+            double ex = cu * ux + cv * vx, ey = cu * uy + cv * vy, ez = cu * uz + cv * vz;
+
+            //third eigen vector: cross product (direct frame with the largest, middle and smallest eigen vectors)
+            double fx = (largestFirst ? wy * ez - wz * ey : ey * wz - ez * wy);
+            double fy = (largestFirst ? wz * ex - wx * ez : ez * wx - ex * wz);
+            double fz = (largestFirst ? wx * ey - wy * ex : ex * wy - ey * wx);
+
+            double v0x = (largestFirst ? wx : fx), v0y = (largestFirst ? wy : fy), v0z = (largestFirst ? wz : fz);
+            double v2x = (largestFirst ? fx : wx), v2y = (largestFirst ? fy : wy), v2z = (largestFirst ? fz : wz);
+
+            //the trigonometric roots lose accuracy for close eigen values: Rayleigh quotients of the (accurate) eigen vectors
+            double r0 = m00 * v0x * v0x + m11 * v0y * v0y + m22 * v0z * v0z + 2.0 * (m01 * v0x * v0y + m02 * v0x * v0z + m12 * v0y * v0z);
+            double r1 = m00 * ex * ex + m11 * ey * ey + m22 * ez * ez + 2.0 * (m01 * ex * ey + m02 * ex * ez + m12 * ey * ez);
+            double r2 = m00 * v2x * v2x + m11 * v2y * v2y + m22 * v2z * v2z + 2.0 * (m01 * v2x * v2y + m02 * v2x * v2z + m12 * v2y * v2z);
+
+            b.values[0][i] = r0 * maxAbs;
+            b.values[1][i] = std::min(r1, r0) * maxAbs;
+            b.values[2][i] = std::min(r2, std::min(r1, r0)) * maxAbs;
+            b.vectors[0][0][i] = v0x;
+            b.vectors[0][1][i] = v0y;
+            b.vectors[0][2][i] = v0z;
+            b.vectors[1][0][i] = ex;
+            b.vectors[1][1][i] = ey;
+            b.vectors[1][2][i] = ez;
+            b.vectors[2][0][i] = v2x;
+            b.vectors[2][1][i] = v2y;
+            b.vectors[2][2][i] = v2z;
+        }
+    }
+}
+
+#endif /* CLOUDCOMPY_PYAPI_SYMEIGEN3X3_H_ */
@@ -21,6 +21,7 @@
 
 #include "pyCC.h"
 #include "initCC.h"
+#include "SymEigen3x3.h"
 
 //libs/qCC_db
 #include <CCTypes.h>
@@ -32,8 +33,11 @@
 #include <MeshSamplingTools.h>
 #include <ccPointCloud.h>
 #include <DistanceComputationTools.h>
+#include <DgmOctreeReferenceCloud.h>
+#include <Jacobi.h>
 #include <ParallelSort.h>
 #include <PointProjectionTools.h>
+#include <ReferenceCloud.h>
 #include <ccScalarField.h>
 #include <ccSensor.h>
 #include <ccMesh.h>
@@ -62,7 +66,14 @@
 
 //system
 #include <unordered_set>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
 #include <string.h>
 #include <vector>
 #include <exception>
@@ -76,6 +87,7 @@
 #include <QString>
 #include <QObject>
 #include <QMessageBox>
+#include <QtConcurrentMap>
 
 #include <viewerPy.h>
 #include <viewerPyApplication.h>
@@ -819,23 +831,65 @@ std::vector<ccHObject*> importFile(const char* filename, CC_SHIFT_MODE mode,
     return result;
 }
 
-bool computeCurvature(CurvatureType option, double radius, std::vector<ccHObject*> clouds)
+//! radius estimated on the clouds of a list of entities (the other entities are skipped), <= 0 if no cloud is usable
+static double EstimateRadiusOfEntities(const std::vector<ccHObject*>& entities)
 {
-    CCTRACE("computeCurvature mode: " << option << " radius: " << radius << " nbClouds: " << clouds.size());
+    std::vector<ccHObject*> clouds;
+    for (ccHObject* entity : entities)
+    {
+        if (dynamic_cast<ccGenericPointCloud*>(entity))
+            clouds.push_back(entity);
+        else if (entity)
+            CCTRACE("entity is not a cloud, skipped for the radius estimation: " << entity->getName().toStdString());
+    }
+    double radius = EstimatePointCloudRadius(clouds);
+    CCTRACE("estimated radius: " << radius);
+    return radius;
+}
+
+bool computeCurvature(CurvatureType option, double radius, std::vector<ccHObject*> clouds, unsigned knn)
+{
+    CCTRACE("computeCurvature mode: " << option << " radius: " << radius << " knn: " << knn << " nbClouds: " << clouds.size());
     for (int i = 0; i < clouds.size(); ++i)
     {
         CCTRACE("entity: "<< i << " name: " << clouds[i]->getName().toStdString());
     }
+    if (radius == 0 && knn == 0)
+    {
+        radius = EstimateRadiusOfEntities(clouds);
+        if (radius <= 0)
+        {
+            CCTRACE("computeCurvature: no radius could be estimated (no cloud with enough points)");
+            return false;
+        }
+    }
+    //knn neighbourhoods: single pass features engine, radius: CCCoreLib (reference of the engine)
+    if (knn != 0)
+        return computeFeatures({}, radius, clouds, { option }, {}, false, CCVector3(0,0,0), knn);
     return pyCC_ComputeGeomCharacteristic(CCCoreLib::GeometricalAnalysisTools::Curvature, option, radius, clouds);
 }
 
-bool computeFeature(CCCoreLib::Neighbourhood::GeomFeature option, double radius, std::vector<ccHObject*> clouds)
+bool computeFeature(CCCoreLib::Neighbourhood::GeomFeature option, double radius, std::vector<ccHObject*> clouds, unsigned knn)
 {
+    //knn neighbourhoods: single pass features engine, radius: CCCoreLib (reference of the engine)
+    if (knn != 0)
+        return computeFeatures({ option }, radius, clouds, {}, {}, false, CCVector3(0,0,0), knn);
 	return pyCC_ComputeGeomCharacteristic(CCCoreLib::GeometricalAnalysisTools::Feature, option, radius, clouds);
 }
 
-bool computeLocalDensity(CCCoreLib::GeometricalAnalysisTools::Density option, double radius, std::vector<ccHObject*> clouds)
+bool computeLocalDensity(CCCoreLib::GeometricalAnalysisTools::Density option, double radius, std::vector<ccHObject*> clouds, unsigned knn)
 {
+    if (radius == 0 && knn == 0)
+    {
+        radius = EstimateRadiusOfEntities(clouds);
+        if (radius <= 0)
+        {
+            CCTRACE("computeLocalDensity: no radius could be estimated (no cloud with enough points)");
+            return false;
+        }
+    }
+    if (knn != 0)
+        return computeFeatures({}, radius, clouds, {}, { option }, false, CCVector3(0,0,0), knn);
 	return pyCC_ComputeGeomCharacteristic(CCCoreLib::GeometricalAnalysisTools::LocalDensity, option, radius, clouds);
 }
 
@@ -844,8 +898,13 @@ bool computeApproxLocalDensity(CCCoreLib::GeometricalAnalysisTools::Density opti
 	return pyCC_ComputeGeomCharacteristic(CCCoreLib::GeometricalAnalysisTools::ApproxLocalDensity, option, radius, clouds);
 }
 
-bool computeRoughnessPy(double radius, std::vector<ccHObject*> clouds, CCVector3 roughnessUpDir)
+bool computeRoughnessPy(double radius, std::vector<ccHObject*> clouds, CCVector3 roughnessUpDir, unsigned knn)
 {
+    if (knn != 0)
+    {
+        CCTRACE("computeRoughness with " << knn << " nearest neighbours");
+        return computeFeatures({}, radius, clouds, {}, {}, true, roughnessUpDir, knn);
+    }
     if (roughnessUpDir.norm2() == 0)
     {
         CCTRACE("computeRoughness without up direction");
@@ -940,21 +999,16 @@ double GetPointCloudRadius(std::vector<ccHObject*> clouds, unsigned knn)
     return sigma;
 }
 
-bool pyCC_ComputeGeomCharacteristic(
+QString pyCC_GetGeomCharacteristicSFName(
     CCCoreLib::GeometricalAnalysisTools::GeomCharacteristic c,
     int subOption,
     PointCoordinateType radius,
-    ccHObject::Container& entities,
-    const CCVector3* roughnessUpDir)
+    unsigned knn)
 {
-// TODO duplicated code from ccLibAlgorithms::ComputeGeomCharacteristic
-    CCTRACE("pyCCComputeGeomCharacteristic "<< subOption << " radius: " << radius);
-    size_t selNum = entities.size();
-    if (selNum < 1)
-        return false;
-
-//generate the right SF name
     QString sfName;
+    QString suffix = QString(" (%1)").arg(radius);
+    if (knn != 0)
+        suffix = (radius > 0 ? QString(" (%1, k=%2)").arg(radius).arg(knn) : QString(" (k=%1)").arg(knn));
 
     switch (c)
     {
@@ -1007,10 +1061,10 @@ bool pyCC_ComputeGeomCharacteristic(
         default:
             assert(false);
             ccLog::Error("Internal error: invalid sub option for Feature computation");
-            return false;
+            return QString();
         }
 
-        sfName += QString(" (%1)").arg(radius);
+        sfName += suffix;
     }
         break;
 
@@ -1030,14 +1084,14 @@ bool pyCC_ComputeGeomCharacteristic(
         default:
             assert(false);
             ccLog::Error("Internal error: invalid sub option for Curvature computation");
-            return false;
+            return QString();
         }
-        sfName += QString(" (%1)").arg(radius);
+        sfName += suffix;
     }
         break;
 
     case CCCoreLib::GeometricalAnalysisTools::LocalDensity:
-        sfName = pyCC_GetDensitySFName(static_cast<CCCoreLib::GeometricalAnalysisTools::Density>(subOption), false, radius);
+        sfName = pyCC_GetDensitySFName(static_cast<CCCoreLib::GeometricalAnalysisTools::Density>(subOption), false, radius, knn);
         break;
 
     case CCCoreLib::GeometricalAnalysisTools::ApproxLocalDensity:
@@ -1045,18 +1099,39 @@ bool pyCC_ComputeGeomCharacteristic(
         break;
 
     case CCCoreLib::GeometricalAnalysisTools::Roughness:
-        sfName = CC_ROUGHNESS_FIELD_NAME + QString(" (%1)").arg(radius);
+        sfName = CC_ROUGHNESS_FIELD_NAME + suffix;
         break;
 
     case CCCoreLib::GeometricalAnalysisTools::MomentOrder1:
-        sfName = CC_MOMENT_ORDER1_FIELD_NAME + QString(" (%1)").arg(radius);
+        sfName = CC_MOMENT_ORDER1_FIELD_NAME + suffix;
         break;
 
     default:
         assert(false);
-        return false;
+        return QString();
     }
 
+    return sfName;
+}
+
+bool pyCC_ComputeGeomCharacteristic(
+    CCCoreLib::GeometricalAnalysisTools::GeomCharacteristic c,
+    int subOption,
+    PointCoordinateType radius,
+    ccHObject::Container& entities,
+    const CCVector3* roughnessUpDir)
+{
+// TODO duplicated code from ccLibAlgorithms::ComputeGeomCharacteristic
+    CCTRACE("pyCCComputeGeomCharacteristic "<< subOption << " radius: " << radius);
+    size_t selNum = entities.size();
+    if (selNum < 1)
+        return false;
+
+//generate the right SF name
+    QString sfName = pyCC_GetGeomCharacteristicSFName(c, subOption, radius);
+    if (sfName.isEmpty())
+        return false;
+
     for (size_t i = 0; i < selNum; ++i)
     {
         //is the ith selected data is eligible for processing?
@@ -1151,28 +1226,1255 @@ bool pyCC_ComputeGeomCharacteristic(
                     break;
                 }
 
-                CCTRACE("Failed to apply processing to cloud " << cloud->getName().toStdString());
+                CCTRACE("Failed to apply processing to cloud " << cloud->getName().toStdString());
+
+                if (pc && sfIdx >= 0)
+                {
+                    pc->deleteScalarField(sfIdx);
+                    sfIdx = -1;
+                }
+
+                ccLog::Error(errorMessage);
+                CCTRACE(errorMessage.toStdString());
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// --- several geometric characteristics computed in a single neighbourhood pass
+
+namespace
+{
+    //! first and second order moments of a neighbourhood
+    /*! coordinates are accumulated relatively to the query point, to preserve the accuracy of the covariance
+     *  on clouds with large coordinates.
+     */
+    struct NeighbourhoodMoments
+    {
+        unsigned count = 0;
+        double sx = 0, sy = 0, sz = 0;
+        double sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+
+        inline void add(double x, double y, double z)
+        {
+            ++count;
+            sx += x; sy += y; sz += z;
+            sxx += x * x; sxy += x * y; sxz += x * z;
+            syy += y * y; syz += y * z; szz += z * z;
+        }
+    };
+
+    //! principal components of a neighbourhood
+    struct NeighbourhoodPCA
+    {
+        CCVector3d G;           //!< gravity center, relatively to the query point
+        double l1, l2, l3;      //!< eigen values, in decreasing order
+        CCVector3d e1, e2, e3;  //!< associated eigen vectors
+    };
+
+    //! a covariance matrix to decompose, and where to store its principal components
+    struct PCARequest
+    {
+        NeighbourhoodMoments moments;
+        NeighbourhoodPCA* pca = nullptr;
+        bool* ok = nullptr;
+    };
+
+    //! eigen decomposition of the covariance matrices of neighbourhoods (at least 3 points each)
+    /*! the matrices are decomposed by batches of SymEigen3x3::BatchSize (closed-form solver)
+     */
+    void ComputeNeighbourhoodPCAs(const std::vector<PCARequest>& requests)
+    {
+        SymEigen3x3::Batch batch;
+        const PCARequest* lanes[SymEigen3x3::BatchSize];
+        unsigned count = 0;
+        auto solve = [&]()
+        {
+            SymEigen3x3::Solve(batch, count);
+            for (unsigned i = 0; i < count; ++i)
+            {
+                NeighbourhoodPCA& pca = *lanes[i]->pca;
+                pca.l1 = batch.values[0][i];
+                pca.l2 = batch.values[1][i];
+                pca.l3 = batch.values[2][i];
+                pca.e1 = CCVector3d(batch.vectors[0][0][i], batch.vectors[0][1][i], batch.vectors[0][2][i]);
+                pca.e2 = CCVector3d(batch.vectors[1][0][i], batch.vectors[1][1][i], batch.vectors[1][2][i]);
+                pca.e3 = CCVector3d(batch.vectors[2][0][i], batch.vectors[2][1][i], batch.vectors[2][2][i]);
+                *lanes[i]->ok = true;
+            }
+            count = 0;
+        };
+
+        for (const PCARequest& request : requests)
+        {
+            const NeighbourhoodMoments& m = request.moments;
+            *request.ok = false;
+            if (m.count < 3)
+                continue;
+
+            const double n = static_cast<double>(m.count);
+            NeighbourhoodPCA& pca = *request.pca;
+            pca.G = CCVector3d(m.sx / n, m.sy / n, m.sz / n);
+            batch.a00[count] = m.sxx / n - pca.G.x * pca.G.x;
+            batch.a11[count] = m.syy / n - pca.G.y * pca.G.y;
+            batch.a22[count] = m.szz / n - pca.G.z * pca.G.z;
+            batch.a01[count] = m.sxy / n - pca.G.x * pca.G.y;
+            batch.a02[count] = m.sxz / n - pca.G.x * pca.G.z;
+            batch.a12[count] = m.syz / n - pca.G.y * pca.G.z;
+            lanes[count++] = &request;
+            if (count == SymEigen3x3::BatchSize)
+                solve();
+        }
+        if (count != 0)
+            solve();
+    }
+
+    inline CCVector3 ToPC(const CCVector3d& v)
+    {
+        return CCVector3(static_cast<PointCoordinateType>(v.x), static_cast<PointCoordinateType>(v.y), static_cast<PointCoordinateType>(v.z));
+    }
+
+    //! same definitions as CCCoreLib::Neighbourhood::computeFeature
+    double GeomFeatureFromPCA(CCCoreLib::Neighbourhood::GeomFeature feature, const NeighbourhoodPCA& pca)
+    {
+        const double l1 = pca.l1;
+        const double l2 = pca.l2;
+        const double l3 = pca.l3;
+        const double sum = l1 + l2 + l3;
+        const double eps = std::numeric_limits<double>::epsilon();
+        double value = std::numeric_limits<double>::quiet_NaN();
+
+        switch (feature)
+        {
+        case CCCoreLib::Neighbourhood::EigenValuesSum:
+            value = sum;
+            break;
+        case CCCoreLib::Neighbourhood::Omnivariance:
+            value = std::pow(l1 * l2 * l3, 1.0 / 3.0);
+            break;
+        case CCCoreLib::Neighbourhood::EigenEntropy:
+            value = -(l1 * std::log(l1) + l2 * std::log(l2) + l3 * std::log(l3));
+            break;
+        case CCCoreLib::Neighbourhood::Anisotropy:
+            if (std::abs(l1) > eps)
+                value = (l1 - l3) / l1;
+            break;
+        case CCCoreLib::Neighbourhood::Planarity:
+            if (std::abs(l1) > eps)
+                value = (l2 - l3) / l1;
+            break;
+        case CCCoreLib::Neighbourhood::Linearity:
+            if (std::abs(l1) > eps)
+                value = (l1 - l2) / l1;
+            break;
+        case CCCoreLib::Neighbourhood::PCA1:
+            if (std::abs(sum) > eps)
+                value = l1 / sum;
+            break;
+        case CCCoreLib::Neighbourhood::PCA2:
+            if (std::abs(sum) > eps)
+                value = l2 / sum;
+            break;
+        case CCCoreLib::Neighbourhood::SurfaceVariation:
+            if (std::abs(sum) > eps)
+                value = l3 / sum;
+            break;
+        case CCCoreLib::Neighbourhood::Sphericity:
+            if (std::abs(l1) > eps)
+                value = l3 / l1;
+            break;
+        case CCCoreLib::Neighbourhood::Verticality:
+            value = 1.0 - std::abs(pca.e3.z);
+            break;
+        case CCCoreLib::Neighbourhood::EigenValue1:
+            value = l1;
+            break;
+        case CCCoreLib::Neighbourhood::EigenValue2:
+            value = l2;
+            break;
+        case CCCoreLib::Neighbourhood::EigenValue3:
+            value = l3;
+            break;
+        default:
+            assert(false);
+            break;
+        }
+        return value;
+    }
+
+    //! requested characteristics and their output scalar fields, for one neighbourhood radius
+    struct FeaturesScaleOutputs
+    {
+        PointCoordinateType radius = 0;
+        std::vector<std::pair<CCCoreLib::Neighbourhood::GeomFeature, CCCoreLib::ScalarField*>> features;
+        std::vector<std::pair<CurvatureType, CCCoreLib::ScalarField*>> curvatures;
+        std::vector<std::pair<CCCoreLib::GeometricalAnalysisTools::Density, CCCoreLib::ScalarField*>> densities;
+        CCCoreLib::ScalarField* roughnessSF = nullptr;
+    };
+
+    //! parameters of a features pass (one or several nested neighbourhoods)
+    struct FeaturesPassParameters
+    {
+        std::vector<FeaturesScaleOutputs> scales; //!< sorted by increasing radius
+        const CCVector3* roughnessUpDir = nullptr;
+        const std::vector<uint8_t>* coreMask = nullptr; //!< when defined, only the flagged points are evaluated
+        unsigned knn = 0; //!< when > 0, k nearest neighbours (capped by the radius if > 0) instead of a sphere (single scale)
+    };
+
+    //! neighbourhood of a point at one scale, waiting for the decomposition of its covariance matrix
+    struct PendingNeighbourhood
+    {
+        const FeaturesScaleOutputs* outputs = nullptr;
+        CCVector3 queryPoint;
+        bool queryInNeighbourhood = false;  //!< the roughness ignores the query point
+        unsigned neighborCount = 0;
+        double neighbourhoodRadius = 0;     //!< for the densities
+        unsigned outIndex = 0;              //!< index in the output scalar fields
+        NeighbourhoodMoments moments;       //!< may have been accumulated incrementally (nested neighbourhoods)
+        NeighbourhoodPCA pca;
+        NeighbourhoodPCA plane;             //!< without the query point (roughness)
+        bool pcaOk = false;
+        bool planeOk = false;
+    };
+
+    //! evaluates the neighbourhoods of a features pass, by batches of points
+    /*! the covariance matrices of several points are decomposed together (see SymEigen3x3).
+     *  The quadric curvatures need the neighbours themselves: the points are then evaluated one by one.
+     *  One instance per thread, flush() must be called after the last point.
+     */
+    class FeaturesEvaluator
+    {
+    public:
+        explicit FeaturesEvaluator(const FeaturesPassParameters& params)
+            : m_params(params)
+        {
+            for (const auto& scale : params.scales)
+                for (const auto& curvature : scale.curvatures)
+                    m_pointByPoint |= (curvature.first != NORMAL_CHANGE_RATE);
+            m_pending.reserve(SymEigen3x3::BatchSize + params.scales.size());
+            m_requests.reserve(2 * m_pending.capacity());
+        }
+
+        //! adds all the scales of a point, from its neighbourhood for the largest radius
+        /*! the nested neighbourhoods are the prefixes of the neighbours sorted by distance:
+         *  the moments are accumulated incrementally from the smallest to the largest radius.
+         */
+        void addPoint(const CCVector3& queryPoint,
+                      bool queryInNeighbourhood,
+                      CCCoreLib::DgmOctree::NeighboursSet& neighbours,
+                      unsigned neighborCount,
+                      unsigned outIndex)
+        {
+            if (m_params.scales.size() > 1)
+            {
+                std::sort(neighbours.begin(), neighbours.begin() + neighborCount,
+                          [](const CCCoreLib::DgmOctree::PointDescriptor& a, const CCCoreLib::DgmOctree::PointDescriptor& b)
+                          { return a.squareDistd < b.squareDistd; });
+            }
+
+            NeighbourhoodMoments moments;
+            unsigned count = 0;
+            for (size_t s = 0; s < m_params.scales.size(); ++s)
+            {
+                const FeaturesScaleOutputs& scale = m_params.scales[s];
+                const bool largest = (s + 1 == m_params.scales.size());
+                const double squareRadius = static_cast<double>(scale.radius) * scale.radius;
+                while (count < neighborCount && (largest || neighbours[count].squareDistd <= squareRadius))
+                {
+                    const CCVector3 d = *neighbours[count].point - queryPoint;
+                    moments.add(d.x, d.y, d.z);
+                    ++count;
+                }
+
+                PendingNeighbourhood pending;
+                pending.outputs = &scale;
+                pending.queryPoint = queryPoint;
+                pending.queryInNeighbourhood = queryInNeighbourhood;
+                pending.neighborCount = count;
+                //with k nearest neighbours, the radius of the neighbourhood is the distance to the farthest one (sorted neighbours)
+                pending.neighbourhoodRadius = scale.radius;
+                if (m_params.knn != 0)
+                    pending.neighbourhoodRadius = (count != 0 ? std::sqrt(neighbours[count - 1].squareDistd) : 0.0);
+                pending.outIndex = outIndex;
+                pending.moments = moments;
+                m_pending.push_back(pending);
+            }
+
+            if (m_pointByPoint)
+                flush(&neighbours);
+            else if (m_pending.size() >= SymEigen3x3::BatchSize)
+                flush();
+        }
+
+        //! evaluates the pending neighbourhoods (the neighbours are only required for the quadric curvatures)
+        void flush(CCCoreLib::DgmOctree::NeighboursSet* neighbours = nullptr)
+        {
+            m_requests.clear();
+            for (PendingNeighbourhood& pending : m_pending)
+            {
+                const FeaturesScaleOutputs& outputs = *pending.outputs;
+                pending.pcaOk = pending.planeOk = false;
+                PCARequest request;
+                if (!outputs.features.empty() || !outputs.curvatures.empty())
+                {
+                    request.moments = pending.moments;
+                    request.pca = &pending.pca;
+                    request.ok = &pending.pcaOk;
+                    m_requests.push_back(request);
+                }
+                //the query point is excluded from the plane fitting: as coordinates are relative to it, only the count changes
+                if (outputs.roughnessSF && (pending.neighborCount > 3 || (!pending.queryInNeighbourhood && pending.neighborCount == 3)))
+                {
+                    request.moments = pending.moments;
+                    if (pending.queryInNeighbourhood)
+                        --request.moments.count;
+                    request.pca = &pending.plane;
+                    request.ok = &pending.planeOk;
+                    m_requests.push_back(request);
+                }
+            }
+            ComputeNeighbourhoodPCAs(m_requests);
+
+            for (const PendingNeighbourhood& pending : m_pending)
+                evaluate(pending, neighbours);
+            m_pending.clear();
+        }
+
+    private:
+        //! computes all the requested characteristics of a point at one scale, once its covariance matrix is decomposed
+        void evaluate(const PendingNeighbourhood& p, CCCoreLib::DgmOctree::NeighboursSet* neighbours) const
+        {
+            const FeaturesScaleOutputs& outputs = *p.outputs;
+            const NeighbourhoodPCA& pca = p.pca;
+
+            for (const auto& feature : outputs.features)
+            {
+                ScalarType value = p.pcaOk ? static_cast<ScalarType>(GeomFeatureFromPCA(feature.first, pca)) : CCCoreLib::NAN_VALUE;
+                feature.second->setValue(p.outIndex, value);
+            }
+
+            for (const auto& density : outputs.densities)
+            {
+                const double r = p.neighbourhoodRadius;
+                double value = static_cast<double>(p.neighborCount);
+                switch (density.first)
+                {
+                case CCCoreLib::GeometricalAnalysisTools::DENSITY_2D:
+                    value = (r > 0 ? value / (M_PI * r * r) : std::numeric_limits<double>::quiet_NaN());
+                    break;
+                case CCCoreLib::GeometricalAnalysisTools::DENSITY_3D:
+                    value = (r > 0 ? value / ((4.0 / 3.0) * M_PI * r * r * r) : std::numeric_limits<double>::quiet_NaN());
+                    break;
+                default:
+                    break;
+                }
+                density.second->setValue(p.outIndex, static_cast<ScalarType>(value));
+            }
+
+            if (!outputs.curvatures.empty())
+            {
+                //a quadric needs at least 6 points
+                const bool enoughPoints = p.pcaOk && p.neighborCount >= 6;
+                for (const auto& curvature : outputs.curvatures)
+                {
+                    if (curvature.first != NORMAL_CHANGE_RATE)
+                        continue;
+                    ScalarType value = CCCoreLib::NAN_VALUE;
+                    const double sum = pca.l1 + pca.l2 + pca.l3;
+                    if (enoughPoints && sum > std::numeric_limits<double>::epsilon())
+                        value = static_cast<ScalarType>(pca.l3 / sum);
+                    curvature.second->setValue(p.outIndex, value);
+                }
+
+                if (m_pointByPoint && neighbours)
+                {
+                    CCCoreLib::DgmOctreeReferenceCloud neighboursCloud(neighbours, p.neighborCount);
+                    CCCoreLib::Neighbourhood Z(&neighboursCloud);
+                    if (enoughPoints)
+                    {
+                        //the local frame of the quadric is given by the principal components already computed
+                        CCVector3 G = p.queryPoint + ToPC(pca.G);
+                        CCVector3 X = ToPC(pca.e1);
+                        CCVector3 N = ToPC(pca.e3);
+                        CCVector3 Y = N.cross(X);
+                        PointCoordinateType eq[4] = { N.x, N.y, N.z, G.dot(N) };
+                        Z.setGravityCenter(G);
+                        Z.setLSPlane(eq, X, Y, N);
+                    }
+                    for (const auto& curvature : outputs.curvatures)
+                    {
+                        if (curvature.first == NORMAL_CHANGE_RATE)
+                            continue;
+                        ScalarType value = CCCoreLib::NAN_VALUE;
+                        if (enoughPoints)
+                            value = Z.computeCurvature(p.queryPoint, static_cast<CCCoreLib::Neighbourhood::CurvatureType>(curvature.first));
+                        curvature.second->setValue(p.outIndex, value);
+                    }
+                }
+            }
+
+            if (outputs.roughnessSF)
+            {
+                ScalarType value = CCCoreLib::NAN_VALUE;
+                if (p.planeOk)
+                {
+                    //signed distance from the query point (origin) to the plane
+                    double d = -p.plane.e3.dot(p.plane.G);
+                    if (m_params.roughnessUpDir)
+                    {
+                        const CCVector3d up(m_params.roughnessUpDir->x, m_params.roughnessUpDir->y, m_params.roughnessUpDir->z);
+                        if (p.plane.e3.dot(up) < 0)
+                            d = -d;
+                    }
+                    else
+                    {
+                        d = std::abs(d);
+                    }
+                    value = static_cast<ScalarType>(d);
+                }
+                outputs.roughnessSF->setValue(p.outIndex, value);
+            }
+        }
+
+        const FeaturesPassParameters& m_params;
+        bool m_pointByPoint = false;                //!< quadric curvatures requested
+        std::vector<PendingNeighbourhood> m_pending;
+        std::vector<PCARequest> m_requests;
+    };
+
+    //! prepares the search structure for the neighbourhoods of a features pass (the cell is set by the caller)
+    void PrepareNeighbourhoodSearch(const CCCoreLib::DgmOctree* octree,
+                                    unsigned char level,
+                                    const FeaturesPassParameters& params,
+                                    CCCoreLib::DgmOctree::NearestNeighboursSearchStruct& nNSS)
+    {
+        const PointCoordinateType maxRadius = params.scales.back().radius;
+        nNSS.level = level;
+        if (params.knn != 0)
+        {
+            nNSS.minNumberOfNeighbors = params.knn;
+            if (maxRadius > 0)
+                nNSS.maxSearchSquareDistd = static_cast<double>(maxRadius) * maxRadius;
+        }
+        else
+        {
+            nNSS.prepare(maxRadius, octree->getCellSize(level));
+        }
+    }
+
+    //! extracts the neighbourhood of nNSS.queryPoint: sphere of the largest radius, or k nearest neighbours
+    /*! \return the number of neighbours, at the beginning of nNSS.pointsInNeighbourhood (sorted by distance for k nearest neighbours)
+     */
+    unsigned ExtractNeighbourhood(const CCCoreLib::DgmOctree* octree,
+                                  const FeaturesPassParameters& params,
+                                  CCCoreLib::DgmOctree::NearestNeighboursSearchStruct& nNSS)
+    {
+        const PointCoordinateType maxRadius = params.scales.back().radius;
+        if (params.knn == 0)
+            return octree->findNeighborsInASphereStartingFromCell(nNSS, maxRadius, false);
+
+        //warning: there may be more points at the end of nNSS.pointsInNeighbourhood than the actual nearest neighbors
+        unsigned neighborCount = std::min(octree->findNearestNeighborsStartingFromCell(nNSS), params.knn);
+        if (maxRadius > 0)
+        {
+            //hybrid mode: no neighbour beyond the radius
+            const double squareRadius = static_cast<double>(maxRadius) * maxRadius;
+            while (neighborCount != 0 && nNSS.pointsInNeighbourhood[neighborCount - 1].squareDistd > squareRadius)
+                --neighborCount;
+        }
+        return neighborCount;
+    }
+
+    //! computes all the requested characteristics for the points of an octree cell
+    /*! additionalParameters: [0] FeaturesPassParameters*
+     */
+    bool ComputeFeaturesInCell(const CCCoreLib::DgmOctree::octreeCell& cell,
+                               void** additionalParameters,
+                               CCCoreLib::NormalizedProgress* nProgress)
+    {
+        const FeaturesPassParameters& params = *static_cast<const FeaturesPassParameters*>(additionalParameters[0]);
+
+        CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+        PrepareNeighbourhoodSearch(cell.parentOctree, cell.level, params, nNSS);
+        cell.parentOctree->getCellPos(cell.truncatedCode, cell.level, nNSS.cellPos, true);
+        cell.parentOctree->computeCellCenter(nNSS.cellPos, cell.level, nNSS.cellCenter);
+
+        FeaturesEvaluator evaluator(params);
+        unsigned n = cell.points->size();
+        for (unsigned i = 0; i < n; ++i)
+        {
+            unsigned globalIndex = cell.points->getPointGlobalIndex(i);
+            if (!params.coreMask || (*params.coreMask)[globalIndex])
+            {
+                cell.points->getPoint(i, nNSS.queryPoint);
+                //one extraction (largest radius) for all the characteristics and all the scales
+                unsigned neighborCount = ExtractNeighbourhood(cell.parentOctree, params, nNSS);
+                evaluator.addPoint(nNSS.queryPoint, true, nNSS.pointsInNeighbourhood, neighborCount, globalIndex);
+            }
+
+            if (nProgress && !nProgress->oneStep())
+                return false;
+        }
+        evaluator.flush();
+        return true;
+    }
+
+    //! gets (or creates) a scalar field by name, returns nullptr if not enough memory
+    CCCoreLib::ScalarField* GetOrAddScalarField(ccPointCloud* pc, const QString& sfName, std::vector<int>& sfIndexes)
+    {
+        int sfIdx = pc->getScalarFieldIndexByName(qPrintable(sfName));
+        if (sfIdx < 0)
+            sfIdx = pc->addScalarField(qPrintable(sfName));
+        if (sfIdx < 0)
+        {
+            CCTRACE("Failed to create scalar field on cloud (not enough memory?): " << pc->getName().toStdString());
+            return nullptr;
+        }
+        sfIndexes.push_back(sfIdx);
+        return pc->getScalarField(sfIdx);
+    }
+
+    //! creates (or reuses) the output scalar fields of the requested characteristics, for all the given radii
+    /*! params.knn must be set before (it is a part of the scalar field names)
+     */
+    bool PrepareFeaturesOutputs(ccPointCloud* pc,
+                                const std::vector<CCCoreLib::Neighbourhood::GeomFeature>& features,
+                                const std::vector<double>& radii,
+                                const std::vector<CurvatureType>& curvatures,
+                                const std::vector<CCCoreLib::GeometricalAnalysisTools::Density>& densities,
+                                bool roughness,
+                                FeaturesPassParameters& params,
+                                std::vector<int>& sfIndexes)
+    {
+        bool sfOk = true;
+        for (double radius : radii)
+        {
+            FeaturesScaleOutputs scale;
+            scale.radius = static_cast<PointCoordinateType>(radius);
+            for (auto feature : features)
+            {
+                CCCoreLib::ScalarField* sf = GetOrAddScalarField(pc, pyCC_GetGeomCharacteristicSFName(CCCoreLib::GeometricalAnalysisTools::Feature, feature, scale.radius, params.knn), sfIndexes);
+                sfOk &= (sf != nullptr);
+                scale.features.emplace_back(feature, sf);
+            }
+            for (auto curvature : curvatures)
+            {
+                CCCoreLib::ScalarField* sf = GetOrAddScalarField(pc, pyCC_GetGeomCharacteristicSFName(CCCoreLib::GeometricalAnalysisTools::Curvature, curvature, scale.radius, params.knn), sfIndexes);
+                sfOk &= (sf != nullptr);
+                scale.curvatures.emplace_back(curvature, sf);
+            }
+            for (auto density : densities)
+            {
+                CCCoreLib::ScalarField* sf = GetOrAddScalarField(pc, pyCC_GetDensitySFName(density, false, scale.radius, params.knn), sfIndexes);
+                sfOk &= (sf != nullptr);
+                scale.densities.emplace_back(density, sf);
+            }
+            if (roughness)
+            {
+                scale.roughnessSF = GetOrAddScalarField(pc, pyCC_GetGeomCharacteristicSFName(CCCoreLib::GeometricalAnalysisTools::Roughness, 0, scale.radius, params.knn), sfIndexes);
+                sfOk &= (scale.roughnessSF != nullptr);
+            }
+            params.scales.push_back(scale);
+        }
+        return sfOk;
+    }
+
+    //! removes the (incomplete) output scalar fields, last created first
+    void DeleteFeaturesOutputs(ccPointCloud* pc, std::vector<int> sfIndexes)
+    {
+        std::sort(sfIndexes.begin(), sfIndexes.end());
+        sfIndexes.erase(std::unique(sfIndexes.begin(), sfIndexes.end()), sfIndexes.end());
+        for (auto it = sfIndexes.rbegin(); it != sfIndexes.rend(); ++it)
+            pc->deleteScalarField(*it);
+    }
+
+    //! updates the output scalar fields once computed
+    void FinalizeFeaturesOutputs(ccPointCloud* pc, const std::vector<int>& sfIndexes, bool signedRoughness)
+    {
+        QString roughnessPrefix(CC_ROUGHNESS_FIELD_NAME);
+        for (int sfIdx : sfIndexes)
+        {
+            CCCoreLib::ScalarField* sf = pc->getScalarField(sfIdx);
+            sf->computeMinAndMax();
+            if (signedRoughness && QString(sf->getName()).startsWith(roughnessPrefix))
+            {
+                // signed roughness should be displayed with a symmetrical color scale
+                ccScalarField* ccSF = dynamic_cast<ccScalarField*>(sf);
+                if (ccSF)
+                    ccSF->setSymmetricalScale(true);
+            }
+        }
+        if (!sfIndexes.empty())
+        {
+            pc->setCurrentDisplayedScalarField(sfIndexes.back());
+            pc->showSF(true);
+        }
+        pc->prepareDisplayForRefresh();
+    }
+
+    //! gets the octree of a cloud, computes it if needed
+    ccOctree::Shared GetOrComputeOctree(ccGenericPointCloud* cloud)
+    {
+        ccOctree::Shared octree = cloud->getOctree();
+        if (!octree)
+        {
+            octree = cloud->computeOctree(nullptr);
+            if (!octree)
+                CCTRACE("Couldn't compute octree for cloud " << cloud->getName().toStdString());
+        }
+        return octree;
+    }
+
+    //! flags the points appended from firstNewPoint, and the former points within radius of them
+    /*! the octree is rebuilt if it does not hold all the points (built before the append).
+     *  \return the flags, empty if the octree could not be computed
+     */
+    std::vector<uint8_t> MarkNeighbourhoodOfNewPoints(ccGenericPointCloud* cloud, unsigned firstNewPoint, PointCoordinateType radius)
+    {
+        const unsigned count = cloud->size();
+        ccOctree::Shared octree = cloud->getOctree();
+        if (octree && octree->getNumberOfProjectedPoints() != count)
+        {
+            CCTRACE("octree built before the points were appended, recomputed");
+            cloud->deleteOctree();
+        }
+        octree = GetOrComputeOctree(cloud);
+        if (!octree)
+            return std::vector<uint8_t>();
+        const unsigned char level = octree->findBestLevelForAGivenNeighbourhoodSizeExtraction(radius);
+
+        std::unique_ptr<std::atomic<uint8_t>[]> flags(new std::atomic<uint8_t>[count]());
+        const unsigned chunkSize = 1 << 12;
+        std::vector<unsigned> chunks;
+        for (unsigned start = firstNewPoint; start < count; start += chunkSize)
+            chunks.push_back(start);
+        QtConcurrent::blockingMap(chunks, [&](unsigned start)
+        {
+            CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+            nNSS.level = level;
+            const unsigned end = std::min(count, start + chunkSize);
+            for (unsigned i = start; i < end; ++i)
+            {
+                flags[i].store(1, std::memory_order_relaxed);
+                cloud->getPoint(i, nNSS.queryPoint);
+                nNSS.prepare(radius, octree->getCellSize(level));
+                nNSS.pointsInNeighbourhood.clear();
+                bool inBounds = false;
+                octree->getTheCellPosWhichIncludesThePoint(&nNSS.queryPoint, nNSS.cellPos, level, inBounds);
+                nNSS.alreadyVisitedNeighbourhoodSize = inBounds ? 0 : 1;
+                octree->computeCellCenter(nNSS.cellPos, level, nNSS.cellCenter);
+                unsigned neighborCount = octree->findNeighborsInASphereStartingFromCell(nNSS, radius, false);
+                for (unsigned j = 0; j < neighborCount; ++j)
+                    flags[nNSS.pointsInNeighbourhood[j].pointIndex].store(1, std::memory_order_relaxed);
+            }
+        });
+
+        std::vector<uint8_t> mask(count);
+        for (unsigned i = 0; i < count; ++i)
+            mask[i] = flags[i].load(std::memory_order_relaxed);
+        return mask;
+    }
+
+    //! best octree level for the neighbourhoods of a features pass
+    unsigned char FeaturesPassLevel(const CCCoreLib::DgmOctree* octree, const FeaturesPassParameters& params)
+    {
+        if (params.knn != 0)
+            return octree->findBestLevelForAGivenPopulationPerCell(params.knn);
+        return octree->findBestLevelForAGivenNeighbourhoodSizeExtraction(params.scales.back().radius);
+    }
+
+    //! runs the features pass on all the points of a cloud (or on the points flagged in params.coreMask)
+    bool RunFeaturesPassOnCloud(ccGenericPointCloud* cloud, FeaturesPassParameters& params)
+    {
+        ccOctree::Shared octree = GetOrComputeOctree(cloud);
+        if (!octree)
+            return false;
+        unsigned char level = FeaturesPassLevel(octree.data(), params);
+        void* additionalParameters[] = { static_cast<void*>(&params) };
+        return (octree->executeFunctionForAllCellsAtLevel(level,
+                                                          &ComputeFeaturesInCell,
+                                                          additionalParameters,
+                                                          true,
+                                                          nullptr,
+                                                          "Geometric features computation") != 0);
+    }
+
+    //! runs the features pass on the points of a query cloud, the neighbours being searched in another cloud
+    /*! the results of the ith query point are written at index i of the output scalar fields.
+     */
+    bool RunFeaturesPassAtQueryPoints(ccGenericPointCloud* cloud, CCCoreLib::GenericIndexedCloud* queries, const FeaturesPassParameters& params)
+    {
+        ccOctree::Shared octree = GetOrComputeOctree(cloud);
+        if (!octree)
+            return false;
+        const unsigned char level = FeaturesPassLevel(octree.data(), params);
+
+        const unsigned count = queries->size();
+        const unsigned chunkSize = 1 << 12;
+        std::vector<unsigned> chunks((count + chunkSize - 1) / chunkSize);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        auto chunkFunc = [&](const unsigned& c)
+        {
+            CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+            FeaturesEvaluator evaluator(params);
+            unsigned end = std::min(count, (c + 1) * chunkSize);
+            for (unsigned i = c * chunkSize; i < end; ++i)
+            {
+                //the query point is not necessarily in the cloud: new search structure for each point
+                queries->getPoint(i, nNSS.queryPoint);
+                PrepareNeighbourhoodSearch(octree.data(), level, params, nNSS);
+                nNSS.pointsInNeighbourhood.clear();
+                bool inBounds = false;
+                octree->getTheCellPosWhichIncludesThePoint(&nNSS.queryPoint, nNSS.cellPos, level, inBounds);
+                nNSS.alreadyVisitedNeighbourhoodSize = inBounds ? 0 : 1;
+                octree->computeCellCenter(nNSS.cellPos, level, nNSS.cellCenter);
+
+                unsigned neighborCount = ExtractNeighbourhood(octree.data(), params, nNSS);
+                bool queryInNeighbourhood = false;
+                for (unsigned j = 0; j < neighborCount && !queryInNeighbourhood; ++j)
+                    queryInNeighbourhood = (nNSS.pointsInNeighbourhood[j].squareDistd == 0);
+                evaluator.addPoint(nNSS.queryPoint, queryInNeighbourhood, nNSS.pointsInNeighbourhood, neighborCount, i);
+            }
+            evaluator.flush();
+        };
+        QtConcurrent::blockingMap(chunks, chunkFunc);
+        return true;
+    }
+
+    //! copies to each target point (not flagged in skip) the values of the nearest source point
+    /*! \param sources source points (an octree is built on them)
+     *  \param sourceToValue index of the source values in the source scalar fields (nullptr: same index)
+     *  \param sfPairs (source, target) scalar fields
+     *  \param target target cloud
+     *  \param skip optional, target points to leave unchanged
+     */
+    bool PropagateFromNearestPoint(CCCoreLib::GenericIndexedCloudPersist* sources,
+                                   const std::vector<unsigned>* sourceToValue,
+                                   const std::vector<std::pair<CCCoreLib::ScalarField*, CCCoreLib::ScalarField*>>& sfPairs,
+                                   ccGenericPointCloud* target,
+                                   const std::vector<uint8_t>* skip)
+    {
+        CCCoreLib::DgmOctree sourceOctree(sources);
+        if (sourceOctree.build() <= 0)
+        {
+            CCTRACE("failed to build the octree of the core points");
+            return false;
+        }
+        const unsigned char level = sourceOctree.findBestLevelForAGivenPopulationPerCell(3);
+
+        const unsigned count = target->size();
+        const unsigned chunkSize = 1 << 12;
+        std::vector<unsigned> chunks((count + chunkSize - 1) / chunkSize);
+        std::iota(chunks.begin(), chunks.end(), 0);
+
+        auto chunkFunc = [&](const unsigned& c)
+        {
+            CCCoreLib::ReferenceCloud Yk(sources);
+            unsigned end = std::min(count, (c + 1) * chunkSize);
+            for (unsigned i = c * chunkSize; i < end; ++i)
+            {
+                if (skip && (*skip)[i])
+                    continue;
+                Yk.clear();
+                double maxSquareDist = 0;
+                if (sourceOctree.findPointNeighbourhood(target->getPoint(i), &Yk, 1, level, maxSquareDist) > 0)
+                {
+                    unsigned j = Yk.getPointGlobalIndex(0);
+                    if (sourceToValue)
+                        j = (*sourceToValue)[j];
+                    for (const auto& sfPair : sfPairs)
+                        sfPair.second->setValue(i, sfPair.first->getValue(j));
+                }
+                else
+                {
+                    for (const auto& sfPair : sfPairs)
+                        sfPair.second->setValue(i, CCCoreLib::NAN_VALUE);
+                }
+            }
+        };
+        QtConcurrent::blockingMap(chunks, chunkFunc);
+        return true;
+    }
+
+    //! computes the requested characteristics at all the given radii on a cloud, in a single neighbourhood pass
+    bool ComputeFeaturesOnCloud(ccPointCloud* pc,
+                                const std::vector<CCCoreLib::Neighbourhood::GeomFeature>& features,
+                                const std::vector<double>& radii,
+                                const std::vector<CurvatureType>& curvatures,
+                                const std::vector<CCCoreLib::GeometricalAnalysisTools::Density>& densities,
+                                bool roughness,
+                                const CCVector3* roughnessUpDir,
+                                unsigned knn)
+    {
+        FeaturesPassParameters params;
+        params.roughnessUpDir = roughnessUpDir;
+        params.knn = knn;
+
+        std::vector<int> sfIndexes;
+        bool ok = PrepareFeaturesOutputs(pc, features, radii, curvatures, densities, roughness, params, sfIndexes)
+               && RunFeaturesPassOnCloud(pc, params);
+        if (!ok)
+        {
+            CCTRACE("Failed to apply processing to cloud " << pc->getName().toStdString());
+            DeleteFeaturesOutputs(pc, sfIndexes);
+            return false;
+        }
+        FinalizeFeaturesOutputs(pc, sfIndexes, roughnessUpDir != nullptr);
+        return true;
+    }
+
+    //! checks and normalizes the parameters common to the features computations
+    /*! with k nearest neighbours, a single radius is expected (0: no limit)
+     */
+    bool CheckFeaturesParameters(const std::vector<CCCoreLib::Neighbourhood::GeomFeature>& features,
+                                 std::vector<double>& radii,
+                                 const std::vector<CurvatureType>& curvatures,
+                                 const std::vector<CCCoreLib::GeometricalAnalysisTools::Density>& densities,
+                                 bool roughness,
+                                 unsigned knn = 0)
+    {
+        if (knn != 0)
+        {
+            if (radii.size() != 1 || radii.front() < 0)
+            {
+                CCTRACE("invalid radius for k nearest neighbours");
+                return false;
+            }
+        }
+        else if (radii.empty() || *std::min_element(radii.begin(), radii.end()) <= 0)
+        {
+            CCTRACE("invalid radius");
+            return false;
+        }
+        if (features.empty() && curvatures.empty() && densities.empty() && !roughness)
+        {
+            CCTRACE("nothing to compute");
+            return false;
+        }
+        std::sort(radii.begin(), radii.end());
+        radii.erase(std::unique(radii.begin(), radii.end()), radii.end());
+        return true;
+    }
+
+    //! computes the requested characteristics on a list of clouds (the point clouds only)
+    bool ComputeFeaturesOnClouds(const std::vector<ccHObject*>& clouds,
+                                 const std::vector<CCCoreLib::Neighbourhood::GeomFeature>& features,
+                                 std::vector<double> radii,
+                                 const std::vector<CurvatureType>& curvatures,
+                                 const std::vector<CCCoreLib::GeometricalAnalysisTools::Density>& densities,
+                                 bool roughness,
+                                 const CCVector3& roughnessUpDir,
+                                 unsigned knn)
+    {
+        if (!CheckFeaturesParameters(features, radii, curvatures, densities, roughness, knn))
+            return false;
+        const CCVector3* upDir = (roughnessUpDir.norm2() != 0) ? &roughnessUpDir : nullptr;
+
+        for (ccHObject* entity : clouds)
+        {
+            if (!entity->isA(CC_TYPES::POINT_CLOUD))
+            {
+                CCTRACE("entity is not a point cloud, skipped: " << entity->getName().toStdString());
+                continue;
+            }
+            if (!ComputeFeaturesOnCloud(static_cast<ccPointCloud*>(entity), features, radii, curvatures, densities, roughness, upDir, knn))
+                return false;
+        }
+        return true;
+    }
+}
+
+bool computeFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                     double radius,
+                     std::vector<ccHObject*> clouds,
+                     std::vector<CurvatureType> curvatures,
+                     std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                     bool roughness,
+                     CCVector3 roughnessUpDir,
+                     unsigned knn)
+{
+    CCTRACE("computeFeatures features: " << features.size() << " curvatures: " << curvatures.size()
+            << " densities: " << densities.size() << " roughness: " << roughness << " radius: " << radius << " knn: " << knn << " nbClouds: " << clouds.size());
+    return ComputeFeaturesOnClouds(clouds, features, std::vector<double>{ radius }, curvatures, densities, roughness, roughnessUpDir, knn);
+}
+
+bool computeMultiScaleFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                               std::vector<double> radii,
+                               std::vector<ccHObject*> clouds,
+                               std::vector<CurvatureType> curvatures,
+                               std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                               bool roughness,
+                               CCVector3 roughnessUpDir)
+{
+    CCTRACE("computeMultiScaleFeatures features: " << features.size() << " curvatures: " << curvatures.size()
+            << " densities: " << densities.size() << " roughness: " << roughness << " scales: " << radii.size() << " nbClouds: " << clouds.size());
+    return ComputeFeaturesOnClouds(clouds, features, radii, curvatures, densities, roughness, roughnessUpDir, 0);
+}
+
+bool computeCoreFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                         std::vector<double> radii,
+                         ccPointCloud* cloud,
+                         std::vector<unsigned> coreIndexes,
+                         std::vector<CurvatureType> curvatures,
+                         std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                         bool roughness,
+                         CCVector3 roughnessUpDir,
+                         bool propagate)
+{
+    CCTRACE("computeCoreFeatures core points: " << coreIndexes.size() << " propagate: " << propagate);
+    if (!cloud)
+        throw std::invalid_argument("null cloud");
+    if (!CheckFeaturesParameters(features, radii, curvatures, densities, roughness))
+        return false;
+    const CCVector3* upDir = (roughnessUpDir.norm2() != 0) ? &roughnessUpDir : nullptr;
+
+    const unsigned count = cloud->size();
+    std::vector<uint8_t> coreMask(count, 0);
+    CCCoreLib::ReferenceCloud corePoints(cloud);
+    if (!corePoints.reserve(static_cast<unsigned>(coreIndexes.size())))
+    {
+        CCTRACE("not enough memory");
+        return false;
+    }
+    for (unsigned idx : coreIndexes)
+    {
+        if (idx >= count)
+            throw std::invalid_argument("core point index out of range");
+        if (!coreMask[idx])
+        {
+            coreMask[idx] = 1;
+            corePoints.addPointIndex(idx);
+        }
+    }
+    if (corePoints.size() == 0)
+    {
+        CCTRACE("no core points");
+        return false;
+    }
+
+    FeaturesPassParameters params;
+    params.roughnessUpDir = upDir;
+    params.coreMask = &coreMask;
+
+    std::vector<int> sfIndexes;
+    bool ok = PrepareFeaturesOutputs(cloud, features, radii, curvatures, densities, roughness, params, sfIndexes);
+    if (ok)
+    {
+        //the points which are not core points have no value
+        for (int sfIdx : sfIndexes)
+            cloud->getScalarField(sfIdx)->fill(CCCoreLib::NAN_VALUE);
+        ok = RunFeaturesPassOnCloud(cloud, params);
+    }
+    if (ok && propagate)
+    {
+        std::vector<std::pair<CCCoreLib::ScalarField*, CCCoreLib::ScalarField*>> sfPairs;
+        for (int sfIdx : sfIndexes)
+            sfPairs.emplace_back(cloud->getScalarField(sfIdx), cloud->getScalarField(sfIdx));
+        std::vector<unsigned> coreToCloud(corePoints.size());
+        for (unsigned i = 0; i < corePoints.size(); ++i)
+            coreToCloud[i] = corePoints.getPointGlobalIndex(i);
+        ok = PropagateFromNearestPoint(&corePoints, &coreToCloud, sfPairs, cloud, &coreMask);
+    }
+    if (!ok)
+    {
+        CCTRACE("Failed to apply processing to cloud " << cloud->getName().toStdString());
+        DeleteFeaturesOutputs(cloud, sfIndexes);
+        return false;
+    }
+    FinalizeFeaturesOutputs(cloud, sfIndexes, upDir != nullptr);
+    return true;
+}
+
+bool computeCoreFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                         std::vector<double> radii,
+                         ccPointCloud* cloud,
+                         ccPointCloud* coreCloud,
+                         std::vector<CurvatureType> curvatures,
+                         std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                         bool roughness,
+                         CCVector3 roughnessUpDir,
+                         bool propagate)
+{
+    CCTRACE("computeCoreFeatures core cloud: " << (coreCloud ? coreCloud->getName().toStdString() : "null") << " propagate: " << propagate);
+    if (!cloud || !coreCloud)
+        throw std::invalid_argument("null cloud");
+    if (!CheckFeaturesParameters(features, radii, curvatures, densities, roughness))
+        return false;
+    if (coreCloud->size() == 0)
+    {
+        CCTRACE("no core points");
+        return false;
+    }
+    const CCVector3* upDir = (roughnessUpDir.norm2() != 0) ? &roughnessUpDir : nullptr;
+
+    //results on the core cloud, neighbours in the cloud
+    FeaturesPassParameters params;
+    params.roughnessUpDir = upDir;
+    std::vector<int> coreSFIndexes;
+    bool ok = PrepareFeaturesOutputs(coreCloud, features, radii, curvatures, densities, roughness, params, coreSFIndexes)
+           && RunFeaturesPassAtQueryPoints(cloud, coreCloud, params);
+    if (!ok)
+    {
+        CCTRACE("Failed to apply processing to core cloud " << coreCloud->getName().toStdString());
+        DeleteFeaturesOutputs(coreCloud, coreSFIndexes);
+        return false;
+    }
+    FinalizeFeaturesOutputs(coreCloud, coreSFIndexes, upDir != nullptr);
+
+    if (propagate)
+    {
+        //same scalar fields (same order) on the cloud, values of the nearest core point
+        FeaturesPassParameters cloudParams;
+        std::vector<int> sfIndexes;
+        ok = PrepareFeaturesOutputs(cloud, features, radii, curvatures, densities, roughness, cloudParams, sfIndexes);
+        if (ok)
+        {
+            std::vector<std::pair<CCCoreLib::ScalarField*, CCCoreLib::ScalarField*>> sfPairs;
+            for (size_t k = 0; k < sfIndexes.size(); ++k)
+                sfPairs.emplace_back(coreCloud->getScalarField(coreSFIndexes[k]), cloud->getScalarField(sfIndexes[k]));
+            ok = PropagateFromNearestPoint(coreCloud, nullptr, sfPairs, cloud, nullptr);
+        }
+        if (!ok)
+        {
+            CCTRACE("Failed to propagate the values to cloud " << cloud->getName().toStdString());
+            DeleteFeaturesOutputs(cloud, sfIndexes);
+            return false;
+        }
+        FinalizeFeaturesOutputs(cloud, sfIndexes, upDir != nullptr);
+    }
+    return true;
+}
+
+bool updateFeaturesAfterAppend(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                               std::vector<double> radii,
+                               ccPointCloud* cloud,
+                               unsigned firstNewPoint,
+                               std::vector<CurvatureType> curvatures,
+                               std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                               bool roughness,
+                               CCVector3 roughnessUpDir)
+{
+    CCTRACE("updateFeaturesAfterAppend first new point: " << firstNewPoint);
+    if (!cloud)
+        throw std::invalid_argument("null cloud");
+    if (firstNewPoint > cloud->size())
+        throw std::invalid_argument("first new point index out of range");
+    if (!CheckFeaturesParameters(features, radii, curvatures, densities, roughness))
+        return false;
+    const CCVector3* upDir = (roughnessUpDir.norm2() != 0) ? &roughnessUpDir : nullptr;
+
+    //the characteristics of a point change if a new point is in its largest neighbourhood
+    const double maxRadius = *std::max_element(radii.begin(), radii.end());
+    std::vector<uint8_t> updateMask = MarkNeighbourhoodOfNewPoints(cloud, firstNewPoint, static_cast<PointCoordinateType>(maxRadius));
+    if (updateMask.empty())
+        return false;
+
+    FeaturesPassParameters params;
+    params.roughnessUpDir = upDir;
+    params.coreMask = &updateMask;
+
+    const int previousSFCount = static_cast<int>(cloud->getNumberOfScalarFields());
+    std::vector<int> sfIndexes;
+    bool ok = PrepareFeaturesOutputs(cloud, features, radii, curvatures, densities, roughness, params, sfIndexes);
+    std::vector<int> newSFIndexes;
+    for (int sfIdx : sfIndexes)
+        if (sfIdx >= previousSFCount)
+            newSFIndexes.push_back(sfIdx);
+    if (ok)
+    {
+        //no stored values for some characteristics: everything is computed
+        if (!newSFIndexes.empty())
+        {
+            CCTRACE(newSFIndexes.size() << " scalar field(s) not computed before, all the points are evaluated");
+            params.coreMask = nullptr;
+        }
+        else
+        {
+            CCTRACE(std::count(updateMask.begin(), updateMask.end(), 1) << " points evaluated on " << cloud->size());
+        }
+        ok = RunFeaturesPassOnCloud(cloud, params);
+    }
+    if (!ok)
+    {
+        //the stored values of the former scalar fields are kept
+        CCTRACE("Failed to apply processing to cloud " << cloud->getName().toStdString());
+        DeleteFeaturesOutputs(cloud, newSFIndexes);
+        return false;
+    }
+    FinalizeFeaturesOutputs(cloud, sfIndexes, upDir != nullptr);
+    return true;
+}
+
+CloudSpacingStats EstimatePointCloudSpacing(ccGenericPointCloud* cloud, unsigned knn, unsigned sampleCount, unsigned seed)
+{
+    if (!cloud)
+        throw std::invalid_argument("null cloud");
+    if (knn < 2)
+        throw std::invalid_argument("knn must be at least 2 (the point itself is included)");
+    if (sampleCount == 0)
+        throw std::invalid_argument("sampleCount must be positive");
+    CCTRACE("EstimatePointCloudSpacing cloud: " << cloud->getName().toStdString() << " knn: " << knn << " sampleCount: " << sampleCount);
+
+    CloudSpacingStats stats;
+    stats.knn = knn;
+    const unsigned count = cloud->size();
+    if (count < knn)
+    {
+        CCTRACE("not enough points: " << count);
+        return stats;
+    }
+    ccOctree::Shared octree = GetOrComputeOctree(cloud);
+    if (!octree)
+        return stats;
+    const unsigned char level = octree->findBestLevelForAGivenPopulationPerCell(knn);
+
+    //random points (with replacement), or all the points of a small cloud
+    std::vector<unsigned> samples;
+    if (count <= sampleCount)
+    {
+        samples.resize(count);
+        std::iota(samples.begin(), samples.end(), 0);
+    }
+    else
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<unsigned> distribution(0, count - 1);
+        samples.resize(sampleCount);
+        for (unsigned& index : samples)
+            index = distribution(generator);
+    }
 
-                if (pc && sfIdx >= 0)
-                {
-                    pc->deleteScalarField(sfIdx);
-                    sfIdx = -1;
-                }
+    std::vector<double> nearest;
+    std::vector<double> farthest;
+    nearest.reserve(samples.size());
+    farthest.reserve(samples.size());
+    CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+    nNSS.level = level;
+    for (unsigned index : samples)
+    {
+        //the sampled points are scattered: new search structure for each point
+        cloud->getPoint(index, nNSS.queryPoint);
+        nNSS.minNumberOfNeighbors = knn;
+        nNSS.pointsInNeighbourhood.clear();
+        bool inBounds = false;
+        octree->getTheCellPosWhichIncludesThePoint(&nNSS.queryPoint, nNSS.cellPos, level, inBounds);
+        nNSS.alreadyVisitedNeighbourhoodSize = inBounds ? 0 : 1;
+        octree->computeCellCenter(nNSS.cellPos, level, nNSS.cellCenter);
+
+        //the neighbours are sorted by distance, the first one is the point itself
+        if (octree->findNearestNeighborsStartingFromCell(nNSS) < knn)
+            continue;
+        nearest.push_back(std::sqrt(nNSS.pointsInNeighbourhood[1].squareDistd));
+        farthest.push_back(std::sqrt(nNSS.pointsInNeighbourhood[knn - 1].squareDistd));
+    }
+    if (farthest.empty())
+        return stats;
 
-                ccLog::Error(errorMessage);
-                CCTRACE(errorMessage.toStdString());
-                return false;
+    std::sort(nearest.begin(), nearest.end());
+    std::sort(farthest.begin(), farthest.end());
+    auto percentile = [](const std::vector<double>& sorted, double q)
+    {
+        double pos = q * (sorted.size() - 1);
+        size_t i = static_cast<size_t>(pos);
+        size_t j = std::min(i + 1, sorted.size() - 1);
+        return sorted[i] + (pos - i) * (sorted[j] - sorted[i]);
+    };
+    stats.sampleCount = static_cast<unsigned>(farthest.size());
+    stats.nearestMedian = percentile(nearest, 0.5);
+    stats.median = percentile(farthest, 0.5);
+    stats.p10 = percentile(farthest, 0.10);
+    stats.p25 = percentile(farthest, 0.25);
+    stats.p75 = percentile(farthest, 0.75);
+    stats.p90 = percentile(farthest, 0.90);
+    CCTRACE("spacing: " << stats.nearestMedian << " median radius: " << stats.median);
+    return stats;
+}
+
+double EstimatePointCloudRadius(std::vector<ccHObject*> clouds, unsigned knn, unsigned sampleCount)
+{
+    CCTRACE("EstimatePointCloudRadius knn: " << knn << " nbClouds: " << clouds.size());
+    double radius = -1;
+    for (ccHObject* entity : clouds)
+    {
+        ccGenericPointCloud* cloud = dynamic_cast<ccGenericPointCloud*>(entity);
+        if (!cloud)
+            throw std::invalid_argument("entity is not a cloud");
+        CloudSpacingStats stats = EstimatePointCloudSpacing(cloud, knn, sampleCount);
+
+        //we keep the smallest value
+        if (stats.sampleCount != 0 && (radius < 0 || stats.median < radius))
+            radius = stats.median;
+    }
+    CCTRACE("radius: " << radius);
+    return radius;
+}
+
+void computeSymmetricEigen3x3(const double* matrices, size_t count, double* values, double* vectors, bool useJacobi)
+{
+    CCTRACE("computeSymmetricEigen3x3 count: " << count << " useJacobi: " << useJacobi);
+    if (useJacobi)
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            const double* a = matrices + 9 * n;
+            CCCoreLib::SquareMatrixd cov(3);
+            for (unsigned r = 0; r < 3; ++r)
+                for (unsigned c = 0; c < 3; ++c)
+                    cov.m_values[r][c] = a[3 * r + c];
+            CCCoreLib::SquareMatrixd eigVectors;
+            std::vector<double> eigValues;
+            if (!CCCoreLib::Jacobi<double>::ComputeEigenValuesAndVectors(cov, eigVectors, eigValues, false))
+                throw std::runtime_error("Jacobi eigen decomposition failed");
+            CCCoreLib::Jacobi<double>::SortEigenValuesAndVectors(eigVectors, eigValues);
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                double e[3];
+                CCCoreLib::Jacobi<double>::GetEigenVector(eigVectors, k, e);
+                values[3 * n + k] = eigValues[k];
+                for (unsigned c = 0; c < 3; ++c)
+                    vectors[9 * n + 3 * c + k] = e[c];
             }
         }
+        return;
     }
 
-    return true;
+    SymEigen3x3::Batch batch;
+    for (size_t start = 0; start < count; start += SymEigen3x3::BatchSize)
+    {
+        const unsigned batchCount = static_cast<unsigned>(std::min<size_t>(SymEigen3x3::BatchSize, count - start));
+        for (unsigned i = 0; i < batchCount; ++i)
+        {
+            const double* a = matrices + 9 * (start + i);
+            batch.a00[i] = a[0];
+            batch.a01[i] = a[1];
+            batch.a02[i] = a[2];
+            batch.a11[i] = a[4];
+            batch.a12[i] = a[5];
+            batch.a22[i] = a[8];
+        }
+        SymEigen3x3::Solve(batch, batchCount);
+        for (unsigned i = 0; i < batchCount; ++i)
+        {
+            const size_t n = start + i;
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                values[3 * n + k] = batch.values[k][i];
+                for (unsigned c = 0; c < 3; ++c)
+                    vectors[9 * n + 3 * c + k] = batch.vectors[k][c][i];
+            }
+        }
+    }
 }
 
 QString pyCC_GetDensitySFName(
     CCCoreLib::GeometricalAnalysisTools::Density densityType,
     bool approx,
-    double densityKernelSize)
+    double densityKernelSize,
+    unsigned knn)
 {
 // --- from ccLibAlgorithms::GetDensitySFName
     CCTRACE("pyCCGetDensitySFName");
@@ -1195,7 +2497,12 @@ QString pyCC_GetDensitySFName(
         break;
     }
 
-    sfName += QString(" (r=%2)").arg(densityKernelSize);
+    if (knn == 0)
+        sfName += QString(" (r=%2)").arg(densityKernelSize);
+    else if (densityKernelSize > 0)
+        sfName += QString(" (r=%1, k=%2)").arg(densityKernelSize).arg(knn);
+    else
+        sfName += QString(" (k=%1)").arg(knn);
 
     if (approx)
         sfName += " [approx]";
@@ -1220,6 +2527,52 @@ PointCoordinateType pyCC_GetDefaultCloudKernelSize(ccGenericPointCloud* cloud, u
     return -CCCoreLib::PC_ONE;
 }
 
+unsigned pyCC_CompactCloudInPlace(ccPointCloud* cloud, const uint8_t* keep)
+{
+    assert(cloud && keep);
+    const unsigned count = cloud->size();
+
+    //stable compaction: the kept points are swapped (with all their attributes) toward the beginning
+    unsigned kept = 0;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        if (keep[i])
+        {
+            if (kept != i)
+                cloud->swapPoints(kept, i);
+            ++kept;
+        }
+    }
+    if (kept == count)
+        return 0;
+
+    //structures indexed by the former point indexes are no more valid
+    if (cloud->gridCount() != 0)
+    {
+        CCTRACE("scan grids removed by the in place filtering");
+        cloud->removeGrids();
+    }
+    if (cloud->hasFWF())
+    {
+        CCTRACE("waveforms removed by the in place filtering");
+        cloud->clearFWFData();
+    }
+    cloud->deleteOctree();
+    cloud->unallocateVisibilityArray();
+
+    //shrinking does not allocate: a failure here leaves the cloud with its kept points first, followed by the
+    //removed ones, which can not be reported as a simple count
+    if (!cloud->resize(kept))
+    {
+        CCTRACE("resize failed!");
+        throw std::runtime_error("in place compaction: failed to resize the cloud, the kept points are the first ones");
+    }
+    for (unsigned i = 0; i < cloud->getNumberOfScalarFields(); ++i)
+        cloud->getScalarField(i)->computeMinAndMax();
+    cloud->invalidateBoundingBox();
+    return count - kept;
+}
+
 bool ICP(
     ccHObject* data,
     ccHObject* model,
@@ -1494,6 +2847,155 @@ bool ICP(
     return (result < CCCoreLib::ICPRegistrationTools::ICP_ERROR);
 }
 
+// --- normals of several clouds computed concurrently
+
+namespace
+{
+    //! a cloud whose normals are computed with the LS model by ComputeLSNormalsConcurrently
+    struct NormalsTask
+    {
+        ccPointCloud* cloud = nullptr;
+        ccOctree::Shared cloudOctree;                   //!< the octree of the cloud, if any
+        std::unique_ptr<CCCoreLib::DgmOctree> ownOctree; //!< else a temporary one
+        const CCCoreLib::DgmOctree* octree = nullptr;
+        unsigned char level = 0;
+        NormsIndexesTableType* norms = nullptr;
+        const std::vector<uint8_t>* updateMask = nullptr; //!< when defined, only the flagged points are computed
+        bool ok = false;
+    };
+
+    //! computes the normals of several clouds with the LS model (sphere of the given radius), on the global thread pool
+    /*! The work is split in chunks of points, all the clouds mixed: the small clouds do not leave threads idle.
+     *  The octree of a cloud is used if it exists, else a temporary octree is built (in parallel with the others).
+     *  The normals are oriented with preferredOrientation (as ccPointCloud::computeNormalsWithOctree does).
+     *  With update masks, only the flagged points of a cloud with normals are computed, the others keep their normal.
+     *  \return one status per cloud
+     */
+    std::vector<bool> ComputeLSNormalsConcurrently(const std::vector<ccPointCloud*>& clouds,
+                                                   PointCoordinateType radius,
+                                                   ccNormalVectors::Orientation preferredOrientation,
+                                                   const std::vector<const std::vector<uint8_t>*>& updateMasks = {})
+    {
+        std::vector<NormalsTask> tasks(clouds.size());
+        for (size_t i = 0; i < clouds.size(); ++i)
+        {
+            tasks[i].cloud = clouds[i];
+            tasks[i].cloudOctree = clouds[i]->getOctree();
+            if (i < updateMasks.size() && clouds[i]->hasNormals())
+                tasks[i].updateMask = updateMasks[i];
+        }
+
+        //octrees and output tables
+        QtConcurrent::blockingMap(tasks, [radius](NormalsTask& task)
+        {
+            task.octree = task.cloudOctree.data();
+            if (!task.octree)
+            {
+                task.ownOctree.reset(new CCCoreLib::DgmOctree(task.cloud));
+                if (task.ownOctree->build() <= 0)
+                    return;
+                task.octree = task.ownOctree.get();
+            }
+            task.level = task.octree->findBestLevelForAGivenNeighbourhoodSizeExtraction(radius);
+            task.norms = new NormsIndexesTableType;
+            try
+            {
+                task.norms->resize(task.cloud->size(), ccNormalVectors::GetNormIndex(CCVector3(0, 0, 0).u));
+            }
+            catch (const std::bad_alloc&)
+            {
+                return;
+            }
+            if (task.updateMask)
+            {
+                for (unsigned i = 0; i < task.cloud->size(); ++i)
+                    task.norms->setValue(i, task.cloud->getPointNormalIndex(i));
+            }
+            task.ok = true;
+        });
+
+        //chunks of points of all the clouds
+        const unsigned chunkSize = 1 << 12;
+        std::vector<std::pair<size_t, unsigned>> chunks;
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            if (tasks[i].ok)
+                for (unsigned start = 0; start < tasks[i].cloud->size(); start += chunkSize)
+                    chunks.emplace_back(i, start);
+        }
+        QtConcurrent::blockingMap(chunks, [&tasks, radius](const std::pair<size_t, unsigned>& chunk)
+        {
+            NormalsTask& task = tasks[chunk.first];
+            const CCCoreLib::DgmOctree* octree = task.octree;
+            const unsigned end = std::min(task.cloud->size(), chunk.second + chunkSize);
+
+            CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+            nNSS.level = task.level;
+            std::vector<NeighbourhoodPCA> pcas(end - chunk.second);
+            std::unique_ptr<bool[]> pcaOk(new bool[end - chunk.second]);
+            std::vector<PCARequest> requests(end - chunk.second);
+            for (unsigned i = chunk.second; i < end; ++i)
+            {
+                PCARequest& request = requests[i - chunk.second];
+                request.pca = &pcas[i - chunk.second];
+                request.ok = &pcaOk[i - chunk.second];
+                if (task.updateMask && !(*task.updateMask)[i])
+                    continue; //not updated: the normal is kept
+
+                task.cloud->getPoint(i, nNSS.queryPoint);
+                nNSS.prepare(radius, octree->getCellSize(task.level));
+                nNSS.pointsInNeighbourhood.clear();
+                bool inBounds = false;
+                octree->getTheCellPosWhichIncludesThePoint(&nNSS.queryPoint, nNSS.cellPos, task.level, inBounds);
+                nNSS.alreadyVisitedNeighbourhoodSize = inBounds ? 0 : 1;
+                octree->computeCellCenter(nNSS.cellPos, task.level, nNSS.cellCenter);
+
+                unsigned neighborCount = octree->findNeighborsInASphereStartingFromCell(nNSS, radius, false);
+                for (unsigned j = 0; j < neighborCount; ++j)
+                {
+                    const CCVector3 d = *nNSS.pointsInNeighbourhood[j].point - nNSS.queryPoint;
+                    request.moments.add(d.x, d.y, d.z);
+                }
+            }
+            ComputeNeighbourhoodPCAs(requests);
+
+            //the normal of the LS plane is the eigen vector of the smallest eigen value
+            for (unsigned i = chunk.second; i < end; ++i)
+            {
+                if (pcaOk[i - chunk.second])
+                {
+                    CCVector3 N = ToPC(pcas[i - chunk.second].e3);
+                    task.norms->setValue(i, ccNormalVectors::GetNormIndex(N.u));
+                }
+            }
+        });
+
+        std::vector<bool> results(tasks.size(), false);
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            NormalsTask& task = tasks[i];
+            if (task.ok && preferredOrientation != ccNormalVectors::UNDEFINED)
+                task.ok = ccNormalVectors::UpdateNormalOrientations(task.cloud, *task.norms, preferredOrientation);
+            if (task.ok && !task.cloud->hasNormals())
+                task.ok = task.cloud->resizeTheNormsTable();
+            if (task.ok)
+            {
+                for (unsigned j = 0; j < task.norms->size(); ++j)
+                    task.cloud->setPointNormalIndex(j, task.norms->getValue(j));
+                task.cloud->showNormals(true);
+            }
+            else
+            {
+                CCTRACE("Failed to compute the normals of cloud " << task.cloud->getName().toStdString());
+            }
+            if (task.norms)
+                task.norms->release();
+            results[i] = task.ok;
+        }
+        return results;
+    }
+}
+
 bool computeNormals(std::vector<ccHObject*> selectedEntities,
                     CCCoreLib::LOCAL_MODEL_TYPES model,
                     bool useScanGridsForComputation,
@@ -1566,8 +3068,9 @@ bool computeNormals(std::vector<ccHObject*> selectedEntities,
 
                 if (defaultRadius == 0.0)
                 {
-                    //default radius
-                    defaultRadius = ccOctree::GuessNaiveRadius(cloud);
+                    //default radius: sampled local spacing, naive guess from the bounding box as a fallback
+                    double radius = EstimatePointCloudRadius({ cloud });
+                    defaultRadius = (radius > 0 ? static_cast<PointCoordinateType>(radius) : ccOctree::GuessNaiveRadius(cloud));
                 }
             }
             else if (entity->isKindOf(CC_TYPES::MESH))
@@ -1631,6 +3134,24 @@ bool computeNormals(std::vector<ccHObject*> selectedEntities,
 
         size_t errors = 0;
 
+        //several clouds, LS model: all the octree based computations are scheduled together on the thread pool
+        std::vector<ccPointCloud*> concurrentClouds;
+        if (clouds.size() > 1 && model == CCCoreLib::LS)
+        {
+            for (auto cloud : clouds)
+                if (!(useGridStructure && cloud->gridCount()))
+                    concurrentClouds.push_back(cloud);
+        }
+        std::map<ccPointCloud*, bool> concurrentResults;
+        if (!concurrentClouds.empty())
+        {
+            CCTRACE("normals of " << concurrentClouds.size() << " clouds computed concurrently");
+            std::vector<bool> results = ComputeLSNormalsConcurrently(concurrentClouds, defaultRadius,
+                                                                     orientNormals ? preferredOrientation : ccNormalVectors::UNDEFINED);
+            for (size_t i = 0; i < concurrentClouds.size(); ++i)
+                concurrentResults[concurrentClouds[i]] = results[i];
+        }
+
         for (auto cloud : clouds)
         {
             Q_ASSERT(cloud != nullptr);
@@ -1646,10 +3167,14 @@ bool computeNormals(std::vector<ccHObject*> selectedEntities,
             }
             else
             {
-                //compute normals with the octree
+                //compute normals with the octree (already done for several clouds)
                 normalsAlreadyOriented = orientNormals && (preferredOrientation != ccNormalVectors::UNDEFINED);
-                result = cloud->computeNormalsWithOctree(
-                        model, orientNormals ? preferredOrientation : ccNormalVectors::UNDEFINED, defaultRadius, nullptr);
+                auto concurrent = concurrentResults.find(cloud);
+                if (concurrent != concurrentResults.end())
+                    result = concurrent->second;
+                else
+                    result = cloud->computeNormalsWithOctree(
+                            model, orientNormals ? preferredOrientation : ccNormalVectors::UNDEFINED, defaultRadius, nullptr);
                 if (result)
                 {
                     //save the normal computation radius as meta-data
@@ -1762,6 +3287,128 @@ bool computeNormals(std::vector<ccHObject*> selectedEntities,
     return true;
 }
 
+namespace
+{
+    //! orients the updated normals of a cloud (see updateNormalsAfterAppend)
+    /*! The former points take back the orientation of their former normal. From them, the orientation is propagated
+     *  to the new points, from neighbour to neighbour (sphere of the given radius). A part of the new points
+     *  out of reach keeps the orientation computed for its first point.
+     */
+    void OrientUpdatedNormals(ccPointCloud* cloud,
+                              const std::vector<uint8_t>& updateMask,
+                              const std::vector<std::pair<unsigned, CCVector3>>& formerNormals,
+                              unsigned firstNewPoint,
+                              PointCoordinateType radius)
+    {
+        ccOctree::Shared octree = cloud->getOctree();
+        const unsigned char level = octree->findBestLevelForAGivenNeighbourhoodSizeExtraction(radius);
+        std::vector<uint8_t> oriented(cloud->size(), 0);
+        std::vector<unsigned> queue;
+
+        for (const auto& former : formerNormals)
+        {
+            const CCVector3& N = cloud->getPointNormal(former.first);
+            if (N.dot(former.second) < 0)
+                cloud->setPointNormal(former.first, -N);
+            oriented[former.first] = 1;
+            queue.push_back(former.first);
+        }
+
+        CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+        nNSS.level = level;
+        size_t next = 0;
+        auto propagate = [&]()
+        {
+            for (; next < queue.size(); ++next)
+            {
+                const unsigned i = queue[next];
+                const CCVector3 Ni = cloud->getPointNormal(i);
+                cloud->getPoint(i, nNSS.queryPoint);
+                nNSS.prepare(radius, octree->getCellSize(level));
+                nNSS.pointsInNeighbourhood.clear();
+                bool inBounds = false;
+                octree->getTheCellPosWhichIncludesThePoint(&nNSS.queryPoint, nNSS.cellPos, level, inBounds);
+                nNSS.alreadyVisitedNeighbourhoodSize = inBounds ? 0 : 1;
+                octree->computeCellCenter(nNSS.cellPos, level, nNSS.cellCenter);
+                unsigned neighborCount = octree->findNeighborsInASphereStartingFromCell(nNSS, radius, false);
+                for (unsigned k = 0; k < neighborCount; ++k)
+                {
+                    const unsigned j = nNSS.pointsInNeighbourhood[k].pointIndex;
+                    if (!updateMask[j] || oriented[j])
+                        continue;
+                    const CCVector3& Nj = cloud->getPointNormal(j);
+                    if (Ni.dot(Nj) < 0)
+                        cloud->setPointNormal(j, -Nj);
+                    oriented[j] = 1;
+                    queue.push_back(j);
+                }
+            }
+        };
+        propagate();
+        for (unsigned i = firstNewPoint; i < cloud->size(); ++i)
+        {
+            if (updateMask[i] && !oriented[i])
+            {
+                oriented[i] = 1;
+                queue.push_back(i);
+                propagate();
+            }
+        }
+    }
+}
+
+bool updateNormalsAfterAppend(ccPointCloud* cloud, unsigned firstNewPoint, PointCoordinateType radius)
+{
+    if (!cloud)
+        throw std::invalid_argument("null cloud");
+    if (firstNewPoint > cloud->size())
+        throw std::invalid_argument("first new point index out of range");
+    CCTRACE("updateNormalsAfterAppend cloud: " << cloud->getName().toStdString() << " first new point: " << firstNewPoint);
+
+    static const QString s_NormalScaleKey("Normal scale");
+    if (radius <= 0 && cloud->hasMetaData(s_NormalScaleKey))
+    {
+        //same radius as the former computation
+        bool ok = false;
+        double formerRadius = cloud->getMetaData(s_NormalScaleKey).toDouble(&ok);
+        if (ok)
+            radius = static_cast<PointCoordinateType>(formerRadius);
+    }
+    if (radius <= 0)
+    {
+        double estimated = EstimatePointCloudRadius({ cloud });
+        radius = (estimated > 0 ? static_cast<PointCoordinateType>(estimated) : ccOctree::GuessNaiveRadius(cloud));
+    }
+
+    //the normal of a point changes if a new point is in its neighbourhood
+    std::vector<uint8_t> updateMask = MarkNeighbourhoodOfNewPoints(cloud, firstNewPoint, radius);
+    if (updateMask.empty())
+        return false;
+    if (!cloud->hasNormals())
+        CCTRACE("no former normals: all the points are computed");
+    else
+        CCTRACE(std::count(updateMask.begin(), updateMask.end(), 1) << " normals computed on " << cloud->size());
+
+    //the former points to update keep their orientation
+    const bool withFormerNormals = cloud->hasNormals();
+    std::vector<std::pair<unsigned, CCVector3>> formerNormals;
+    if (withFormerNormals)
+    {
+        for (unsigned i = 0; i < firstNewPoint; ++i)
+            if (updateMask[i])
+                formerNormals.emplace_back(i, cloud->getPointNormal(i));
+    }
+
+    std::vector<bool> results = ComputeLSNormalsConcurrently({ cloud }, radius, ccNormalVectors::UNDEFINED, { &updateMask });
+    if (!results.front())
+        return false;
+    if (withFormerNormals)
+        OrientUpdatedNormals(cloud, updateMask, formerNormals, firstNewPoint, radius);
+    cloud->setMetaData(s_NormalScaleKey, radius);
+    cloud->prepareDisplayForRefresh();
+    return true;
+}
+
 bool invertNormals(std::vector<ccHObject*> selectedEntities)
 {
     for (ccHObject* ent : selectedEntities)
@@ -1784,6 +3431,330 @@ bool invertNormals(std::vector<ccHObject*> selectedEntities)
     return true;
 }
 
+// --- normals orientation with a minimum spanning tree built in parallel
+
+namespace
+{
+    //! minimum of an atomic key (compare and swap loop)
+    inline void AtomicMin(std::atomic<uint64_t>& target, uint64_t value)
+    {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    //! union-find root, with path halving (not thread safe)
+    inline unsigned FindRoot(std::vector<unsigned>& parent, unsigned i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+}
+
+bool orientNormalsWithParallelMST(ccPointCloud* cloud, unsigned knn)
+{
+    if (!cloud || !cloud->hasNormals())
+    {
+        CCTRACE("a cloud with normals is required");
+        return false;
+    }
+    if (knn < 1)
+    {
+        CCTRACE("knn must be at least 1");
+        return false;
+    }
+    const unsigned count = cloud->size();
+    if (static_cast<uint64_t>(count) * knn >= std::numeric_limits<uint32_t>::max())
+    {
+        CCTRACE("too many points for the graph: " << count << " x " << knn);
+        return false;
+    }
+    CCTRACE("orientNormalsWithParallelMST cloud: " << cloud->getName().toStdString() << " knn: " << knn);
+    ccOctree::Shared octree = GetOrComputeOctree(cloud);
+    if (!octree)
+        return false;
+    const unsigned char level = octree->findBestLevelForAGivenPopulationPerCell(knn + 1);
+
+    const unsigned chunkSize = 1 << 12;
+    std::vector<unsigned> chunks;
+    for (unsigned start = 0; start < count; start += chunkSize)
+        chunks.push_back(start);
+
+    //kNN graph (the point itself excluded, missing neighbours replaced by the point itself) and normals
+    std::vector<unsigned> neighbours;
+    std::vector<CCVector3> normals;
+    try
+    {
+        neighbours.resize(static_cast<size_t>(count) * knn);
+        normals.resize(count);
+    }
+    catch (const std::bad_alloc&)
+    {
+        CCTRACE("not enough memory");
+        return false;
+    }
+    QtConcurrent::blockingMap(chunks, [&](unsigned start)
+    {
+        CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+        nNSS.level = level;
+        nNSS.minNumberOfNeighbors = knn + 1;
+        const unsigned end = std::min(count, start + chunkSize);
+        for (unsigned i = start; i < end; ++i)
+        {
+            normals[i] = cloud->getPointNormal(i);
+            cloud->getPoint(i, nNSS.queryPoint);
+            nNSS.pointsInNeighbourhood.clear();
+            bool inBounds = false;
+            octree->getTheCellPosWhichIncludesThePoint(&nNSS.queryPoint, nNSS.cellPos, level, inBounds);
+            nNSS.alreadyVisitedNeighbourhoodSize = inBounds ? 0 : 1;
+            octree->computeCellCenter(nNSS.cellPos, level, nNSS.cellCenter);
+            unsigned found = octree->findNearestNeighborsStartingFromCell(nNSS);
+
+            unsigned* slots = &neighbours[static_cast<size_t>(i) * knn];
+            unsigned slot = 0;
+            for (unsigned j = 0; j < found && slot < knn; ++j)
+            {
+                if (nNSS.pointsInNeighbourhood[j].pointIndex != i)
+                    slots[slot++] = nNSS.pointsInNeighbourhood[j].pointIndex;
+            }
+            for (; slot < knn; ++slot)
+                slots[slot] = i;
+        }
+    });
+
+    //Borůvka: at each round, every component selects its lightest edge (weight 1 - |Ni.Nj|, as the serial MST)
+    //in parallel, then the components are merged. Keys are (weight, edge index): the order is total, no cycle.
+    const uint64_t noEdge = std::numeric_limits<uint64_t>::max();
+    std::vector<unsigned> component(count);
+    std::iota(component.begin(), component.end(), 0);
+    std::vector<unsigned> parent = component;
+    std::vector<unsigned> roots = component;
+    std::unique_ptr<std::atomic<uint64_t>[]> best(new std::atomic<uint64_t>[count]);
+    std::vector<std::pair<unsigned, unsigned>> treeEdges;
+    treeEdges.reserve(count);
+    while (roots.size() > 1)
+    {
+        for (unsigned r : roots)
+            best[r].store(noEdge, std::memory_order_relaxed);
+        QtConcurrent::blockingMap(chunks, [&](unsigned start)
+        {
+            const unsigned end = std::min(count, start + chunkSize);
+            for (unsigned i = start; i < end; ++i)
+            {
+                const unsigned ci = component[i];
+                for (unsigned slot = 0; slot < knn; ++slot)
+                {
+                    const size_t edge = static_cast<size_t>(i) * knn + slot;
+                    const unsigned j = neighbours[edge];
+                    const unsigned cj = component[j];
+                    if (ci == cj)
+                        continue;
+                    float weight = 1.0f - std::abs(normals[i].dot(normals[j]));
+                    weight = std::max(weight, 0.0f); //positive floats are ordered as their bits
+                    uint32_t bits;
+                    memcpy(&bits, &weight, sizeof(bits));
+                    const uint64_t key = (static_cast<uint64_t>(bits) << 32) | static_cast<uint64_t>(edge);
+                    AtomicMin(best[ci], key);
+                    AtomicMin(best[cj], key);
+                }
+            }
+        });
+
+        size_t previousEdges = treeEdges.size();
+        for (unsigned r : roots)
+        {
+            const uint64_t key = best[r].load(std::memory_order_relaxed);
+            if (key == noEdge)
+                continue;
+            const size_t edge = static_cast<size_t>(key & 0xFFFFFFFF);
+            const unsigned i = static_cast<unsigned>(edge / knn);
+            const unsigned j = neighbours[edge];
+            const unsigned ri = FindRoot(parent, component[i]);
+            const unsigned rj = FindRoot(parent, component[j]);
+            if (ri == rj)
+                continue; //selected by both components
+            parent[std::max(ri, rj)] = std::min(ri, rj); //the root is the smallest index of the component
+            treeEdges.emplace_back(i, j);
+        }
+        if (treeEdges.size() == previousEdges)
+            break; //the remaining components are not connected in the graph
+
+        //the previous roots are relabelled first, then the points in parallel
+        std::vector<unsigned> newRoots;
+        for (unsigned r : roots)
+        {
+            parent[r] = FindRoot(parent, r);
+            if (parent[r] == r)
+                newRoots.push_back(r);
+        }
+        roots.swap(newRoots);
+        QtConcurrent::blockingMap(chunks, [&](unsigned start)
+        {
+            const unsigned end = std::min(count, start + chunkSize);
+            for (unsigned i = start; i < end; ++i)
+                component[i] = parent[component[i]];
+        });
+    }
+    best.reset();
+    CCTRACE("spanning forest: " << treeEdges.size() << " edges, " << roots.size() << " component(s)");
+
+    //propagation along the tree from the smallest index of each component, whose normal is kept
+    std::vector<unsigned> adjacencyStart(count + 1, 0);
+    for (const auto& e : treeEdges)
+    {
+        ++adjacencyStart[e.first + 1];
+        ++adjacencyStart[e.second + 1];
+    }
+    std::partial_sum(adjacencyStart.begin(), adjacencyStart.end(), adjacencyStart.begin());
+    std::vector<unsigned> adjacency(adjacencyStart.back());
+    {
+        std::vector<unsigned> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (const auto& e : treeEdges)
+        {
+            adjacency[fill[e.first]++] = e.second;
+            adjacency[fill[e.second]++] = e.first;
+        }
+    }
+    std::vector<bool> visited(count, false);
+    std::vector<unsigned> queue;
+    queue.reserve(count);
+    for (unsigned seed = 0; seed < count; ++seed)
+    {
+        if (visited[seed])
+            continue;
+        visited[seed] = true;
+        queue.clear();
+        queue.push_back(seed);
+        for (size_t q = 0; q < queue.size(); ++q)
+        {
+            const unsigned i = queue[q];
+            for (unsigned a = adjacencyStart[i]; a < adjacencyStart[i + 1]; ++a)
+            {
+                const unsigned j = adjacency[a];
+                if (visited[j])
+                    continue;
+                visited[j] = true;
+                if (normals[i].dot(normals[j]) < 0)
+                {
+                    normals[j] = -normals[j];
+                    cloud->setPointNormal(j, normals[j]);
+                }
+                queue.push_back(j);
+            }
+        }
+    }
+    cloud->showNormals(true);
+    cloud->prepareDisplayForRefresh();
+    return true;
+}
+
+int addScanGridFromIndices(ccPointCloud* cloud, const int* rows, const int* cols, size_t count,
+                           const CCVector3d& sensorCenter, unsigned width, unsigned height)
+{
+    if (!cloud)
+        throw std::invalid_argument("null cloud");
+    if (count != cloud->size())
+        throw std::invalid_argument("one row and one column index are required per point");
+    CCTRACE("addScanGridFromIndices cloud: " << cloud->getName().toStdString() << " points: " << count);
+
+    //grid size: largest indexes, unless given
+    int maxRow = -1;
+    int maxCol = -1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (rows[i] < 0 || cols[i] < 0)
+            continue;
+        maxRow = std::max(maxRow, rows[i]);
+        maxCol = std::max(maxCol, cols[i]);
+    }
+    if (maxRow < 0)
+        throw std::invalid_argument("no valid row and column indexes");
+    if (height == 0)
+        height = static_cast<unsigned>(maxRow) + 1;
+    if (width == 0)
+        width = static_cast<unsigned>(maxCol) + 1;
+    if (static_cast<unsigned>(maxRow) >= height || static_cast<unsigned>(maxCol) >= width)
+        throw std::invalid_argument("row or column index out of the grid");
+    if (static_cast<uint64_t>(width) * height > (1u << 30))
+        throw std::invalid_argument("grid too large");
+
+    ccPointCloud::Grid::Shared grid(new ccPointCloud::Grid);
+    grid->w = width;
+    grid->h = height;
+    grid->indexes.resize(static_cast<size_t>(width) * height, -1);
+    grid->validCount = 0;
+    grid->minValidIndex = std::numeric_limits<unsigned>::max();
+    grid->maxValidIndex = 0;
+    grid->sensorPosition.setTranslation(sensorCenter);
+
+    //the first point of a cell is kept
+    size_t collisions = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (rows[i] < 0 || cols[i] < 0)
+            continue;
+        int& cell = grid->indexes[static_cast<size_t>(rows[i]) * width + static_cast<unsigned>(cols[i])];
+        if (cell >= 0)
+        {
+            ++collisions;
+            continue;
+        }
+        cell = static_cast<int>(i);
+        ++grid->validCount;
+        grid->minValidIndex = std::min(grid->minValidIndex, static_cast<unsigned>(i));
+        grid->maxValidIndex = static_cast<unsigned>(i);
+    }
+    if (collisions)
+        CCTRACE(collisions << " points left out of the grid: cell already used");
+    CCTRACE("grid " << height << " rows x " << width << " columns, " << grid->validCount << " points");
+
+    if (!cloud->addGrid(grid))
+    {
+        CCTRACE("not enough memory");
+        return 0;
+    }
+    return static_cast<int>(grid->validCount);
+}
+
+int addScanGridFromAngles(ccPointCloud* cloud, const double* azimuths, const double* elevations, size_t count,
+                          double azimuthStep, double elevationStep, const CCVector3d& sensorCenter)
+{
+    if (!cloud)
+        throw std::invalid_argument("null cloud");
+    if (count != cloud->size())
+        throw std::invalid_argument("one azimuth and one elevation are required per point");
+    if (azimuthStep <= 0 || elevationStep <= 0)
+        throw std::invalid_argument("angular steps must be positive");
+    if (count == 0)
+        throw std::invalid_argument("empty cloud");
+
+    //columns from the smallest azimuth, rows from the highest elevation (top of the scan first)
+    double minAzimuth = std::numeric_limits<double>::max();
+    double maxElevation = -std::numeric_limits<double>::max();
+    for (size_t i = 0; i < count; ++i)
+    {
+        minAzimuth = std::min(minAzimuth, azimuths[i]);
+        maxElevation = std::max(maxElevation, elevations[i]);
+    }
+    std::vector<int> rows(count);
+    std::vector<int> cols(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        double col = std::round((azimuths[i] - minAzimuth) / azimuthStep);
+        double row = std::round((maxElevation - elevations[i]) / elevationStep);
+        if (!(col < (1 << 30)) || !(row < (1 << 30)))
+            throw std::invalid_argument("invalid angle, or angular step too small");
+        rows[i] = static_cast<int>(row);
+        cols[i] = static_cast<int>(col);
+    }
+    return addScanGridFromIndices(cloud, rows.data(), cols.data(), count, sensorCenter);
+}
+
 //! TODO: Copied/adpated from qCC/ccVolumeCalcTool::ComputeVolume
 bool ComputeVolume_(    ccRasterGrid& grid,
                         ccGenericPointCloud* ground,
@@ -160,23 +160,154 @@ enum CurvatureType
 };
 
 //! Computes a geometric characteristic (see GeometricalAnalysisTools::GeomCharacteristic) on a list of clouds
-/*! Computes a geometric characteristic (see GeometricalAnalysisTools::GeomCharacteristic) on a set of entities
+/*! Computes a geometric characteristic (see GeometricalAnalysisTools::GeomCharacteristic) on a set of entities.
+ *  Radius neighbourhoods use CCCoreLib::GeometricalAnalysisTools (the reference of the computeFeatures engine),
+ *  knn neighbourhoods use the single pass engine of computeFeatures.
  * \param option from (GAUSSIAN_CURV, MEAN_CURV, NORMAL_CHANGE_RATE)
  * \param list of clouds
+ * \param knn when not 0, the neighbourhood is made of the knn nearest neighbours
+ *        (limited to the radius when radius > 0), see computeFeatures
  * \return status
  */
-bool computeCurvature(CurvatureType option, double radius, std::vector<ccHObject*> clouds);
+bool computeCurvature(CurvatureType option, double radius, std::vector<ccHObject*> clouds, unsigned knn = 0);
 
-bool computeFeature(CCCoreLib::Neighbourhood::GeomFeature option, double radius, std::vector<ccHObject*> clouds);
+bool computeFeature(CCCoreLib::Neighbourhood::GeomFeature option, double radius, std::vector<ccHObject*> clouds, unsigned knn = 0);
 
-bool computeLocalDensity(CCCoreLib::GeometricalAnalysisTools::Density option, double radius, std::vector<ccHObject*> clouds);
+bool computeLocalDensity(CCCoreLib::GeometricalAnalysisTools::Density option, double radius, std::vector<ccHObject*> clouds, unsigned knn = 0);
 
 bool computeApproxLocalDensity(CCCoreLib::GeometricalAnalysisTools::Density option, double radius, std::vector<ccHObject*> clouds);
 
-bool computeRoughnessPy(double radius, std::vector<ccHObject*> clouds, CCVector3 roughnessUpDir = CCVector3(0,0,0));
+bool computeRoughnessPy(double radius, std::vector<ccHObject*> clouds, CCVector3 roughnessUpDir = CCVector3(0,0,0), unsigned knn = 0);
 
 bool computeMomentOrder1(double radius, std::vector<ccHObject*> clouds);
 
+//! Computes several geometric characteristics on a list of clouds in a single neighbourhood pass
+/*! For each point, the neighbourhood is extracted once and its covariance matrix is decomposed once,
+ *  all the requested characteristics are derived from them (one scalar field per characteristic,
+ *  named as with computeFeature, computeCurvature, computeLocalDensity and computeRoughnessPy).
+ * \param features list of GeomFeature
+ * \param radius neighbourhood radius
+ * \param clouds list of clouds
+ * \param curvatures list of curvature types
+ * \param densities list of density types
+ * \param roughness compute the roughness
+ * \param roughnessUpDir when not null, up direction for a signed roughness
+ * \param knn when not 0, the neighbourhood is made of the knn nearest neighbours instead of a sphere,
+ *        limited to the radius when radius > 0 (hybrid mode). The densities then use the distance
+ *        to the farthest neighbour as radius, the scalar field names get a " (k=...)" suffix.
+ * \return status
+ */
+bool computeFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                     double radius,
+                     std::vector<ccHObject*> clouds,
+                     std::vector<CurvatureType> curvatures = std::vector<CurvatureType>(),
+                     std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities = std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+                     bool roughness = false,
+                     CCVector3 roughnessUpDir = CCVector3(0,0,0),
+                     unsigned knn = 0);
+
+//! Computes several geometric characteristics at several scales on a list of clouds in a single neighbourhood pass
+/*! For each point, the neighbourhood of the largest radius is extracted once and sorted by distance,
+ *  the covariance of the smaller (nested) neighbourhoods is accumulated incrementally.
+ *  One scalar field is produced per characteristic and per radius (names as with computeFeatures).
+ * \param features list of GeomFeature
+ * \param radii list of neighbourhood radii
+ * \param clouds list of clouds
+ * \param curvatures list of curvature types
+ * \param densities list of density types
+ * \param roughness compute the roughness
+ * \param roughnessUpDir when not null, up direction for a signed roughness
+ * \return status
+ */
+bool computeMultiScaleFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                               std::vector<double> radii,
+                               std::vector<ccHObject*> clouds,
+                               std::vector<CurvatureType> curvatures = std::vector<CurvatureType>(),
+                               std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities = std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+                               bool roughness = false,
+                               CCVector3 roughnessUpDir = CCVector3(0,0,0));
+
+//! Computes geometric characteristics only at core points, given by their indexes in the cloud
+/*! The neighbours are searched in the whole cloud. The scalar fields are created on the cloud,
+ *  the points which are not core points get NaN, or the value of their nearest core point if propagate is true.
+ * \param features list of GeomFeature
+ * \param radii list of neighbourhood radii
+ * \param cloud the cloud
+ * \param coreIndexes indexes of the core points in the cloud
+ * \param curvatures list of curvature types
+ * \param densities list of density types
+ * \param roughness compute the roughness
+ * \param roughnessUpDir when not null, up direction for a signed roughness
+ * \param propagate give the value of the nearest core point to the other points
+ * \return status
+ */
+bool computeCoreFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                         std::vector<double> radii,
+                         ccPointCloud* cloud,
+                         std::vector<unsigned> coreIndexes,
+                         std::vector<CurvatureType> curvatures = std::vector<CurvatureType>(),
+                         std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities = std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+                         bool roughness = false,
+                         CCVector3 roughnessUpDir = CCVector3(0,0,0),
+                         bool propagate = false);
+
+//! Computes geometric characteristics at the points of a core cloud, the neighbours being searched in another cloud
+/*! The scalar fields are created on the core cloud. If propagate is true, the same scalar fields are created on the cloud,
+ *  with the value of the nearest core point.
+ * \param features list of GeomFeature
+ * \param radii list of neighbourhood radii
+ * \param cloud the cloud where the neighbours are searched
+ * \param coreCloud the core points
+ * \param curvatures list of curvature types
+ * \param densities list of density types
+ * \param roughness compute the roughness
+ * \param roughnessUpDir when not null, up direction for a signed roughness
+ * \param propagate give the value of the nearest core point to the points of the cloud
+ * \return status
+ */
+bool computeCoreFeatures(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                         std::vector<double> radii,
+                         ccPointCloud* cloud,
+                         ccPointCloud* coreCloud,
+                         std::vector<CurvatureType> curvatures = std::vector<CurvatureType>(),
+                         std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities = std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+                         bool roughness = false,
+                         CCVector3 roughnessUpDir = CCVector3(0,0,0),
+                         bool propagate = false);
+
+//! Updates geometric characteristics after points were appended to a cloud (see ccPointCloud::operator+=)
+/*! Only the new points and the former points within the largest radius of them are evaluated,
+ *  the other points keep the values of their scalar fields. A characteristic without scalar field yet is computed on all the points.
+ * \param features list of GeomFeature
+ * \param radii list of neighbourhood radii
+ * \param cloud
+ * \param firstNewPoint index of the first appended point (size of the cloud before the append)
+ * \param curvatures list of curvature types
+ * \param densities list of density types
+ * \param roughness compute the roughness
+ * \param roughnessUpDir when not null, up direction for a signed roughness
+ * \return status
+ */
+bool updateFeaturesAfterAppend(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                               std::vector<double> radii,
+                               ccPointCloud* cloud,
+                               unsigned firstNewPoint,
+                               std::vector<CurvatureType> curvatures = std::vector<CurvatureType>(),
+                               std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities = std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+                               bool roughness = false,
+                               CCVector3 roughnessUpDir = CCVector3(0,0,0));
+
+//! Eigen decomposition of symmetric 3x3 matrices (covariance matrices of neighbourhoods)
+/*! By default, the closed-form solver used by the geometric features (SymEigen3x3, batches of matrices),
+ *  or the iterative Jacobi method of CCCoreLib, for comparison.
+ * \param matrices count matrices, 9 values each (row major, only the upper triangle is used by the closed-form solver)
+ * \param count number of matrices
+ * \param values output, 3 eigen values per matrix, in decreasing order
+ * \param vectors output, 9 values per matrix (row major, the eigen vectors are the columns)
+ * \param useJacobi use the Jacobi method of CCCoreLib (signed eigen values, as the closed-form solver)
+ */
+void computeSymmetricEigen3x3(const double* matrices, size_t count, double* values, double* vectors, bool useJacobi = false);
+
 //! Filters out points whose scalar values falls into an interval(see ccPointCloud::filterBySFValue)
 /** Threshold values should be expressed relatively to the current displayed scalar field.
  \param minVal minimum value
@@ -201,6 +332,40 @@ ccMesh* filterBySFValue(double minVal, double maxVal, ccMesh* mesh);
  */
 double GetPointCloudRadius(std::vector<ccHObject*> clouds, unsigned knn = 12);
 
+//! Local spacing of a cloud, estimated on a random sample of points (see EstimatePointCloudSpacing)
+struct CloudSpacingStats
+{
+    unsigned knn = 0;               //!< number of points of the neighbourhoods, the point itself included
+    unsigned sampleCount = 0;       //!< number of sampled points (0: estimation failed)
+    double nearestMedian = 0;       //!< median distance to the nearest neighbour (point spacing)
+    double median = 0;              //!< median distance to the farthest of the knn points
+    double p10 = 0;                 //!< percentiles of the distance to the farthest of the knn points
+    double p25 = 0;
+    double p75 = 0;
+    double p90 = 0;
+};
+
+//! Estimates the local spacing of a cloud with k nearest neighbours queries on a random sample of points
+/*! Only sampleCount points are queried: the cost does not depend on the cloud size,
+ *  except for the octree, computed if needed and kept on the cloud for the following computations.
+ * \param cloud the cloud
+ * \param knn number of points of the neighbourhoods, the point itself included (at least 2)
+ * \param sampleCount number of sampled points (all the points for smaller clouds)
+ * \param seed seed of the random sampling
+ * \return the statistics
+ */
+CloudSpacingStats EstimatePointCloudSpacing(ccGenericPointCloud* cloud, unsigned knn = 12, unsigned sampleCount = 2000, unsigned seed = 0);
+
+//! Estimates a radius holding about knn points (several clouds), sampling based
+/*! median distance to the farthest of the knn nearest points (see EstimatePointCloudSpacing),
+ *  smallest value among the clouds. Default radius of computeCurvature, computeLocalDensity and computeNormals.
+ * \param list of clouds
+ * \param knn number of points wanted within the radius
+ * \param sampleCount number of sampled points per cloud
+ * \return radius, -1 if no cloud could be sampled
+ */
+double EstimatePointCloudRadius(std::vector<ccHObject*> clouds, unsigned knn = 12, unsigned sampleCount = 2000);
+
 //! copied from ccRegistrationTools::ICP
 bool ICP(
     ccHObject* data,
@@ -227,6 +392,57 @@ bool computeNormals(std::vector<ccHObject*> selectedEntities,
     int mstNeighbors = 6,
     bool computePerVertexNormals = true);
 
+//! Updates the normals of a cloud after points were appended (see ccPointCloud::operator+=)
+/*! Only the new points and the former points within radius of them are computed (LS model),
+ *  the other points keep their normal. The former points keep their orientation, which is propagated
+ *  to the new points from neighbour to neighbour. Without former normals, all the points are computed.
+ * \param cloud
+ * \param firstNewPoint index of the first appended point (size of the cloud before the append)
+ * \param radius neighbourhood radius, 0: radius of the former computation (cloud metadata), or else estimated
+ * \return success
+ */
+bool updateNormalsAfterAppend(ccPointCloud* cloud, unsigned firstNewPoint, PointCoordinateType radius = 0);
+
+//! Orients the normals of a cloud with a minimum spanning tree built in parallel
+/*! Same principle as ccPointCloud::orientNormalsWithMST: the normals are propagated along the minimum spanning tree
+ *  of the k nearest neighbours graph, weighted by 1 - |Ni.Nj|. The graph and the tree (Borůvka) are built on all the threads.
+ *  The normal of the first point of each connected component is kept.
+ * \param cloud with normals
+ * \param knn number of neighbours of each point in the graph
+ * \return success
+ */
+bool orientNormalsWithParallelMST(ccPointCloud* cloud, unsigned knn = 6);
+
+//! Adds a scan grid to a cloud, from the row and column of each point
+/*! The grid allows the computation of the normals with the grid structure (see computeNormals),
+ *  for organized clouds whose loader did not build a grid. The first point of a cell is kept.
+ * \param cloud
+ * \param rows row index of each point (negative: the point is not in the grid)
+ * \param cols column index of each point (negative: the point is not in the grid)
+ * \param count number of indexes, must be the cloud size
+ * \param sensorCenter position of the sensor, in the cloud coordinates
+ * \param width number of columns, 0: largest column index + 1
+ * \param height number of rows, 0: largest row index + 1
+ * \return the number of points in the grid
+ */
+int addScanGridFromIndices(ccPointCloud* cloud, const int* rows, const int* cols, size_t count,
+                           const CCVector3d& sensorCenter = CCVector3d(0, 0, 0), unsigned width = 0, unsigned height = 0);
+
+//! Adds a scan grid to a cloud, from the sensor angles of each point
+/*! The angles are binned with the angular steps of the scanner: the columns from the smallest azimuth,
+ *  the rows from the highest elevation (see addScanGridFromIndices).
+ * \param cloud
+ * \param azimuths horizontal angle of each point (continuous, without a 2pi jump)
+ * \param elevations vertical angle of each point
+ * \param count number of angles, must be the cloud size
+ * \param azimuthStep horizontal angular step of the scanner (same unit as the angles)
+ * \param elevationStep vertical angular step of the scanner
+ * \param sensorCenter position of the sensor, in the cloud coordinates
+ * \return the number of points in the grid
+ */
+int addScanGridFromAngles(ccPointCloud* cloud, const double* azimuths, const double* elevations, size_t count,
+                          double azimuthStep, double elevationStep, const CCVector3d& sensorCenter = CCVector3d(0, 0, 0));
+
 //! adapted from ccEntityAction:: invertNormals
 bool invertNormals(std::vector<ccHObject*> selectedEntities);
 
@@ -358,15 +574,28 @@ bool pyCC_ComputeGeomCharacteristic(
     ccHObject::Container& entities,
     const CCVector3* roughnessUpDir=nullptr);
 
+//! name of the scalar field produced by a geometric characteristic (empty if the sub option is not valid)
+//! with knn > 0, the neighbourhood is made of the k nearest neighbours (within the radius if > 0)
+QString pyCC_GetGeomCharacteristicSFName(
+    CCCoreLib::GeometricalAnalysisTools::GeomCharacteristic c,
+    int subOption,
+    PointCoordinateType radius,
+    unsigned knn = 0);
+
 //! copied from ccLibAlgorithms::GetDensitySFName
 QString pyCC_GetDensitySFName(
     CCCoreLib::GeometricalAnalysisTools::Density densityType,
     bool approx,
-    double densityKernelSize = 0.0);
+    double densityKernelSize = 0.0,
+    unsigned knn = 0);
 
 //! copied from ccLibAlgorithms::GetDefaultCloudKernelSize
 PointCoordinateType pyCC_GetDefaultCloudKernelSize(ccGenericPointCloud* cloud, unsigned knn = 12);
 
+//! removes the points not flagged in the keep mask (one value per point), compacting all the point attributes in place
+//! returns the number of removed points, throws std::runtime_error if the final resize fails
+unsigned pyCC_CompactCloudInPlace(ccPointCloud* cloud, const uint8_t* keep);
+
 //! adapted from CommandRasterize::process
 ccHObject* Rasterize_(
 	ccGenericPointCloud* cloud,
@@ -24,6 +24,8 @@
 #include <DgmOctree.h>
 
 #include <ReferenceCloud.h>
+#include <ScalarField.h>
+#include <GenericProgressCallback.h>
 #include <ccOctree.h>
 #include <CCGeom.h>
 #include <pybind11/detail/type_caster_base.h>
@@ -35,6 +37,9 @@
 #include <QObject>
 #include <QSharedPointer>
 
+#include <algorithm>
+#include <limits>
+
 struct PointDescriptor_persistent_py
 {
     const CCVector3 point;
@@ -255,6 +260,125 @@ unsigned DgmOctree_getCellNumber_py(CCCoreLib::DgmOctree& self, unsigned char le
     return num;
 }
 
+//! cell function for DgmOctree_getCellStatistics_py, called for each cell by executeFunctionForAllCellsAtLevel
+/*! additionalParameters:
+ *  [0] first point index of each cell (sorted, see DgmOctree::getCellIndexes)
+ *  [1] scalar field or nullptr
+ *  [2] whether the output codes are truncated or not
+ *  [3..8] output arrays: codes, positions, counts, mean, min, max
+ *  Each cell writes only in its own slot, no synchronization required.
+ */
+static bool computeCellStatisticsAtLevel(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                         void** additionalParameters,
+                                         CCCoreLib::NormalizedProgress* nProgress)
+{
+    const std::vector<unsigned>& firstIndexes = *static_cast<const std::vector<unsigned>*>(additionalParameters[0]);
+    const CCCoreLib::ScalarField* sf = static_cast<const CCCoreLib::ScalarField*>(additionalParameters[1]);
+    bool truncatedCodes = *static_cast<bool*>(additionalParameters[2]);
+    CCCoreLib::DgmOctree::CellCode* codes = static_cast<CCCoreLib::DgmOctree::CellCode*>(additionalParameters[3]);
+    int* positions = static_cast<int*>(additionalParameters[4]);
+    unsigned* counts = static_cast<unsigned*>(additionalParameters[5]);
+    double* means = static_cast<double*>(additionalParameters[6]);
+    double* mins = static_cast<double*>(additionalParameters[7]);
+    double* maxs = static_cast<double*>(additionalParameters[8]);
+
+    auto it = std::lower_bound(firstIndexes.begin(), firstIndexes.end(), cell.index);
+    if (it == firstIndexes.end() || *it != cell.index)
+        return false;
+    size_t c = static_cast<size_t>(it - firstIndexes.begin());
+
+    codes[c] = truncatedCodes ? cell.truncatedCode
+                              : (cell.truncatedCode << CCCoreLib::DgmOctree::GET_BIT_SHIFT(cell.level));
+    Tuple3i cellPos;
+    cell.parentOctree->getCellPos(cell.truncatedCode, cell.level, cellPos, true);
+    positions[3*c]   = cellPos.x;
+    positions[3*c+1] = cellPos.y;
+    positions[3*c+2] = cellPos.z;
+
+    unsigned n = cell.points->size();
+    counts[c] = n;
+
+    if (sf)
+    {
+        double sum = 0.0;
+        double vmin = std::numeric_limits<double>::quiet_NaN();
+        double vmax = std::numeric_limits<double>::quiet_NaN();
+        unsigned validCount = 0;
+        for (unsigned i = 0; i < n; ++i)
+        {
+            ScalarType v = sf->getValue(cell.points->getPointGlobalIndex(i));
+            if (!CCCoreLib::ScalarField::ValidValue(v))
+                continue;
+            if (validCount == 0)
+            {
+                vmin = vmax = v;
+            }
+            else
+            {
+                vmin = std::min<double>(vmin, v);
+                vmax = std::max<double>(vmax, v);
+            }
+            sum += v;
+            ++validCount;
+        }
+        means[c] = validCount ? sum / validCount : std::numeric_limits<double>::quiet_NaN();
+        mins[c] = vmin;
+        maxs[c] = vmax;
+    }
+
+    if (nProgress && !nProgress->steps(n))
+        return false;
+    return true;
+}
+
+py::tuple DgmOctree_getCellStatistics_py(CCCoreLib::DgmOctree& self,
+                                         unsigned char level,
+                                         CCCoreLib::ScalarField* sf = nullptr,
+                                         bool truncatedCodes = false,
+                                         bool multiThread = true,
+                                         int maxThreadCount = 0)
+{
+    std::vector<unsigned> firstIndexes;
+    if (!self.getCellIndexes(level, firstIndexes))
+        throw std::runtime_error("unable to get the octree cells (not enough memory?)");
+    if (sf && sf->size() < self.getNumberOfProjectedPoints())
+        throw std::invalid_argument("the scalar field is smaller than the octree cloud");
+
+    size_t nbCells = firstIndexes.size();
+    py::array_t<CCCoreLib::DgmOctree::CellCode> codes(nbCells);
+    py::array_t<int> positions({nbCells, static_cast<size_t>(3)});
+    py::array_t<unsigned> counts(nbCells);
+    py::array_t<double> means(sf ? nbCells : 0);
+    py::array_t<double> mins(sf ? nbCells : 0);
+    py::array_t<double> maxs(sf ? nbCells : 0);
+
+    void* additionalParameters[9] = { &firstIndexes,
+                                      sf,
+                                      &truncatedCodes,
+                                      codes.mutable_data(),
+                                      positions.mutable_data(),
+                                      counts.mutable_data(),
+                                      means.mutable_data(),
+                                      mins.mutable_data(),
+                                      maxs.mutable_data() };
+    if (nbCells > 0)
+    {
+        unsigned processed = self.executeFunctionForAllCellsAtLevel(level,
+                                                                    &computeCellStatisticsAtLevel,
+                                                                    additionalParameters,
+                                                                    multiThread,
+                                                                    nullptr,
+                                                                    "Cell statistics",
+                                                                    maxThreadCount);
+        if (processed == 0)
+            throw std::runtime_error("cell statistics computation failed");
+    }
+    CCTRACE("getCellStatistics level: " << static_cast<int>(level) << " cells: " << nbCells);
+    if (sf)
+        return py::make_tuple(codes, positions, counts, means, mins, maxs);
+    return py::make_tuple(codes, positions, counts, py::none(), py::none(), py::none());
+}
+
 Tuple3i DgmOctree_getCellPos_py(CCCoreLib::DgmOctree& self, CCCoreLib::DgmOctree::CellCode code, unsigned char level, bool isCodeTruncated)
 {
     Tuple3i cellPos;
@@ -432,6 +556,10 @@ void export_ccOctree(py::module &m0)
         .def("getCellDistanceFromBorders", &DgmOctree_getCellDistanceFromBordersN_py, DgmOctree_getCellDistanceFromBordersN_doc)
         .def("getCellIndexes", &DgmOctree_getCellIndexes_py, DgmOctree_getCellIndexes_doc)
         .def("getCellNumber", &DgmOctree_getCellNumber_py, DgmOctree_getCellNumber_doc)
+        .def("getCellStatistics", &DgmOctree_getCellStatistics_py,
+             py::arg("level"), py::arg("sf")=nullptr, py::arg("truncatedCodes")=false,
+             py::arg("multiThread")=true, py::arg("maxThreadCount")=0,
+             DgmOctree_getCellStatistics_doc)
         .def("getCellPos", &DgmOctree_getCellPos_py, DgmOctree_getCellPos_doc)
         .def("getCellSize", &DgmOctree_getCellSize_py, DgmOctree_getCellSize_doc)
         .def("getMaxFillIndexes", &DgmOctree_getMaxFillIndexes_py, DgmOctree_getMaxFillIndexes_doc)
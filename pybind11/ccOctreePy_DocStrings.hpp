@@ -297,6 +297,23 @@ Returns the number of cells for a given level of subdivision.
 :return: the number of cells at this level
 :rtype: int )";
 
+const char* DgmOctree_getCellStatistics_doc= R"(
+Returns per-cell statistics for a given level of subdivision, as Numpy arrays, computed in one (parallel) pass.
+
+Only the non empty cells are represented. All the arrays are ordered like :py:meth:`getCellCodes`.
+Optionally, the mean, min and max values of a scalar field are computed for each cell
+(NaN values are ignored, cells without valid values get NaN).
+
+:param int level: the level of subdivision
+:param ScalarField,optional sf: (default `None`) a scalar field of the cloud associated to the octree
+:param bool,optional truncatedCodes: (default `False`) indicates if the resulting codes should be truncated or not
+:param bool,optional multiThread: (default `True`) use several threads
+:param int,optional maxThreadCount: (default 0 = max) maximum number of threads to use
+
+:return: a tuple (codes, positions, counts, mean, min, max): codes, cell positions (N,3), point counts,
+         and the scalar field mean, min, max (`None` if no scalar field is given)
+:rtype: tuple )";
+
 const char* DgmOctree_getCellPos_doc= R"(
 Returns the cell position for a given level of subdivision of a cell designated by its code.
 
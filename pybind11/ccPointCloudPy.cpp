@@ -638,6 +638,32 @@ bool orientNormalsWithMST_py(ccPointCloud &self, unsigned char octreeLevel = 6)
     return self.orientNormalsWithMST(octreeLevel);
 }
 
+bool orientNormalsWithParallelMST_py(ccPointCloud &self, unsigned knn = 6)
+{
+    return orientNormalsWithParallelMST(&self, knn);
+}
+
+int addScanGridFromIndices_py(ccPointCloud &self,
+                              py::array_t<int, py::array::c_style | py::array::forcecast> rows,
+                              py::array_t<int, py::array::c_style | py::array::forcecast> cols,
+                              const CCVector3d& sensorCenter, unsigned width, unsigned height)
+{
+    if (rows.ndim() != 1 || cols.ndim() != 1 || rows.shape(0) != cols.shape(0))
+        throw std::invalid_argument("rows and cols must be 1D arrays of the same size");
+    return addScanGridFromIndices(&self, rows.data(), cols.data(), static_cast<size_t>(rows.shape(0)), sensorCenter, width, height);
+}
+
+int addScanGridFromAngles_py(ccPointCloud &self,
+                             py::array_t<double, py::array::c_style | py::array::forcecast> azimuths,
+                             py::array_t<double, py::array::c_style | py::array::forcecast> elevations,
+                             double azimuthStep, double elevationStep, const CCVector3d& sensorCenter)
+{
+    if (azimuths.ndim() != 1 || elevations.ndim() != 1 || azimuths.shape(0) != elevations.shape(0))
+        throw std::invalid_argument("azimuths and elevations must be 1D arrays of the same size");
+    return addScanGridFromAngles(&self, azimuths.data(), elevations.data(), static_cast<size_t>(azimuths.shape(0)),
+                                 azimuthStep, elevationStep, sensorCenter);
+}
+
 bool orientNormalsTowardViewPoint_py(ccPointCloud &self, const Vector3Tpl<float>& VP)
 {
     Vector3Tpl<float> ncvp = VP;
@@ -812,6 +838,14 @@ void export_ccPointCloud(py::module &m0)
         .def(py::init<QString, unsigned>(), py::arg("name")=QString(), py::arg("uniqueID")=0xFFFFFFFF,
              ccPointCloudPy_ccPointCloud_ctor_doc) // TODO optional<QString, unsigned> >())
         .def("addScalarField", addScalarFieldt, ccPointCloudPy_addScalarField_doc)
+        .def("addScanGridFromAngles", &addScanGridFromAngles_py,
+             py::arg("azimuths"), py::arg("elevations"), py::arg("azimuthStep"), py::arg("elevationStep"),
+             py::arg("sensorCenter")=CCVector3d(0,0,0),
+             ccPointCloudPy_addScanGridFromAngles_doc)
+        .def("addScanGridFromIndices", &addScanGridFromIndices_py,
+             py::arg("rows"), py::arg("cols"), py::arg("sensorCenter")=CCVector3d(0,0,0),
+             py::arg("width")=0, py::arg("height")=0,
+             ccPointCloudPy_addScanGridFromIndices_doc)
         .def("applyRigidTransformation", &ccPointCloud::applyRigidTransformation, ccPointCloudPy_applyRigidTransformation_doc)
         .def("applyRigidTransformation", &applyRigidTransformationPy, ccPointCloudPy_applyRigidTransformation_doc)
         .def("applyScalarFieldGaussianFilter", &applyScalarFieldGaussianFilter_py,
@@ -866,6 +900,7 @@ void export_ccPointCloud(py::module &m0)
         .def("getScalarFieldDic", &getScalarFieldDic_py, ccPointCloudPy_getScalarFieldDic_doc)
         .def("getScalarFieldName", &ccPointCloud::getScalarFieldName, ccPointCloudPy_getScalarFieldName_doc)
         .def("getSensors", getSensors, ccPointCloudPy_getSensors_doc)
+        .def("gridCount", &ccPointCloud::gridCount, ccPointCloudPy_gridCount_doc)
         .def("hasColors", &ccPointCloud::hasColors, ccPointCloudPy_hasColors_doc)
         .def("hasNormals", &ccPointCloud::hasNormals, ccPointCloudPy_hasNormals_doc)
         .def("hasScalarFields", &ccPointCloud::hasScalarFields, ccPointCloudPy_hasScalarFields_doc)
@@ -880,10 +915,14 @@ void export_ccPointCloud(py::module &m0)
         .def("orientNormalsWithMST", &orientNormalsWithMST_py,
              py::arg("octreeLevel")=6,
              ccPointCloudPy_orientNormalsWithMST_doc)
+        .def("orientNormalsWithParallelMST", &orientNormalsWithParallelMST_py,
+             py::arg("knn")=6,
+             ccPointCloudPy_orientNormalsWithParallelMST_doc)
         .def("orientNormalsTowardViewPoint", &orientNormalsTowardViewPoint_py,
              py::arg("VP")=CCVector3(0,0,0),
              ccPointCloudPy_orientNormalsTowardViewPoint_doc)
         .def("partialClone", &partialClone_py, ccPointCloudPy_partialClone_doc)
+        .def("removeGrids", &ccPointCloud::removeGrids, ccPointCloudPy_removeGrids_doc)
         .def("renameScalarField", &ccPointCloud::renameScalarField, ccPointCloudPy_renameScalarField_doc)
         .def("reserve", &ccPointCloud::reserve, ccPointCloudPy_reserve_doc)
         .def("resize", &ccPointCloud::resize, ccPointCloudPy_resize_doc)
@@ -56,6 +56,40 @@ Warnings:
 :rtype: int
 )";
 
+const char* ccPointCloudPy_addScanGridFromAngles_doc= R"(
+Adds a scan grid to the cloud, from the sensor angles of each point.
+
+The angles are binned with the angular steps of the scanner: the columns from the smallest azimuth,
+the rows from the highest elevation. See :py:meth:`addScanGridFromIndices`.
+
+:param ndarray azimuths: horizontal angle of each point, continuous (without a 2pi jump, see numpy.unwrap)
+:param ndarray elevations: vertical angle of each point
+:param float azimuthStep: horizontal angular step of the scanner, same unit as the angles
+:param float elevationStep: vertical angular step of the scanner
+:param tuple,optional sensorCenter: default (0,0,0), position of the sensor, in the cloud coordinates
+
+:return: the number of points in the grid
+:rtype: int
+)";
+
+const char* ccPointCloudPy_addScanGridFromIndices_doc= R"(
+Adds a scan grid to the cloud, from the row and column of each point.
+
+Organized clouds (TLS scans) loaded from formats without grid, or converted from other tools,
+can then use the grid structure in :py:func:`cloudComPy.computeNormals` (useScanGridsForComputation):
+the normals are computed from the neighbours in the grid, without octree searches.
+When several points fall in the same cell, the first one is kept.
+
+:param ndarray rows: row index of each point (int), negative if the point is not in the grid
+:param ndarray cols: column index of each point (int), negative if the point is not in the grid
+:param tuple,optional sensorCenter: default (0,0,0), position of the sensor, in the cloud coordinates
+:param int,optional width: default 0: largest column index + 1, number of columns
+:param int,optional height: default 0: largest row index + 1, number of rows
+
+:return: the number of points in the grid
+:rtype: int
+)";
+
 const char* ccPointCloudPy_applyRigidTransformation_doc= R"(
 Applies a GL transformation to the entity::
 
@@ -384,6 +418,13 @@ Returns a list of sensors if any, otherwise empty list.
 :rtype: list
 )";
 
+const char* ccPointCloudPy_gridCount_doc= R"(
+Returns the number of scan grids associated with the cloud.
+
+:return: number of scan grids
+:rtype: int
+)";
+
 const char* ccPointCloudPy_hasColors_doc= R"(
 Return whether the cloud has Colors.
 
@@ -466,6 +507,21 @@ See `Minimum spanning tree <https://en.wikipedia.org/wiki/Minimum_spanning_tree>
 :rtype: bool
 )";
 
+const char* ccPointCloudPy_orientNormalsWithParallelMST_doc= R"(
+Orient normals with a Minimum Spanning Tree built in parallel.
+
+Same principle as :py:meth:`orientNormalsWithMST`: the orientation is propagated along the minimum spanning tree
+of the graph of the knn nearest neighbours, weighted by 1 - \|Ni.Nj\|. The graph and the tree (Borůvka algorithm)
+are computed on all the threads, which is much faster on large clouds.
+The result may differ from :py:meth:`orientNormalsWithMST` on a few points, where the orientation is ambiguous.
+The normal of the first point of each connected part of the graph is kept.
+
+:param int,optional knn: number of neighbours of each point in the graph, default 6
+
+:return: success
+:rtype: bool
+)";
+
 const char* ccPointCloudPy_orientNormalsTowardViewPoint_doc= R"(
 Orient normals towards view point
 
@@ -490,6 +546,10 @@ See CClib documentation for more information about ReferenceClouds.
 :rtype: tuple
 )";
 
+const char* ccPointCloudPy_removeGrids_doc= R"(
+Removes the scan grids associated with the cloud.
+)";
+
 const char* ccPointCloudPy_renameScalarField_doc= R"(
 Rename the ScalarField if index is valid.
 
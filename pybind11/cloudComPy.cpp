@@ -895,6 +895,55 @@ bool InterpolateScalarFieldsFrom_py(ccPointCloud* destCloud,
     return ccPointCloudInterpolator::InterpolateScalarFieldsFrom(destCloud, srcCloud, sfIndexes, params, nullptr, octreeLevel);
 }
 
+bool computeCoreFeatures_py(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                            std::vector<double> radii,
+                            ccPointCloud* cloud,
+                            py::array_t<unsigned, py::array::c_style | py::array::forcecast> coreIndexes,
+                            std::vector<CurvatureType> curvatures,
+                            std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                            bool roughness,
+                            CCVector3 roughnessUpDir,
+                            bool propagate)
+{
+    if (coreIndexes.ndim() != 1)
+        throw std::invalid_argument("core point indexes must be a 1D array");
+    const unsigned* ptr = coreIndexes.data();
+    std::vector<unsigned> indexes(ptr, ptr + coreIndexes.size());
+    return computeCoreFeatures(features, radii, cloud, indexes, curvatures, densities, roughness, roughnessUpDir, propagate);
+}
+
+bool computeCoreFeaturesRef_py(std::vector<CCCoreLib::Neighbourhood::GeomFeature> features,
+                               std::vector<double> radii,
+                               ccPointCloud* cloud,
+                               CCCoreLib::ReferenceCloud* corePoints,
+                               std::vector<CurvatureType> curvatures,
+                               std::vector<CCCoreLib::GeometricalAnalysisTools::Density> densities,
+                               bool roughness,
+                               CCVector3 roughnessUpDir,
+                               bool propagate)
+{
+    if (!corePoints)
+        throw std::invalid_argument("null core points");
+    if (corePoints->getAssociatedCloud() != cloud)
+        throw std::invalid_argument("the core points must be a subset of the cloud");
+    std::vector<unsigned> indexes(corePoints->size());
+    for (unsigned i = 0; i < corePoints->size(); ++i)
+        indexes[i] = corePoints->getPointGlobalIndex(i);
+    return computeCoreFeatures(features, radii, cloud, indexes, curvatures, densities, roughness, roughnessUpDir, propagate);
+}
+
+py::tuple computeSymmetricEigen3x3_py(py::array_t<double, py::array::c_style | py::array::forcecast> matrices,
+                                      bool useJacobi)
+{
+    if (matrices.ndim() != 3 || matrices.shape(1) != 3 || matrices.shape(2) != 3)
+        throw std::invalid_argument("the matrices array must have the shape (n, 3, 3)");
+    size_t count = static_cast<size_t>(matrices.shape(0));
+    py::array_t<double> values({count, static_cast<size_t>(3)});
+    py::array_t<double> vectors({count, static_cast<size_t>(3), static_cast<size_t>(3)});
+    computeSymmetricEigen3x3(matrices.data(), count, values.mutable_data(), vectors.mutable_data(), useJacobi);
+    return py::make_tuple(values, vectors);
+}
+
 // from MainWindow::AddToRemoveList helper for MergePy
 void AddToRemoveListPy(ccHObject* toRemove, ccHObject::Container& toBeRemovedList)
 {
@@ -2801,20 +2850,78 @@ PYBIND11_MODULE(_cloudComPy, m0)
 
     m0.def("isPluginCork", &pyccPlugins::isPluginCork, cloudComPy_isPluginCork_doc);
 
-    m0.def("computeCurvature", &computeCurvature, cloudComPy_computeCurvature_doc);
+    m0.def("computeCurvature", &computeCurvature,
+           py::arg("cvt"), py::arg("radius"), py::arg("clouds"), py::arg("knn")=0,
+           cloudComPy_computeCurvature_doc);
 
-    m0.def("computeFeature", &computeFeature, cloudComPy_computeFeature_doc);
+    m0.def("computeFeature", &computeFeature,
+           py::arg("feature"), py::arg("radius"), py::arg("clouds"), py::arg("knn")=0,
+           cloudComPy_computeFeature_doc);
 
-    m0.def("computeLocalDensity", &computeLocalDensity, cloudComPy_computeLocalDensity_doc);
+    m0.def("computeLocalDensity", &computeLocalDensity,
+           py::arg("density"), py::arg("radius"), py::arg("clouds"), py::arg("knn")=0,
+           cloudComPy_computeLocalDensity_doc);
 
     m0.def("computeApproxLocalDensity", &computeApproxLocalDensity, cloudComPy_computeApproxLocalDensity_doc);
 
     m0.def("computeRoughness", &computeRoughnessPy,
-           py::arg("radius"), py::arg("clouds"), py::arg("roughnessUpDir")=CCVector3(0,0,0),
+           py::arg("radius"), py::arg("clouds"), py::arg("roughnessUpDir")=CCVector3(0,0,0), py::arg("knn")=0,
            cloudComPy_computeRoughness_doc);
 
     m0.def("computeMomentOrder1", &computeMomentOrder1, cloudComPy_computeMomentOrder1_doc);
 
+    m0.def("computeFeatures", &computeFeatures,
+           py::arg("features"), py::arg("radius"), py::arg("clouds"),
+           py::arg("curvatures")=std::vector<CurvatureType>(),
+           py::arg("densities")=std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+           py::arg("roughness")=false, py::arg("roughnessUpDir")=CCVector3(0,0,0), py::arg("knn")=0,
+           cloudComPy_computeFeatures_doc);
+
+    m0.def("computeMultiScaleFeatures", &computeMultiScaleFeatures,
+           py::arg("features"), py::arg("radii"), py::arg("clouds"),
+           py::arg("curvatures")=std::vector<CurvatureType>(),
+           py::arg("densities")=std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+           py::arg("roughness")=false, py::arg("roughnessUpDir")=CCVector3(0,0,0),
+           cloudComPy_computeMultiScaleFeatures_doc);
+
+    m0.def("computeCoreFeatures",
+           static_cast<bool (*)(std::vector<CCCoreLib::Neighbourhood::GeomFeature>, std::vector<double>, ccPointCloud*, ccPointCloud*,
+                                std::vector<CurvatureType>, std::vector<CCCoreLib::GeometricalAnalysisTools::Density>,
+                                bool, CCVector3, bool)>(&computeCoreFeatures),
+           py::arg("features"), py::arg("radii"), py::arg("cloud"), py::arg("corePoints"),
+           py::arg("curvatures")=std::vector<CurvatureType>(),
+           py::arg("densities")=std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+           py::arg("roughness")=false, py::arg("roughnessUpDir")=CCVector3(0,0,0),
+           py::arg("propagate")=false,
+           cloudComPy_computeCoreFeatures_doc);
+
+    m0.def("computeCoreFeatures", &computeCoreFeaturesRef_py,
+           py::arg("features"), py::arg("radii"), py::arg("cloud"), py::arg("corePoints"),
+           py::arg("curvatures")=std::vector<CurvatureType>(),
+           py::arg("densities")=std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+           py::arg("roughness")=false, py::arg("roughnessUpDir")=CCVector3(0,0,0),
+           py::arg("propagate")=false,
+           cloudComPy_computeCoreFeatures_doc);
+
+    m0.def("computeCoreFeatures", &computeCoreFeatures_py,
+           py::arg("features"), py::arg("radii"), py::arg("cloud"), py::arg("corePoints"),
+           py::arg("curvatures")=std::vector<CurvatureType>(),
+           py::arg("densities")=std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+           py::arg("roughness")=false, py::arg("roughnessUpDir")=CCVector3(0,0,0),
+           py::arg("propagate")=false,
+           cloudComPy_computeCoreFeatures_doc);
+
+    m0.def("updateFeaturesAfterAppend", &updateFeaturesAfterAppend,
+           py::arg("features"), py::arg("radii"), py::arg("cloud"), py::arg("firstNewPoint"),
+           py::arg("curvatures")=std::vector<CurvatureType>(),
+           py::arg("densities")=std::vector<CCCoreLib::GeometricalAnalysisTools::Density>(),
+           py::arg("roughness")=false, py::arg("roughnessUpDir")=CCVector3(0,0,0),
+           cloudComPy_updateFeaturesAfterAppend_doc);
+
+    m0.def("computeSymmetricEigen3x3", &computeSymmetricEigen3x3_py,
+           py::arg("matrices"), py::arg("useJacobi")=false,
+           cloudComPy_computeSymmetricEigen3x3_doc);
+
     m0.def("filterBySFValue", static_cast<ccPointCloud* (*)(double, double, ccPointCloud*)>(&filterBySFValue),
            py::return_value_policy::reference, cloudComPy_filterBySFValue_doc);
 
@@ -2824,6 +2931,26 @@ PYBIND11_MODULE(_cloudComPy, m0)
     m0.def("GetPointCloudRadius", &GetPointCloudRadius,
            py::arg("clouds"), py::arg("nodes")=12, cloudComPy_GetPointCloudRadius_doc);
 
+    py::class_<CloudSpacingStats>(m0, "CloudSpacingStats", cloudComPy_CloudSpacingStats_doc)
+        .def(py::init<>(), cloudComPy_CloudSpacingStats_ctor_doc)
+        .def_readonly("knn", &CloudSpacingStats::knn)
+        .def_readonly("sampleCount", &CloudSpacingStats::sampleCount)
+        .def_readonly("nearestMedian", &CloudSpacingStats::nearestMedian)
+        .def_readonly("median", &CloudSpacingStats::median)
+        .def_readonly("p10", &CloudSpacingStats::p10)
+        .def_readonly("p25", &CloudSpacingStats::p25)
+        .def_readonly("p75", &CloudSpacingStats::p75)
+        .def_readonly("p90", &CloudSpacingStats::p90)
+        ;
+
+    m0.def("EstimatePointCloudSpacing", &EstimatePointCloudSpacing,
+           py::arg("cloud"), py::arg("knn")=12, py::arg("sampleCount")=2000, py::arg("seed")=0,
+           cloudComPy_EstimatePointCloudSpacing_doc);
+
+    m0.def("EstimatePointCloudRadius", &EstimatePointCloudRadius,
+           py::arg("clouds"), py::arg("knn")=12, py::arg("sampleCount")=2000,
+           cloudComPy_EstimatePointCloudRadius_doc);
+
     m0.def("getScalarType", &getScalarType, cloudComPy_getScalarType_doc);
 
     py::class_<ICPres>(m0, "ICPres", cloudComPy_ICPres_doc)
@@ -2890,6 +3017,10 @@ PYBIND11_MODULE(_cloudComPy, m0)
 
     m0.def("invertNormals", &invertNormals, cloudComPy_invertNormals_doc);
 
+    m0.def("updateNormalsAfterAppend", &updateNormalsAfterAppend,
+           py::arg("cloud"), py::arg("firstNewPoint"), py::arg("radius")=0.,
+           cloudComPy_updateNormalsAfterAppend_doc);
+
     m0.def("ExtractConnectedComponents", &ExtractConnectedComponents_py,
            py::arg("clouds"),
            py::arg("octreeLevel")=8,
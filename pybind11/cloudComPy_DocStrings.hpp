@@ -548,11 +548,17 @@ Compute the curvature on a list of point clouds (create a scalarField).
 The curvature at each point is estimated by best fitting a quadric around it.
 If there's not enough neighbors to compute a quadric (i.e. less than 6) an invalid scalar value (NaN) is set for this point.
 This point will appear in grey (or not at all if you uncheck the 'display NaN values in grey' option of the scalar field parameters).
+Radius neighbourhoods use CCCoreLib (one quadric per point),
+knn neighbourhoods use the single pass engine of :py:meth:`computeFeatures`.
 
 :param CurvatureType cvt: from CurvatureType.GAUSSIAN_CURV, CurvatureType.MEAN_CURV, CurvatureType.NORMAL_CHANGE_RATE.
-:param float radius: try value obtained by :py:meth:`GetPointCloudRadius`.
+:param float radius: try value obtained by :py:meth:`GetPointCloudRadius`, 0: estimated by :py:meth:`EstimatePointCloudRadius`
+  on the clouds of the list (False is returned when no radius can be estimated).
 :param clouds: list of clouds
 :type clouds: list of :py:class:`ccHObject`
+:param int,optional knn: default 0, when not null, the neighbourhood is made of the knn nearest neighbours
+  instead of the sphere of the given radius. With a radius > 0, the neighbours are limited to the radius
+  (hybrid mode), with a radius of 0 there is no distance limit. See :py:meth:`computeFeatures`.
 
 :return: True if OK, else False
 :rtype: bool)";
@@ -564,11 +570,16 @@ Geometric feature computed from eigen values/vectors.
 Most of them are defined in "Contour detection in unstructured 3D point clouds", Hackel et al, 2016.
 PCA1 and PCA2 are defined in "3D terrestrial lidar data classification of complex natural scenes
 using a multi-scale dimensionality criterion: Applications in geomorphology", Brodu and Lague, 2012.
+Radius neighbourhoods use CCCoreLib (eigen decomposition per point),
+knn neighbourhoods use the single pass engine of :py:meth:`computeFeatures`.
 
 :param GeomFeature feature: from GeomFeature enum
 :param float radius: try value obtained by :py:meth:`GetPointCloudRadius`.
 :param clouds: list of clouds
 :type clouds: list of :py:class:`ccHObject`
+:param int,optional knn: default 0, when not null, the neighbourhood is made of the knn nearest neighbours
+  instead of the sphere of the given radius. With a radius > 0, the neighbours are limited to the radius
+  (hybrid mode), with a radius of 0 there is no distance limit. See :py:meth:`computeFeatures`.
 
 :return: True if OK, else False
 :rtype: bool)";
@@ -583,9 +594,13 @@ The density output can be:
 - a volume density: number of neighbors divided by the neighborhood volume = N / (4/3.Pi.R3)
 
 :param Density density: from Density enum
-:param float radius: try value obtained by :py:meth:`GetPointCloudRadius`.
+:param float radius: try value obtained by :py:meth:`GetPointCloudRadius`, 0: estimated by :py:meth:`EstimatePointCloudRadius`
+  on the clouds of the list (False is returned when no radius can be estimated).
 :param clouds: list of clouds
 :type clouds: list of :py:class:`ccHObject`
+:param int,optional knn: default 0, when not null, the neighbourhood is made of the knn nearest neighbours
+  instead of the sphere of the given radius. With a radius > 0, the neighbours are limited to the radius
+  (hybrid mode), with a radius of 0 there is no distance limit. See :py:meth:`computeFeatures`.
 
 :return: True if OK, else False
 :rtype: bool)";
@@ -618,11 +633,16 @@ Roughness estimation is very... simple: for each point, the 'roughness' value is
 and the best fitting plane computed on its nearest neighbors.
 If there's not enough neighbors to compute a LS plane (i.e. less than 3) an invalid scalar value (NaN) is set for this point.
 This point will appear in grey (or not at all if you uncheck the 'display NaN values in grey' option in the scalar field properties).
+Radius neighbourhoods use CCCoreLib (eigen decomposition per point),
+knn neighbourhoods use the single pass engine of :py:meth:`computeFeatures`.
 
 :param float radius: try value obtained by :py:meth:`GetPointCloudRadius`.
 :param clouds: list of clouds
 :type clouds: list of :py:class:`ccHObject`
 :param vector,optional roughnessUpDir: when defined, up direction allows a signed value of the roughness (up: positive, down: negative)
+:param int,optional knn: default 0, when not null, the neighbourhood is made of the knn nearest neighbours
+  instead of the sphere of the given radius. With a radius > 0, the neighbours are limited to the radius
+  (hybrid mode), with a radius of 0 there is no distance limit. See :py:meth:`computeFeatures`.
 
 :return: True if OK, else False
 :rtype: bool)";
@@ -648,6 +668,135 @@ The computation parameters are regrouped in a text file: see the GUI to get a fi
 :rtype: ccPointCloud
 )";
 
+const char* cloudComPy_computeFeatures_doc=R"(
+Computes several geometric characteristics on a list of points clouds in a single neighbourhood pass (create scalarFields).
+
+For each point, the neighbourhood (sphere of the given radius) is extracted once and its covariance matrix
+is decomposed once: all the requested characteristics are derived from them.
+This is much faster than successive calls to :py:meth:`computeFeature`, :py:meth:`computeCurvature`,
+:py:meth:`computeLocalDensity` and :py:meth:`computeRoughness` with the same radius,
+and produces the same scalar fields (same names and definitions).
+
+:param features: list of features to compute
+:type features: list of :py:class:`GeomFeature`
+:param float radius: try value obtained by :py:meth:`GetPointCloudRadius`.
+:param clouds: list of clouds
+:type clouds: list of :py:class:`ccHObject`
+:param curvatures: optional, default empty, list of curvatures to compute
+:type curvatures: list of :py:class:`CurvatureType`
+:param densities: optional, default empty, list of local densities to compute (precise mode)
+:type densities: list of :py:class:`Density`
+:param bool,optional roughness: default False, compute the roughness
+:param vector,optional roughnessUpDir: when defined, up direction allows a signed value of the roughness (up: positive, down: negative)
+:param int,optional knn: default 0, when not null, the neighbourhood of each point is made of its knn nearest neighbours
+  (the point itself included) instead of the sphere of the given radius. With a radius > 0, the neighbours are also limited
+  to the radius (hybrid mode: at most knn neighbours within the radius), with a radius of 0 there is no distance limit.
+  The densities then use the distance to the farthest neighbour as neighbourhood radius,
+  and the scalar field names get a " (k=...)" suffix, for instance "Planarity (k=12)" or "Planarity (0.05, k=12)".
+
+:return: True if OK, else False
+:rtype: bool)";
+
+const char* cloudComPy_computeMultiScaleFeatures_doc=R"(
+Computes several geometric characteristics at several scales on a list of points clouds in a single neighbourhood pass
+(create scalarFields).
+
+For each point, the neighbourhood of the largest radius is extracted once and sorted by distance:
+the neighbourhoods of the smaller radii are nested in it, their covariance matrices are accumulated incrementally.
+One scalar field is produced per characteristic and per radius, with the same names and definitions
+as :py:meth:`computeFeatures` (the radius is part of the name).
+
+:param features: list of features to compute
+:type features: list of :py:class:`GeomFeature`
+:param radii: list of radii (scales)
+:type radii: list of float
+:param clouds: list of clouds
+:type clouds: list of :py:class:`ccHObject`
+:param curvatures: optional, default empty, list of curvatures to compute
+:type curvatures: list of :py:class:`CurvatureType`
+:param densities: optional, default empty, list of local densities to compute (precise mode)
+:type densities: list of :py:class:`Density`
+:param bool,optional roughness: default False, compute the roughness
+:param vector,optional roughnessUpDir: when defined, up direction allows a signed value of the roughness (up: positive, down: negative)
+
+:return: True if OK, else False
+:rtype: bool)";
+
+const char* cloudComPy_computeCoreFeatures_doc=R"(
+Computes geometric characteristics only at a set of core points, the neighbours being searched in the whole cloud
+(create scalarFields).
+
+As with M3C2 core points, this makes the characteristics of very dense clouds affordable:
+the cost depends on the number of core points, not on the size of the cloud.
+The characteristics, their names and their definitions are the same as with :py:meth:`computeMultiScaleFeatures`.
+
+The core points are given either:
+
+- by a :py:class:`ReferenceCloud` on the cloud, or an array of point indexes in the cloud:
+  the scalar fields are created on the cloud, the other points get NaN,
+  or the value of their nearest core point if `propagate` is True.
+- by a separate cloud: the scalar fields are created on the core cloud.
+  If `propagate` is True, the same scalar fields are also created on the cloud, with the value of the nearest core point.
+
+:param features: list of features to compute
+:type features: list of :py:class:`GeomFeature`
+:param radii: list of radii (scales)
+:type radii: list of float
+:param ccPointCloud cloud: the cloud where the neighbours are searched
+:param corePoints: the core points
+:type corePoints: :py:class:`ReferenceCloud`, numpy array of indexes, or :py:class:`ccPointCloud`
+:param curvatures: optional, default empty, list of curvatures to compute
+:type curvatures: list of :py:class:`CurvatureType`
+:param densities: optional, default empty, list of local densities to compute (precise mode)
+:type densities: list of :py:class:`Density`
+:param bool,optional roughness: default False, compute the roughness
+:param vector,optional roughnessUpDir: when defined, up direction allows a signed value of the roughness (up: positive, down: negative)
+:param bool,optional propagate: default False, give the value of the nearest core point to the other points
+
+:return: True if OK, else False
+:rtype: bool)";
+
+const char* cloudComPy_updateFeaturesAfterAppend_doc=R"(
+Updates geometric characteristics after points were appended to a cloud
+(see :py:meth:`ccPointCloud.fuse`), for continuous acquisition pipelines.
+
+Only the new points and the former points within the largest radius of them are evaluated:
+the cost depends on the size of the update, not on the size of the cloud.
+The other points keep the values of their scalar fields.
+A characteristic without scalar field yet is computed on all the points.
+The characteristics, their names and their definitions are the same as with :py:meth:`computeMultiScaleFeatures`.
+
+:param features: list of features to compute
+:type features: list of :py:class:`GeomFeature`
+:param radii: list of radii (scales)
+:type radii: list of float
+:param ccPointCloud cloud: the cloud, with the appended points
+:param int firstNewPoint: index of the first appended point (size of the cloud before the append)
+:param curvatures: optional, default empty, list of curvatures to compute
+:type curvatures: list of :py:class:`CurvatureType`
+:param densities: optional, default empty, list of local densities to compute (precise mode)
+:type densities: list of :py:class:`Density`
+:param bool,optional roughness: default False, compute the roughness
+:param vector,optional roughnessUpDir: when defined, up direction allows a signed value of the roughness (up: positive, down: negative)
+
+:return: True if OK, else False
+:rtype: bool)";
+
+const char* cloudComPy_computeSymmetricEigen3x3_doc=R"(
+Eigen decomposition of symmetric 3x3 matrices (for instance covariance matrices of neighbourhoods).
+
+By default, uses the closed-form solver of the geometric features (:py:meth:`computeFeatures` and related functions):
+non iterative, the matrices are processed by batches of 16 (scalar code, no SIMD instructions).
+The iterative Jacobi method of CCCoreLib is available for comparison.
+
+:param matrices: symmetric matrices, shape (n, 3, 3)
+:type matrices: numpy.ndarray
+:param bool,optional useJacobi: default False, use the Jacobi method of CCCoreLib instead of the closed-form solver
+
+:return: eigen values, shape (n, 3), in decreasing order, and eigen vectors, shape (n, 3, 3):
+  vectors[i, :, k] is the unit eigen vector of the eigen value values[i, k] (columns, as with numpy.linalg.eigh)
+:rtype: tuple)";
+
 const char* cloudComPy_filterBySFValue_doc= R"(
 Create a new point cloud by filtering points using the current out ScalarField (see cloud.setCurrentOutScalarField).
 Keep the points whose ScalarField value is between the min and max parameters.
@@ -679,6 +828,52 @@ Compute an estimate radius to use in computeCurvature.
 :return: estimated radius
 :rtype: float )";
 
+const char* cloudComPy_CloudSpacingStats_doc= R"(
+Local spacing of a cloud, estimated on a random sample of points. See :py:meth:`EstimatePointCloudSpacing`
+
+:ivar int knn: number of points of the neighbourhoods, the point itself included
+:ivar int sampleCount: number of sampled points, 0 if the estimation failed
+:ivar float nearestMedian: median distance to the nearest neighbour (point spacing)
+:ivar float median: median distance to the farthest of the knn nearest points
+:ivar float p10: 10th percentile of the distance to the farthest of the knn nearest points
+:ivar float p25: 25th percentile
+:ivar float p75: 75th percentile
+:ivar float p90: 90th percentile
+)";
+
+const char* cloudComPy_CloudSpacingStats_ctor_doc=R"(
+Default constructor
+)";
+
+const char* cloudComPy_EstimatePointCloudSpacing_doc= R"(
+Estimates the local spacing of a cloud with k nearest neighbours queries on a random sample of points.
+
+Only sampleCount points are queried, whatever the size of the cloud: a few milliseconds.
+The octree of the cloud is computed if needed, and kept for the following computations.
+
+:param ccGenericPointCloud cloud: the cloud
+:param int,optional knn: default 12, number of points of the neighbourhoods, the point itself included (at least 2)
+:param int,optional sampleCount: default 2000, number of sampled points (all the points for smaller clouds)
+:param int,optional seed: default 0, seed of the random sampling
+
+:return: the spacing statistics
+:rtype: :py:class:`CloudSpacingStats` )";
+
+const char* cloudComPy_EstimatePointCloudRadius_doc= R"(
+Estimates a radius holding about knn points, from a random sample of points (see :py:meth:`EstimatePointCloudSpacing`).
+
+The radius is the median distance to the farthest of the knn nearest points, the smallest value among the clouds.
+Unlike :py:meth:`GetPointCloudRadius`, based on the bounding box, it follows the actual distribution of the points.
+It is the default radius of :py:meth:`computeCurvature`, :py:meth:`computeLocalDensity` and :py:meth:`computeNormals`.
+With :py:meth:`computeCurvature` and :py:meth:`computeLocalDensity`, the entities of the list which are not clouds are skipped.
+
+:param list clouds: list of clouds(list of :py:class:`ccHObject`)
+:param int,optional knn: default 12, number of points wanted within the radius
+:param int,optional sampleCount: default 2000, number of sampled points per cloud
+
+:return: estimated radius, -1 if no cloud could be sampled
+:rtype: float )";
+
 const char* cloudComPy_getScalarType_doc= R"(
 Get the scalar type used in cloudCompare under the form defined in Numpy: 'float32' or 'float64'
 
@@ -688,11 +883,15 @@ Get the scalar type used in cloudCompare under the form defined in Numpy: 'float
 const char* cloudComPy_computeNormals_doc= R"(
 Compute normals on a list of clouds and meshes.
 
+When several clouds are given with the LS model, the normals of the clouds not using ScanGrids
+are computed concurrently: all the points of all the clouds are shared between the threads,
+which is much faster than successive calls for many small clouds (tiles, segments...).
+
 :param selectedEntities: list of entities (clouds, meshes)
 :type selectedEntities: list of :py:class:`ccHObject`
 :param LOCAL_MODEL_TYPES,optional model: default = LOCAL_MODEL_TYPES.LS (Least Square best fitting plane)
 :param bool,optional useScanGridsForComputation: default `True`, whether to use ScanGrids when available
-:param float,optional defaultRadius: default 0.0
+:param float,optional defaultRadius: default 0.0: estimated by :py:meth:`EstimatePointCloudRadius` (unless a radius is saved in the cloud metadata)
 :param float,optional minGridAngle_deg: default 1.0
 :param bool,optional orientNormals: default `True`
 :param bool,optional useScanGridsForOrientation: default `True`, when ScanGrids available
@@ -711,6 +910,22 @@ Invert normals on a list of clouds and meshes.
 :return: success
 :rtype: bool)";
 
+const char* cloudComPy_updateNormalsAfterAppend_doc= R"(
+Updates the normals of a cloud after points were appended (see :py:meth:`ccPointCloud.fuse`).
+
+Only the new points and the former points within the radius of them are computed (LS model),
+the other points keep their normal: the cost depends on the size of the update, not on the size of the cloud.
+The former points keep their orientation, which is propagated to the new points from neighbour to neighbour:
+an orientation done before (for instance with a Minimum Spanning Tree) is preserved.
+Without former normals, all the points are computed.
+
+:param ccPointCloud cloud: the cloud, with the appended points
+:param int firstNewPoint: index of the first appended point (size of the cloud before the append)
+:param float,optional radius: default 0.0: radius of the former computation (:py:func:`computeNormals`), or else estimated by :py:meth:`EstimatePointCloudRadius`
+
+:return: success
+:rtype: bool)";
+
 const char* cloudComPy_RasterizeToCloud_doc= R"(
 Compute a Raster cloud from a point cloud, given a grid step and a direction, plus an optional GeoTiff file.
 
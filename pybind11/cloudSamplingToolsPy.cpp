@@ -29,12 +29,33 @@
 #include <PointCloud.h>
 #include <DgmOctree.h>
 #include <ccScalarField.h>
+#include <ccGlobalShiftManager.h>
 #include <CloudSamplingTools.h>
 #include <GenericProgressCallback.h>
+#include <DistanceComputationTools.h>
+#include <DgmOctreeReferenceCloud.h>
+#include <Neighbourhood.h>
+#include <ParallelSort.h>
+#include <ReferenceCloud.h>
+#include "cloudSamplingToolsPy.hpp"
 #include "cloudSamplingToolsPy_DocStrings.hpp"
 
 #include "PyScalarType.h"
 #include "pyccTrace.h"
+#include "pyCC.h"
+
+#include <QScopedPointer>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
 
 ccPointCloud* resampleCloudWithOctree_py(ccPointCloud* cloud,
                                          int newNumberOfPoints,
@@ -58,6 +79,1094 @@ ccPointCloud* resampleCloudWithOctreeAtLevel_py( CCCoreLib::GenericIndexedCloudP
     return result;
 }
 
+//! cell function for sorFilterMask_py: mean distance of each point of a cell to its k nearest neighbours
+/*! additionalParameters:
+ *  [0] number of neighbours (unsigned)
+ *  [1] mean distances, one per point (float, NaN if the point has no neighbour)
+ */
+static bool computeCellMeanNeighbourDistances(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                              void** additionalParameters,
+                                              CCCoreLib::NormalizedProgress* nProgress)
+{
+    const unsigned knn = *static_cast<unsigned*>(additionalParameters[0]);
+    float* meanDistances = static_cast<float*>(additionalParameters[1]);
+
+    CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+    nNSS.level = cell.level;
+    nNSS.minNumberOfNeighbors = knn + 1; // the query point itself is one of the neighbours
+    cell.parentOctree->getCellPos(cell.truncatedCode, cell.level, nNSS.cellPos, true);
+    cell.parentOctree->computeCellCenter(nNSS.cellPos, cell.level, nNSS.cellCenter);
+
+    unsigned pointCount = cell.points->size();
+    for (unsigned i = 0; i < pointCount; ++i)
+    {
+        cell.points->getPoint(i, nNSS.queryPoint);
+        unsigned globalIndex = cell.points->getPointGlobalIndex(i);
+        unsigned neighborCount = std::min(cell.parentOctree->findNearestNeighborsStartingFromCell(nNSS), knn + 1);
+        double sumDist = 0;
+        unsigned count = 0;
+        for (unsigned j = 0; j < neighborCount; ++j)
+        {
+            if (nNSS.pointsInNeighbourhood[j].pointIndex != globalIndex)
+            {
+                sumDist += sqrt(nNSS.pointsInNeighbourhood[j].squareDistd);
+                ++count;
+            }
+        }
+        meanDistances[globalIndex] = (count != 0 ? static_cast<float>(sumDist / count)
+                                                 : std::numeric_limits<float>::quiet_NaN());
+    }
+
+    if (nProgress && !nProgress->steps(pointCount))
+        return false;
+    return true;
+}
+
+//! settings of noiseFilterMask_py, for computeCellNoiseFilter
+struct NoiseFilterSettings
+{
+    double kernelRadius = 0;
+    double nSigma = 1.0;
+    bool removeIsolatedPoints = false;
+    bool useKnn = false;
+    unsigned knn = 6;
+    bool useAbsoluteError = true;
+    double absoluteError = 0;
+};
+
+//! cell function for noiseFilterMask_py: flags the points of a cell near the local plane of their neighbours
+/*! additionalParameters:
+ *  [0] settings (NoiseFilterSettings)
+ *  [1] keep mask (uint8, one per point)
+ */
+static bool computeCellNoiseFilter(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                   void** additionalParameters,
+                                   CCCoreLib::NormalizedProgress* nProgress)
+{
+    const NoiseFilterSettings& settings = *static_cast<NoiseFilterSettings*>(additionalParameters[0]);
+    uint8_t* keep = static_cast<uint8_t*>(additionalParameters[1]);
+
+    CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+    nNSS.level = cell.level;
+    nNSS.minNumberOfNeighbors = settings.knn + 1; // the query point itself is one of the neighbours
+    if (!settings.useKnn)
+        nNSS.prepare(static_cast<PointCoordinateType>(settings.kernelRadius), cell.parentOctree->getCellSize(nNSS.level));
+    cell.parentOctree->getCellPos(cell.truncatedCode, cell.level, nNSS.cellPos, true);
+    cell.parentOctree->computeCellCenter(nNSS.cellPos, cell.level, nNSS.cellCenter);
+
+    unsigned pointCount = cell.points->size();
+    for (unsigned i = 0; i < pointCount; ++i)
+    {
+        cell.points->getPoint(i, nNSS.queryPoint);
+        unsigned globalIndex = cell.points->getPointGlobalIndex(i);
+        unsigned neighborCount = 0;
+        if (settings.useKnn)
+            neighborCount = std::min(cell.parentOctree->findNearestNeighborsStartingFromCell(nNSS), settings.knn + 1);
+        else
+            neighborCount = cell.parentOctree->findNeighborsInASphereStartingFromCell(nNSS, settings.kernelRadius, false);
+
+        uint8_t keepPoint = (settings.removeIsolatedPoints ? 0 : 1);
+        if (neighborCount > 3) // 3 points or more, other than the query point itself
+        {
+            //the query point is moved at the end of the neighbourhood, and excluded from the local plane
+            unsigned localIndex = 0;
+            while (localIndex < neighborCount && nNSS.pointsInNeighbourhood[localIndex].pointIndex != globalIndex)
+                ++localIndex;
+            if (localIndex < neighborCount)
+            {
+                std::swap(nNSS.pointsInNeighbourhood[localIndex], nNSS.pointsInNeighbourhood[neighborCount - 1]);
+                --neighborCount;
+            }
+            CCCoreLib::DgmOctreeReferenceCloud neighbours(&nNSS.pointsInNeighbourhood, neighborCount);
+            CCCoreLib::Neighbourhood Z(&neighbours);
+            const PointCoordinateType* lsPlane = Z.getLSPlane();
+            keepPoint = 0;
+            if (lsPlane)
+            {
+                double maxD = settings.absoluteError;
+                if (!settings.useAbsoluteError)
+                {
+                    double sumD = 0;
+                    double sumD2 = 0;
+                    for (unsigned j = 0; j < neighborCount; ++j)
+                    {
+                        double d = CCCoreLib::DistanceComputationTools::computePoint2PlaneDistance(neighbours.getPoint(j), lsPlane);
+                        sumD += d;
+                        sumD2 += d * d;
+                    }
+                    double stdDev = sqrt(std::abs(sumD2 * neighborCount - sumD * sumD)) / neighborCount;
+                    maxD = stdDev * settings.nSigma;
+                }
+                double d = std::abs(CCCoreLib::DistanceComputationTools::computePoint2PlaneDistance(&nNSS.queryPoint, lsPlane));
+                keepPoint = (d <= maxD ? 1 : 0);
+            }
+        }
+        keep[globalIndex] = keepPoint;
+    }
+
+    if (nProgress && !nProgress->steps(pointCount))
+        return false;
+    return true;
+}
+
+//! outputs of the filters, besides the keep mask: optional scalar field or in place compaction
+static void applyFilterKeepMask(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                                const uint8_t* keep,
+                                const char* sfName,
+                                bool exportSF,
+                                bool inPlace)
+{
+    if (!exportSF && !inPlace)
+        return;
+    ccPointCloud* pc = dynamic_cast<ccPointCloud*>(cloud);
+    if (exportSF && pc)
+    {
+        int sfIdx = pc->getScalarFieldIndexByName(sfName);
+        if (sfIdx < 0)
+            sfIdx = pc->addScalarField(sfName);
+        if (sfIdx < 0)
+            throw std::runtime_error("not enough memory for the keep mask scalar field");
+        CCCoreLib::ScalarField* sf = pc->getScalarField(sfIdx);
+        for (unsigned i = 0; i < pc->size(); ++i)
+            sf->setValue(i, keep[i]);
+        sf->computeMinAndMax();
+    }
+    if (inPlace && pc)
+    {
+        unsigned removed = pyCC_CompactCloudInPlace(pc, keep);
+        CCTRACE(sfName << ": " << removed << " points removed in place, " << pc->size() << " remaining");
+    }
+}
+
+//! the octree given, or a new one, built on the cloud
+static CCCoreLib::DgmOctree* filterOctree(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                                          CCCoreLib::DgmOctree* octree,
+                                          QScopedPointer<CCCoreLib::DgmOctree>& localOctree,
+                                          CCCoreLib::GenericProgressCallback* progressCb)
+{
+    if (octree)
+        return octree;
+    localOctree.reset(new CCCoreLib::DgmOctree(cloud));
+    if (localOctree->build(progressCb) < 1)
+        throw std::runtime_error("failed to build the octree");
+    return localOctree.data();
+}
+
+py::array_t<uint8_t> sorFilterMask_py(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                                      int knn = 6,
+                                      double nSigma = 1.0,
+                                      bool exportSF = false,
+                                      bool inPlace = false,
+                                      CCCoreLib::DgmOctree* octree = nullptr,
+                                      bool multiThread = true,
+                                      int maxThreadCount = 0,
+                                      CCCoreLib::GenericProgressCallback* progressCb = nullptr)
+{
+    if (cloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    if (knn <= 0)
+        throw std::invalid_argument("knn must be positive");
+    if ((exportSF || inPlace) && !dynamic_cast<ccPointCloud*>(cloud))
+        throw std::invalid_argument("exportSF and inPlace need a ccPointCloud");
+    if (exportSF && inPlace)
+        throw std::invalid_argument("exportSF and inPlace are exclusive");
+    const unsigned count = cloud->size();
+    py::array_t<uint8_t> mask(count);
+    uint8_t* keep = mask.mutable_data();
+    std::fill(keep, keep + count, 1);
+    if (count == 0)
+        return mask;
+
+    QScopedPointer<CCCoreLib::DgmOctree> localOctree;
+    octree = filterOctree(cloud, octree, localOctree, progressCb);
+
+    //1) mean distance of each point to its neighbours
+    std::vector<float> meanDistances;
+    try
+    {
+        meanDistances.resize(count);
+    }
+    catch (const std::bad_alloc&)
+    {
+        throw std::runtime_error("not enough memory");
+    }
+    unsigned k = static_cast<unsigned>(knn);
+    unsigned char level = octree->findBestLevelForAGivenPopulationPerCell(k);
+    void* additionalParameters[2] = { &k, meanDistances.data() };
+    if (octree->executeFunctionForAllCellsAtLevel(level,
+                                                  &computeCellMeanNeighbourDistances,
+                                                  additionalParameters,
+                                                  multiThread,
+                                                  progressCb,
+                                                  "SOR filter",
+                                                  maxThreadCount) == 0)
+        throw std::runtime_error("SOR filter: computation failed or canceled");
+
+    //2) average and standard deviation of the mean distances, then selection, by chunks of points
+    const unsigned chunkSize = 1 << 16;
+    std::vector<unsigned> chunks((count + chunkSize - 1) / chunkSize);
+    for (size_t c = 0; c < chunks.size(); ++c)
+        chunks[c] = static_cast<unsigned>(c);
+    auto forEachChunk = [&](const std::function<void(unsigned)>& func)
+    {
+        auto chunkFunc = [&](const unsigned& c) { func(c); };
+        if (multiThread && chunks.size() > 1)
+            QtConcurrent::blockingMap(chunks, chunkFunc);
+        else
+            std::for_each(chunks.begin(), chunks.end(), chunkFunc);
+    };
+    std::vector<double> sums(chunks.size(), 0), sums2(chunks.size(), 0);
+    std::vector<unsigned> counts(chunks.size(), 0);
+    forEachChunk([&](unsigned c)
+    {
+        unsigned end = std::min(count, (c + 1) * chunkSize);
+        for (unsigned i = c * chunkSize; i < end; ++i)
+        {
+            double d = meanDistances[i];
+            if (!std::isnan(d))
+            {
+                sums[c] += d;
+                sums2[c] += d * d;
+                ++counts[c];
+            }
+        }
+    });
+    double sum = 0, sum2 = 0;
+    size_t validCount = 0;
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+        sum += sums[c];
+        sum2 += sums2[c];
+        validCount += counts[c];
+    }
+    //same selection as CCCoreLib::CloudSamplingTools::sorFilter: the points without neighbour (NaN) are removed
+    double avgDist = (validCount != 0 ? sum / validCount : std::numeric_limits<double>::quiet_NaN());
+    double stdDev = (validCount != 0 ? sqrt(std::abs(sum2 / validCount - avgDist * avgDist)) : 0);
+    const float maxDist = static_cast<float>(avgDist + nSigma * stdDev);
+    forEachChunk([&](unsigned c)
+    {
+        unsigned end = std::min(count, (c + 1) * chunkSize);
+        for (unsigned i = c * chunkSize; i < end; ++i)
+            keep[i] = (meanDistances[i] <= maxDist ? 1 : 0);
+    });
+    meanDistances.clear();
+    meanDistances.shrink_to_fit();
+    localOctree.reset();
+
+    applyFilterKeepMask(cloud, keep, "SOR keep mask", exportSF, inPlace);
+    return mask;
+}
+
+py::array_t<uint8_t> noiseFilterMask_py(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                                        double kernelRadius,
+                                        double nSigma,
+                                        bool removeIsolatedPoints = false,
+                                        bool useKnn = false,
+                                        int knn = 6,
+                                        bool useAbsoluteError = true,
+                                        double absoluteError = 0,
+                                        bool exportSF = false,
+                                        bool inPlace = false,
+                                        CCCoreLib::DgmOctree* octree = nullptr,
+                                        bool multiThread = true,
+                                        int maxThreadCount = 0,
+                                        CCCoreLib::GenericProgressCallback* progressCb = nullptr)
+{
+    if (cloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    if (useKnn ? knn <= 0 : kernelRadius <= 0)
+        throw std::invalid_argument("knn or kernelRadius must be positive");
+    if ((exportSF || inPlace) && !dynamic_cast<ccPointCloud*>(cloud))
+        throw std::invalid_argument("exportSF and inPlace need a ccPointCloud");
+    if (exportSF && inPlace)
+        throw std::invalid_argument("exportSF and inPlace are exclusive");
+    const unsigned count = cloud->size();
+    py::array_t<uint8_t> mask(count);
+    uint8_t* keep = mask.mutable_data();
+    std::fill(keep, keep + count, 1);
+    if (count == 0)
+        return mask;
+
+    QScopedPointer<CCCoreLib::DgmOctree> localOctree;
+    octree = filterOctree(cloud, octree, localOctree, progressCb);
+
+    NoiseFilterSettings settings;
+    settings.kernelRadius = kernelRadius;
+    settings.nSigma = nSigma;
+    settings.removeIsolatedPoints = removeIsolatedPoints;
+    settings.useKnn = useKnn;
+    settings.knn = static_cast<unsigned>(std::max(knn, 1));
+    settings.useAbsoluteError = useAbsoluteError;
+    settings.absoluteError = absoluteError;
+    unsigned char level = useKnn ? octree->findBestLevelForAGivenPopulationPerCell(settings.knn)
+                                 : octree->findBestLevelForAGivenNeighbourhoodSizeExtraction(static_cast<PointCoordinateType>(kernelRadius));
+    void* additionalParameters[2] = { &settings, keep };
+    if (octree->executeFunctionForAllCellsAtLevel(level,
+                                                  &computeCellNoiseFilter,
+                                                  additionalParameters,
+                                                  multiThread,
+                                                  progressCb,
+                                                  "Noise filter",
+                                                  maxThreadCount) == 0)
+        throw std::runtime_error("noise filter: computation failed or canceled");
+    localOctree.reset();
+
+    applyFilterKeepMask(cloud, keep, "Noise filter keep mask", exportSF, inPlace);
+    return mask;
+}
+
+//! representative point of a voxel, for voxelGridDownsample_py
+enum VOXEL_REPRESENTATIVE
+{
+    VOXEL_CENTROID,             //!< centroid of the points of the voxel
+    VOXEL_NEAREST_TO_CENTROID   //!< point of the voxel nearest to the centroid (keeps its normal)
+};
+
+//! aggregated attributes of the voxels of a shard (voxels grouped by key hash), stored as flat arrays
+struct VoxelShard
+{
+    std::vector<unsigned> counts;
+    std::vector<double> sumXYZ;             //!< 3 per voxel
+    std::vector<double> sumRGBA;            //!< 4 per voxel, if colors are averaged
+    std::vector<double> sumSF;              //!< one per voxel and per averaged scalar field
+    std::vector<unsigned> validSF;          //!< number of valid values, one per voxel and per averaged scalar field
+    std::vector<ScalarType> maxSF;          //!< one per voxel and per max scalar field
+    std::vector<unsigned> representative;   //!< index of the point nearest to the centroid
+};
+
+ccPointCloud* voxelGridDownsample_py(ccPointCloud* cloud,
+                                     double voxelSize,
+                                     VOXEL_REPRESENTATIVE representative = VOXEL_CENTROID,
+                                     bool meanColors = true,
+                                     std::vector<int> meanSFs = std::vector<int>(),
+                                     std::vector<int> maxSFs = std::vector<int>(),
+                                     bool countSF = true,
+                                     bool multiThread = true)
+{
+    if (cloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    if (voxelSize <= 0)
+        throw std::invalid_argument("voxel size must be positive");
+    std::vector<CCCoreLib::ScalarField*> meanFields, maxFields;
+    for (int idx : meanSFs)
+    {
+        if (idx < 0 || idx >= static_cast<int>(cloud->getNumberOfScalarFields()))
+            throw std::invalid_argument("invalid scalar field index");
+        meanFields.push_back(cloud->getScalarField(idx));
+    }
+    for (int idx : maxSFs)
+    {
+        if (idx < 0 || idx >= static_cast<int>(cloud->getNumberOfScalarFields()))
+            throw std::invalid_argument("invalid scalar field index");
+        maxFields.push_back(cloud->getScalarField(idx));
+    }
+    const unsigned count = cloud->size();
+    if (count == 0)
+        throw std::invalid_argument("empty cloud");
+
+    //voxel keys: integer coordinates on 21 bits each
+    CCVector3 bbMin, bbMax;
+    cloud->getBoundingBox(bbMin, bbMax);
+    const unsigned maxDim = (1u << 21) - 1;
+    for (int d = 0; d < 3; ++d)
+        if ((bbMax.u[d] - bbMin.u[d]) / voxelSize >= maxDim)
+            throw std::invalid_argument("voxel size too small for the cloud extent");
+    auto voxelKey = [&](const CCVector3* P)
+    {
+        uint64_t i = static_cast<uint64_t>((static_cast<double>(P->x) - bbMin.x) / voxelSize);
+        uint64_t j = static_cast<uint64_t>((static_cast<double>(P->y) - bbMin.y) / voxelSize);
+        uint64_t k = static_cast<uint64_t>((static_cast<double>(P->z) - bbMin.z) / voxelSize);
+        return (i << 42) | (j << 21) | k;
+    };
+    const unsigned shardBits = 8;
+    const unsigned shardCount = 1u << shardBits;
+    auto shardOf = [&](uint64_t key) { return static_cast<unsigned>((key * 0x9E3779B97F4A7C15ULL) >> (64 - shardBits)); };
+
+    const unsigned chunkSize = 1 << 16;
+    std::vector<unsigned> chunks((count + chunkSize - 1) / chunkSize);
+    for (size_t c = 0; c < chunks.size(); ++c)
+        chunks[c] = static_cast<unsigned>(c);
+    auto forEach = [&](std::vector<unsigned>& items, const std::function<void(unsigned)>& func)
+    {
+        auto itemFunc = [&](const unsigned& c) { func(c); };
+        if (multiThread && items.size() > 1)
+            QtConcurrent::blockingMap(items, itemFunc);
+        else
+            std::for_each(items.begin(), items.end(), itemFunc);
+    };
+
+    //1) keys and shard histograms, by chunks of points
+    std::vector<uint64_t> keys;
+    std::vector<unsigned> shardOffsets; // per chunk and per shard
+    std::vector<unsigned> order;        // point indexes grouped by shard (stable)
+    try
+    {
+        keys.resize(count);
+        shardOffsets.resize(chunks.size() * shardCount, 0);
+        order.resize(count);
+    }
+    catch (const std::bad_alloc&)
+    {
+        throw std::runtime_error("not enough memory");
+    }
+    forEach(chunks, [&](unsigned c)
+    {
+        unsigned* histo = shardOffsets.data() + c * shardCount;
+        unsigned end = std::min(count, (c + 1) * chunkSize);
+        for (unsigned i = c * chunkSize; i < end; ++i)
+        {
+            keys[i] = voxelKey(cloud->getPoint(i));
+            ++histo[shardOf(keys[i])];
+        }
+    });
+
+    //2) points grouped by shard: offsets (shard major, then chunk), then parallel scatter
+    std::vector<unsigned> shardBegin(shardCount + 1, 0);
+    {
+        unsigned offset = 0;
+        for (unsigned s = 0; s < shardCount; ++s)
+        {
+            shardBegin[s] = offset;
+            for (size_t c = 0; c < chunks.size(); ++c)
+            {
+                unsigned n = shardOffsets[c * shardCount + s];
+                shardOffsets[c * shardCount + s] = offset;
+                offset += n;
+            }
+        }
+        shardBegin[shardCount] = offset;
+    }
+    forEach(chunks, [&](unsigned c)
+    {
+        unsigned* offsets = shardOffsets.data() + c * shardCount;
+        unsigned end = std::min(count, (c + 1) * chunkSize);
+        for (unsigned i = c * chunkSize; i < end; ++i)
+            order[offsets[shardOf(keys[i])]++] = i;
+    });
+    shardOffsets.clear();
+    shardOffsets.shrink_to_fit();
+
+    //3) aggregation, one hash map per shard
+    const bool averageColors = meanColors && cloud->hasColors();
+    const bool nearest = (representative == VOXEL_NEAREST_TO_CENTROID);
+    const size_t nMean = meanFields.size();
+    const size_t nMax = maxFields.size();
+    std::vector<VoxelShard> shards(shardCount);
+    std::vector<unsigned> shardIndexes(shardCount);
+    for (unsigned s = 0; s < shardCount; ++s)
+        shardIndexes[s] = s;
+    forEach(shardIndexes, [&](unsigned s)
+    {
+        VoxelShard& shard = shards[s];
+        std::unordered_map<uint64_t, unsigned> voxels;
+        std::vector<unsigned> pointVoxel(shardBegin[s + 1] - shardBegin[s]);
+        for (unsigned o = shardBegin[s]; o < shardBegin[s + 1]; ++o)
+        {
+            unsigned i = order[o];
+            auto it = voxels.emplace(keys[i], static_cast<unsigned>(shard.counts.size()));
+            unsigned v = it.first->second;
+            if (it.second)
+            {
+                shard.counts.push_back(0);
+                shard.sumXYZ.resize(shard.sumXYZ.size() + 3, 0);
+                if (averageColors)
+                    shard.sumRGBA.resize(shard.sumRGBA.size() + 4, 0);
+                shard.sumSF.resize(shard.sumSF.size() + nMean, 0);
+                shard.validSF.resize(shard.validSF.size() + nMean, 0);
+                shard.maxSF.resize(shard.maxSF.size() + nMax, CCCoreLib::NAN_VALUE);
+            }
+            pointVoxel[o - shardBegin[s]] = v;
+            ++shard.counts[v];
+            const CCVector3* P = cloud->getPoint(i);
+            for (int d = 0; d < 3; ++d)
+                shard.sumXYZ[3 * v + d] += P->u[d];
+            if (averageColors)
+            {
+                const ccColor::Rgba& col = cloud->getPointColor(i);
+                shard.sumRGBA[4 * v] += col.r;
+                shard.sumRGBA[4 * v + 1] += col.g;
+                shard.sumRGBA[4 * v + 2] += col.b;
+                shard.sumRGBA[4 * v + 3] += col.a;
+            }
+            for (size_t f = 0; f < nMean; ++f)
+            {
+                ScalarType val = meanFields[f]->getValue(i);
+                if (CCCoreLib::ScalarField::ValidValue(val))
+                {
+                    shard.sumSF[nMean * v + f] += val;
+                    ++shard.validSF[nMean * v + f];
+                }
+            }
+            for (size_t f = 0; f < nMax; ++f)
+            {
+                ScalarType val = maxFields[f]->getValue(i);
+                ScalarType& m = shard.maxSF[nMax * v + f];
+                if (CCCoreLib::ScalarField::ValidValue(val) && !(val <= m))
+                    m = val;
+            }
+        }
+        if (nearest)
+        {
+            size_t voxelCount = shard.counts.size();
+            shard.representative.resize(voxelCount, 0);
+            std::vector<double> bestSquareDist(voxelCount, std::numeric_limits<double>::max());
+            for (unsigned o = shardBegin[s]; o < shardBegin[s + 1]; ++o)
+            {
+                unsigned i = order[o];
+                unsigned v = pointVoxel[o - shardBegin[s]];
+                const CCVector3* P = cloud->getPoint(i);
+                double squareDist = 0;
+                for (int d = 0; d < 3; ++d)
+                {
+                    double delta = P->u[d] - shard.sumXYZ[3 * v + d] / shard.counts[v];
+                    squareDist += delta * delta;
+                }
+                if (squareDist < bestSquareDist[v])
+                {
+                    bestSquareDist[v] = squareDist;
+                    shard.representative[v] = i;
+                }
+            }
+        }
+    });
+    keys.clear();
+    keys.shrink_to_fit();
+    order.clear();
+    order.shrink_to_fit();
+
+    //4) output cloud, voxels ordered by shard then by first point
+    unsigned voxelCount = 0;
+    for (const VoxelShard& shard : shards)
+        voxelCount += static_cast<unsigned>(shard.counts.size());
+    QScopedPointer<ccPointCloud> result(new ccPointCloud(cloud->getName() + QString(".voxelized")));
+    const bool copyColors = !averageColors && nearest && cloud->hasColors();
+    const bool copyNormals = nearest && cloud->hasNormals();
+    if (!result->reserve(voxelCount)
+        || ((averageColors || copyColors) && !result->reserveTheRGBTable())
+        || (copyNormals && !result->reserveTheNormsTable()))
+        throw std::runtime_error("not enough memory");
+    std::vector<ccScalarField*> outFields;
+    for (CCCoreLib::ScalarField* sf : meanFields)
+        outFields.push_back(new ccScalarField(sf->getName()));
+    for (CCCoreLib::ScalarField* sf : maxFields)
+        outFields.push_back(new ccScalarField(qPrintable(QString(sf->getName()) + " (max)")));
+    if (countSF)
+        outFields.push_back(new ccScalarField("Point count"));
+    for (ccScalarField* sf : outFields)
+    {
+        if (!sf->reserveSafe(voxelCount))
+        {
+            for (ccScalarField* toRelease : outFields)
+                toRelease->release();
+            throw std::runtime_error("not enough memory");
+        }
+    }
+    for (const VoxelShard& shard : shards)
+    {
+        for (size_t v = 0; v < shard.counts.size(); ++v)
+        {
+            const unsigned n = shard.counts[v];
+            if (nearest)
+                result->addPoint(*cloud->getPoint(shard.representative[v]));
+            else
+                result->addPoint(CCVector3(static_cast<PointCoordinateType>(shard.sumXYZ[3 * v] / n),
+                                           static_cast<PointCoordinateType>(shard.sumXYZ[3 * v + 1] / n),
+                                           static_cast<PointCoordinateType>(shard.sumXYZ[3 * v + 2] / n)));
+            if (averageColors)
+                result->addColor(ccColor::Rgba(static_cast<ColorCompType>(shard.sumRGBA[4 * v] / n + 0.5),
+                                               static_cast<ColorCompType>(shard.sumRGBA[4 * v + 1] / n + 0.5),
+                                               static_cast<ColorCompType>(shard.sumRGBA[4 * v + 2] / n + 0.5),
+                                               static_cast<ColorCompType>(shard.sumRGBA[4 * v + 3] / n + 0.5)));
+            else if (copyColors)
+                result->addColor(cloud->getPointColor(shard.representative[v]));
+            if (copyNormals)
+                result->addNorm(cloud->getPointNormal(shard.representative[v]));
+            size_t f = 0;
+            for (size_t m = 0; m < nMean; ++m)
+            {
+                unsigned valid = shard.validSF[nMean * v + m];
+                outFields[f++]->addElement(valid != 0 ? static_cast<ScalarType>(shard.sumSF[nMean * v + m] / valid)
+                                                      : CCCoreLib::NAN_VALUE);
+            }
+            for (size_t m = 0; m < nMax; ++m)
+                outFields[f++]->addElement(shard.maxSF[nMax * v + m]);
+            if (countSF)
+                outFields[f++]->addElement(static_cast<ScalarType>(n));
+        }
+    }
+    for (ccScalarField* sf : outFields)
+    {
+        sf->computeMinAndMax();
+        result->addScalarField(sf);
+    }
+    if (!outFields.empty())
+        result->setCurrentDisplayedScalarField(0);
+    result->showColors(result->hasColors());
+    result->showNormals(copyNormals && cloud->normalsShown());
+    result->copyGlobalShiftAndScale(*cloud);
+    CCTRACE("voxel grid: " << count << " points, " << voxelCount << " voxels");
+    return result.take();
+}
+
+//! state of the points in greedySpatialSelection
+enum SpatialSelectionState : uint8_t { SPATIAL_UNDECIDED = 0, SPATIAL_KEPT = 1, SPATIAL_REMOVED = 2 };
+
+//! selects points such that no selected point has another selected point within its distance, in parallel
+/*! The points are binned in a grid of cells not smaller than maxDistance, and the cells are split in 8 colours.
+ *  The cells of a colour are processed in parallel (greedy selection of the points of the cell, removing
+ *  their neighbours), the colours one after the other.
+ *  pointDistance(i): distance around the point i (<= maxDistance, NaN to remove the point)
+ *  keep: 1 for the selected points, 0 for the others
+ */
+void greedySpatialSelection(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                            double maxDistance,
+                            const std::function<double(unsigned)>& pointDistance,
+                            std::vector<uint8_t>& keep,
+                            bool multiThread)
+{
+    const unsigned count = cloud->size();
+    const unsigned chunkSize = 1 << 16;
+    std::vector<unsigned> chunks((count + chunkSize - 1) / chunkSize);
+    for (size_t c = 0; c < chunks.size(); ++c)
+        chunks[c] = static_cast<unsigned>(c);
+    auto forEach = [&](std::vector<unsigned>& items, const std::function<void(unsigned)>& func)
+    {
+        auto itemFunc = [&](const unsigned& c) { func(c); };
+        if (multiThread && items.size() > 1)
+            QtConcurrent::blockingMap(items, itemFunc);
+        else
+            std::for_each(items.begin(), items.end(), itemFunc);
+    };
+
+    //the grid cells are not smaller than the largest distance: the neighbours are in the 27 adjacent cells.
+    //They are enlarged if needed, for cell coordinates on 21 bits.
+    CCVector3 bbMin, bbMax;
+    cloud->getBoundingBox(bbMin, bbMax);
+    const unsigned maxDim = (1u << 21) - 2;
+    double cellSize = maxDistance;
+    for (int d = 0; d < 3; ++d)
+        cellSize = std::max(cellSize, (static_cast<double>(bbMax.u[d]) - bbMin.u[d]) / maxDim);
+    if (!(cellSize > 0))
+        cellSize = 1.0; // all the points are at the same place
+    cellSize *= (1.0 + 1.0e-6); // margin for the rounding errors of the cell coordinates
+
+    //1) cell keys, then points sorted by cell
+    std::vector<uint64_t> keys;
+    std::vector<unsigned> order;
+    std::unique_ptr<std::atomic<uint8_t>[]> states;
+    try
+    {
+        keys.resize(count);
+        order.resize(count);
+        states.reset(new std::atomic<uint8_t>[count]);
+        keep.resize(count);
+    }
+    catch (const std::bad_alloc&)
+    {
+        throw std::runtime_error("not enough memory");
+    }
+    forEach(chunks, [&](unsigned c)
+    {
+        unsigned end = std::min(count, (c + 1) * chunkSize);
+        for (unsigned i = c * chunkSize; i < end; ++i)
+        {
+            const CCVector3* P = cloud->getPoint(i);
+            uint64_t x = static_cast<uint64_t>((static_cast<double>(P->x) - bbMin.x) / cellSize);
+            uint64_t y = static_cast<uint64_t>((static_cast<double>(P->y) - bbMin.y) / cellSize);
+            uint64_t z = static_cast<uint64_t>((static_cast<double>(P->z) - bbMin.z) / cellSize);
+            keys[i] = (x << 42) | (y << 21) | z;
+            order[i] = i;
+            states[i].store(SPATIAL_UNDECIDED, std::memory_order_relaxed);
+        }
+    });
+    ParallelSort(order.begin(), order.end(), [&](unsigned a, unsigned b)
+                 { return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); });
+
+    //2) cells, split in 8 colours (parity of the cell coordinates): the cells of a colour are 2 cells apart,
+    //   so that their 27 neighbour cells may overlap, but never contain the points of another cell of the colour
+    struct SpatialCell { uint64_t key; unsigned begin; unsigned end; };
+    std::vector<SpatialCell> cells;
+    std::unordered_map<uint64_t, unsigned> cellIndexes;
+    for (unsigned o = 0; o < count; ++o)
+    {
+        uint64_t key = keys[order[o]];
+        if (cells.empty() || cells.back().key != key)
+        {
+            cellIndexes.emplace(key, static_cast<unsigned>(cells.size()));
+            cells.push_back({ key, o, o });
+        }
+        cells.back().end = o + 1;
+    }
+    keys.clear();
+    keys.shrink_to_fit();
+    std::vector<unsigned> colours[8];
+    for (unsigned c = 0; c < cells.size(); ++c)
+    {
+        uint64_t key = cells[c].key;
+        unsigned colour = static_cast<unsigned>(((key >> 42) & 1) | (((key >> 21) & 1) << 1) | ((key & 1) << 2));
+        colours[colour].push_back(c);
+    }
+
+    //3) greedy selection in each cell, the cells of a colour in parallel, the colours one after the other.
+    //   The result does not depend on the number of threads: the points of a cell are only decided by
+    //   the previous colours and by the cell itself (the concurrent removals in the shared neighbour cells commute).
+    const uint64_t coordMask = (1ULL << 21) - 1;
+    for (std::vector<unsigned>& colourCells : colours)
+    {
+        forEach(colourCells, [&](unsigned c)
+        {
+            const SpatialCell& cell = cells[c];
+            const int64_t cx = static_cast<int64_t>((cell.key >> 42) & coordMask);
+            const int64_t cy = static_cast<int64_t>((cell.key >> 21) & coordMask);
+            const int64_t cz = static_cast<int64_t>(cell.key & coordMask);
+            std::vector<const SpatialCell*> neighbours;
+            for (int64_t x = std::max<int64_t>(0, cx - 1); x <= cx + 1; ++x)
+                for (int64_t y = std::max<int64_t>(0, cy - 1); y <= cy + 1; ++y)
+                    for (int64_t z = std::max<int64_t>(0, cz - 1); z <= cz + 1; ++z)
+                    {
+                        auto it = cellIndexes.find((static_cast<uint64_t>(x) << 42) | (static_cast<uint64_t>(y) << 21) | static_cast<uint64_t>(z));
+                        if (it != cellIndexes.end())
+                            neighbours.push_back(&cells[it->second]);
+                    }
+
+            for (unsigned o = cell.begin; o < cell.end; ++o)
+            {
+                unsigned i = order[o];
+                if (states[i].load(std::memory_order_relaxed) != SPATIAL_UNDECIDED)
+                    continue;
+                double d = pointDistance(i);
+                if (std::isnan(d))
+                {
+                    states[i].store(SPATIAL_REMOVED, std::memory_order_relaxed);
+                    continue;
+                }
+                states[i].store(SPATIAL_KEPT, std::memory_order_relaxed);
+                const double squareDist = d * d;
+                const CCVector3* P = cloud->getPoint(i);
+                for (const SpatialCell* neighbour : neighbours)
+                {
+                    for (unsigned no = neighbour->begin; no < neighbour->end; ++no)
+                    {
+                        unsigned j = order[no];
+                        if (states[j].load(std::memory_order_relaxed) == SPATIAL_UNDECIDED
+                            && (*cloud->getPoint(j) - *P).norm2d() <= squareDist)
+                            states[j].store(SPATIAL_REMOVED, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+
+    forEach(chunks, [&](unsigned c)
+    {
+        unsigned end = std::min(count, (c + 1) * chunkSize);
+        for (unsigned i = c * chunkSize; i < end; ++i)
+            keep[i] = (states[i].load(std::memory_order_relaxed) == SPATIAL_KEPT ? 1 : 0);
+    });
+    CCTRACE("greedy spatial selection: " << count << " points, " << cells.size() << " cells of size " << cellSize);
+}
+
+CCCoreLib::ReferenceCloud* resampleCloudSpatiallyParallel_py(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                                                             double minDistance,
+                                                             const CCCoreLib::CloudSamplingTools::SFModulationParams& modParams
+                                                                 = CCCoreLib::CloudSamplingTools::SFModulationParams(false),
+                                                             bool multiThread = true)
+{
+    if (cloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    const unsigned count = cloud->size();
+    if (count == 0)
+        throw std::invalid_argument("empty cloud");
+
+    //min distance of each point (modulated by the scalar field, NaN if the scalar value is not valid)
+    //a negative modulated distance is clamped to 0, as in CCCoreLib (it would act as a positive one once squared)
+    auto pointDistance = [&](unsigned i)
+    {
+        if (!modParams.enabled)
+            return minDistance;
+        ScalarType sfValue = cloud->getPointScalarValue(i);
+        if (!CCCoreLib::ScalarField::ValidValue(sfValue))
+            return std::numeric_limits<double>::quiet_NaN();
+        return std::max(0.0, modParams.a * sfValue + modParams.b);
+    };
+    double maxDistance = minDistance;
+    if (modParams.enabled)
+    {
+        maxDistance = 0;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            double d = pointDistance(i);
+            if (d > maxDistance)
+                maxDistance = d;
+        }
+    }
+    if (!(maxDistance > 0))
+        throw std::invalid_argument("the min distance must be positive");
+
+    std::vector<uint8_t> keep;
+    greedySpatialSelection(cloud, maxDistance, pointDistance, keep, multiThread);
+
+    //selection, in the order of the input points
+    QScopedPointer<CCCoreLib::ReferenceCloud> selection(new CCCoreLib::ReferenceCloud(cloud));
+    unsigned keptCount = static_cast<unsigned>(std::count(keep.begin(), keep.end(), 1));
+    if (!selection->reserve(keptCount))
+        throw std::runtime_error("not enough memory");
+    for (unsigned i = 0; i < count; ++i)
+        if (keep[i])
+            selection->addPointIndex(i);
+    CCTRACE("spatial resampling: " << keptCount << " points kept out of " << count);
+    return selection.take();
+}
+
+//! Random subsampling of a stream of chunks (clouds or coordinate arrays) with a reservoir of fixed size
+/*! Algorithm L (K.-H. Li, 1994): once the reservoir is full, the number of points to skip before
+ *  the next replacement is drawn directly, so a chunk costs O(k log(n/k)) random draws, not O(n).
+ *  The random numbers are drawn from std::mt19937_64 directly (its sequence is fully specified by the standard,
+ *  unlike the std distributions): the result depends only on the seed and on the sequence of chunks.
+ */
+class ReservoirSampler
+{
+public:
+    explicit ReservoirSampler(unsigned targetCount, uint64_t seed = 0)
+        : m_targetCount(targetCount)
+        , m_generator(seed)
+    {
+        if (targetCount == 0)
+            throw std::invalid_argument("the target count must be positive");
+    }
+
+    //! feeds the points of a cloud (coordinates, colors and scalar fields)
+    void addCloud(ccPointCloud* cloud)
+    {
+        if (cloud == nullptr)
+            throw std::invalid_argument("null cloud");
+        if (!m_shiftDefined)
+        {
+            m_globalShift = cloud->getGlobalShift();
+            m_globalScale = cloud->getGlobalScale();
+            m_shiftDefined = true;
+        }
+        else if (cloud->size() != 0 && (cloud->getGlobalShift() != m_globalShift || cloud->getGlobalScale() != m_globalScale))
+        {
+            //the points are stored in global coordinates: they are rebased on the sample shift,
+            //if their coordinates remain small enough in the sample coordinate system
+            CCVector3 bbMin, bbMax;
+            cloud->getBoundingBox(bbMin, bbMax);
+            if (   ccGlobalShiftManager::NeedShift(toSampleLocal(cloud->toGlobal3d(bbMin)))
+                || ccGlobalShiftManager::NeedShift(toSampleLocal(cloud->toGlobal3d(bbMax))))
+                throw std::invalid_argument("the cloud is too far from the first chunk for the global shift of the sample");
+            CCTRACE("reservoir sampler: cloud with another global shift or scale, rebased on the sample shift");
+        }
+        if (!m_cloudFed)
+        {
+            //the scalar fields are those of the first cloud, NaN for the points fed before by addPoints
+            m_hasColors = (m_seenCount == 0) && cloud->hasColors();
+            for (unsigned i = 0; i < cloud->getNumberOfScalarFields(); ++i)
+                m_sfNames.push_back(cloud->getScalarFieldName(i));
+            m_sfValues.assign(m_sourceIndexes.size() * m_sfNames.size(), CCCoreLib::NAN_VALUE);
+            m_sfValues.reserve(static_cast<size_t>(m_targetCount) * m_sfNames.size());
+            m_cloudFed = true;
+        }
+        m_hasColors = m_hasColors && cloud->hasColors();
+        std::vector<CCCoreLib::ScalarField*> fields;
+        for (const std::string& name : m_sfNames)
+        {
+            int idx = cloud->getScalarFieldIndexByName(name.c_str());
+            fields.push_back(idx >= 0 ? cloud->getScalarField(idx) : nullptr);
+        }
+        addChunk(cloud->size(), [&](unsigned i, size_t slot)
+        {
+            CCVector3d P = cloud->toGlobal3d(*cloud->getPoint(i));
+            m_coords[3 * slot] = P.x;
+            m_coords[3 * slot + 1] = P.y;
+            m_coords[3 * slot + 2] = P.z;
+            if (m_hasColors)
+                m_colors[slot] = cloud->getPointColor(i);
+            for (size_t f = 0; f < fields.size(); ++f)
+                m_sfValues[m_sfNames.size() * slot + f] = (fields[f] ? fields[f]->getValue(i) : CCCoreLib::NAN_VALUE);
+        });
+    }
+
+    //! feeds points given by their (global) coordinates, as a Numpy array of shape (n, 3)
+    void addPoints(py::array_t<double, py::array::c_style | py::array::forcecast> coords)
+    {
+        if (coords.ndim() != 2 || coords.shape(1) != 3)
+            throw std::invalid_argument("the coordinates array must have the shape (n, 3)");
+        const double* data = coords.data();
+        const size_t count = static_cast<size_t>(coords.shape(0));
+        if (count == 0)
+            return;
+        if (!m_shiftDefined)
+        {
+            //first chunk: shift suggested for its first point, as for a loaded cloud
+            CCVector3d P0(data[0], data[1], data[2]);
+            m_globalShift = ccGlobalShiftManager::NeedShift(P0) ? ccGlobalShiftManager::BestShift(P0) : CCVector3d(0, 0, 0);
+            m_globalScale = 1.0;
+            m_shiftDefined = true;
+        }
+        CCVector3d bbMin(data[0], data[1], data[2]);
+        CCVector3d bbMax = bbMin;
+        for (size_t i = 1; i < count; ++i)
+        {
+            for (int d = 0; d < 3; ++d)
+            {
+                bbMin.u[d] = std::min(bbMin.u[d], data[3 * i + d]);
+                bbMax.u[d] = std::max(bbMax.u[d], data[3 * i + d]);
+            }
+        }
+        if (ccGlobalShiftManager::NeedShift(toSampleLocal(bbMin)) || ccGlobalShiftManager::NeedShift(toSampleLocal(bbMax)))
+            throw std::invalid_argument("the points are too far from the first chunk for the global shift of the sample");
+        m_hasColors = false;
+        //the chunk is split in sub-chunks of at most 2^32-1 points (same result as a single chunk)
+        const size_t maxSubChunk = std::numeric_limits<unsigned>::max();
+        for (size_t begin = 0; begin < count; begin += maxSubChunk)
+        {
+            const double* subData = data + 3 * begin;
+            addChunk(static_cast<unsigned>(std::min(count - begin, maxSubChunk)), [&](unsigned i, size_t slot)
+            {
+                for (int d = 0; d < 3; ++d)
+                    m_coords[3 * slot + d] = subData[3 * static_cast<size_t>(i) + d];
+                for (size_t f = 0; f < m_sfNames.size(); ++f)
+                    m_sfValues[m_sfNames.size() * slot + f] = CCCoreLib::NAN_VALUE;
+            });
+        }
+    }
+
+    //! number of points fed so far
+    uint64_t seenCount() const { return m_seenCount; }
+
+    //! number of points in the reservoir: the target count, or all the points if less were fed
+    size_t size() const { return m_sourceIndexes.size(); }
+
+    //! indexes of the sampled points in the sequence of all the points fed
+    py::array_t<uint64_t> sourceIndexes() const
+    {
+        return py::array_t<uint64_t>(m_sourceIndexes.size(), m_sourceIndexes.data());
+    }
+
+    //! a new cloud with the sampled points, ordered by source index
+    ccPointCloud* toCloud() const
+    {
+        const size_t count = size(); // at most m_targetCount: no truncation in the unsigned casts below
+        std::vector<size_t> slots(count);
+        for (size_t s = 0; s < count; ++s)
+            slots[s] = s;
+        std::sort(slots.begin(), slots.end(), [this](size_t a, size_t b) { return m_sourceIndexes[a] < m_sourceIndexes[b]; });
+
+        QScopedPointer<ccPointCloud> cloud(new ccPointCloud("reservoir sample"));
+        if (!cloud->reserve(static_cast<unsigned>(count)) || (m_hasColors && !cloud->reserveTheRGBTable()))
+            throw std::runtime_error("not enough memory");
+        cloud->setGlobalShift(m_globalShift);
+        cloud->setGlobalScale(m_globalScale);
+        std::vector<ccScalarField*> fields;
+        for (const std::string& name : m_sfNames)
+        {
+            ccScalarField* sf = new ccScalarField(name.c_str());
+            if (!sf->reserveSafe(static_cast<unsigned>(count)))
+            {
+                sf->release();
+                for (ccScalarField* toRelease : fields)
+                    toRelease->release();
+                throw std::runtime_error("not enough memory");
+            }
+            fields.push_back(sf);
+        }
+        for (size_t slot : slots)
+        {
+            CCVector3d P(m_coords[3 * slot], m_coords[3 * slot + 1], m_coords[3 * slot + 2]);
+            cloud->addPoint(CCVector3::fromArray(toSampleLocal(P).u));
+            if (m_hasColors)
+                cloud->addColor(m_colors[slot]);
+            for (size_t f = 0; f < fields.size(); ++f)
+                fields[f]->addElement(m_sfValues[m_sfNames.size() * slot + f]);
+        }
+        for (ccScalarField* sf : fields)
+        {
+            sf->computeMinAndMax();
+            cloud->addScalarField(sf);
+        }
+        if (!fields.empty())
+            cloud->setCurrentDisplayedScalarField(0);
+        cloud->showColors(m_hasColors);
+        return cloud.take();
+    }
+
+private:
+    //! coordinates of a global point in the coordinate system of the sample
+    CCVector3d toSampleLocal(const CCVector3d& P) const
+    {
+        return (P + m_globalShift) * m_globalScale;
+    }
+
+    //! uniform value in ]0, 1[, from the 53 high bits of the generator output
+    double uniform()
+    {
+        return (static_cast<double>(m_generator() >> 11) + 0.5) * (1.0 / 9007199254740992.0); // 2^53
+    }
+
+    //! uniform slot of the reservoir (modulo bias below targetCount / 2^64, negligible)
+    size_t uniformSlot()
+    {
+        return static_cast<size_t>(m_generator() % m_targetCount);
+    }
+
+    //! number of points to skip before the next replacement (Algorithm L)
+    uint64_t drawSkip()
+    {
+        return static_cast<uint64_t>(std::floor(std::log(uniform()) / std::log(1.0 - m_W)));
+    }
+
+    //! stores the chunk points selected for the reservoir: store(chunk index, reservoir slot)
+    void addChunk(unsigned chunkSize, const std::function<void(unsigned, size_t)>& store)
+    {
+        const uint64_t chunkBegin = m_seenCount;
+        unsigned i = 0;
+        //filling the reservoir
+        for (; i < chunkSize && m_sourceIndexes.size() < m_targetCount; ++i)
+        {
+            size_t slot = m_sourceIndexes.size();
+            m_sourceIndexes.push_back(chunkBegin + i);
+            m_coords.resize(3 * (slot + 1));
+            if (m_hasColors)
+                m_colors.resize(slot + 1);
+            m_sfValues.resize(m_sfNames.size() * (slot + 1));
+            store(i, slot);
+            if (m_sourceIndexes.size() == m_targetCount)
+            {
+                m_W = std::exp(std::log(uniform()) / m_targetCount);
+                m_next = chunkBegin + i + 1 + drawSkip();
+            }
+        }
+        //replacements
+        const uint64_t chunkEnd = chunkBegin + chunkSize;
+        while (m_sourceIndexes.size() == m_targetCount && m_next < chunkEnd)
+        {
+            size_t slot = uniformSlot();
+            m_sourceIndexes[slot] = m_next;
+            store(static_cast<unsigned>(m_next - chunkBegin), slot);
+            m_W *= std::exp(std::log(uniform()) / m_targetCount);
+            m_next += 1 + drawSkip();
+        }
+        m_seenCount = chunkEnd;
+    }
+
+    unsigned m_targetCount;
+    std::mt19937_64 m_generator;
+    uint64_t m_seenCount = 0;
+    double m_W = 0;
+    uint64_t m_next = 0;                  //!< index of the next point to put in the full reservoir
+    std::vector<uint64_t> m_sourceIndexes; //!< one per slot
+    std::vector<double> m_coords;         //!< global coordinates, 3 per slot
+    std::vector<ccColor::Rgba> m_colors;  //!< one per slot, if all the clouds have colors
+    std::vector<std::string> m_sfNames;   //!< scalar fields of the first cloud
+    std::vector<ScalarType> m_sfValues;   //!< one per slot and per scalar field
+    bool m_hasColors = false;
+    bool m_cloudFed = false;              //!< a cloud has been fed (the scalar fields are registered)
+    bool m_shiftDefined = false;          //!< the global shift and scale are those of the first chunk
+    CCVector3d m_globalShift = CCVector3d(0, 0, 0);
+    double m_globalScale = 1.0;
+};
+
 void export_cloudSamplingTools(py::module &m0)
 {
 
@@ -73,6 +1182,12 @@ void export_cloudSamplingTools(py::module &m0)
         .export_values();
         ;
 
+    py::enum_<VOXEL_REPRESENTATIVE>(m0, "VOXEL_REPRESENTATIVE")
+        .value("VOXEL_CENTROID", VOXEL_CENTROID)
+        .value("VOXEL_NEAREST_TO_CENTROID", VOXEL_NEAREST_TO_CENTROID)
+        .export_values();
+        ;
+
     py::class_<CCCoreLib::CloudSamplingTools::SFModulationParams>(m0, "SFModulationParams", CloudSamplingToolsPy_SFModulationParams_doc)
         .def(py::init<>(), CloudSamplingToolsPy_SFModulationParams_ctor_doc)
         .def_readwrite("enabled", &CCCoreLib::CloudSamplingTools::SFModulationParams::enabled,
@@ -83,6 +1198,20 @@ void export_cloudSamplingTools(py::module &m0)
                        CloudSamplingToolsPy_b_doc)
         ;
 
+    py::class_<ReservoirSampler>(m0, "ReservoirSampler", CloudSamplingToolsPy_ReservoirSampler_doc)
+        .def(py::init<unsigned, uint64_t>(), py::arg("targetCount"), py::arg("seed")=0,
+             CloudSamplingToolsPy_ReservoirSampler_ctor_doc)
+        .def("addCloud", &ReservoirSampler::addCloud, py::arg("cloud"),
+             CloudSamplingToolsPy_ReservoirSampler_addCloud_doc)
+        .def("addPoints", &ReservoirSampler::addPoints, py::arg("coords"),
+             CloudSamplingToolsPy_ReservoirSampler_addPoints_doc)
+        .def("seenCount", &ReservoirSampler::seenCount, CloudSamplingToolsPy_ReservoirSampler_seenCount_doc)
+        .def("size", &ReservoirSampler::size, CloudSamplingToolsPy_ReservoirSampler_size_doc)
+        .def("sourceIndexes", &ReservoirSampler::sourceIndexes, CloudSamplingToolsPy_ReservoirSampler_sourceIndexes_doc)
+        .def("toCloud", &ReservoirSampler::toCloud, CloudSamplingToolsPy_ReservoirSampler_toCloud_doc,
+             py::return_value_policy::reference)
+        ;
+
      py::class_<CCCoreLib::CloudSamplingTools>(m0, "CloudSamplingTools",
                                                CloudSamplingToolsPy_CloudSamplingTools_doc)
         .def_static("resampleCloudWithOctreeAtLevel",
@@ -126,6 +1255,13 @@ void export_cloudSamplingTools(py::module &m0)
              py::arg("progressCb")=nullptr,
              CloudSamplingToolsPy_resampleCloudSpatially_doc, py::return_value_policy::reference)
 
+        .def_static("resampleCloudSpatiallyParallel",
+             &resampleCloudSpatiallyParallel_py,
+             py::arg("cloud"), py::arg("minDistance"),
+             py::arg("modParams")=CCCoreLib::CloudSamplingTools::SFModulationParams(false),
+             py::arg("multiThread")=true,
+             CloudSamplingToolsPy_resampleCloudSpatiallyParallel_doc, py::return_value_policy::reference)
+
         .def_static("sorFilter",
              &CCCoreLib::CloudSamplingTools::sorFilter,
              py::arg("cloud"), py::arg("knn")=6, py::arg("nSigma")=1.0,
@@ -141,5 +1277,35 @@ void export_cloudSamplingTools(py::module &m0)
              py::arg("octree")=nullptr,
              py::arg("progressCb")=nullptr,
              CloudSamplingToolsPy_noiseFilter_doc, py::return_value_policy::reference)
+
+        .def_static("voxelGridDownsample",
+             &voxelGridDownsample_py,
+             py::arg("cloud"), py::arg("voxelSize"),
+             py::arg("representative")=VOXEL_CENTROID,
+             py::arg("meanColors")=true,
+             py::arg("meanSFs")=std::vector<int>(), py::arg("maxSFs")=std::vector<int>(),
+             py::arg("countSF")=true,
+             py::arg("multiThread")=true,
+             CloudSamplingToolsPy_voxelGridDownsample_doc, py::return_value_policy::reference)
+
+        .def_static("sorFilterMask",
+             &sorFilterMask_py,
+             py::arg("cloud"), py::arg("knn")=6, py::arg("nSigma")=1.0,
+             py::arg("exportSF")=false, py::arg("inPlace")=false,
+             py::arg("octree")=nullptr,
+             py::arg("multiThread")=true, py::arg("maxThreadCount")=0,
+             py::arg("progressCb")=nullptr,
+             CloudSamplingToolsPy_sorFilterMask_doc)
+
+        .def_static("noiseFilterMask",
+             &noiseFilterMask_py,
+             py::arg("cloud"), py::arg("kernelRadius"), py::arg("nSigma"),
+             py::arg("removeIsolatedPoints")=false, py::arg("useKnn")=false,
+             py::arg("knn")=6, py::arg("useAbsoluteError")=true, py::arg("absoluteError")=0,
+             py::arg("exportSF")=false, py::arg("inPlace")=false,
+             py::arg("octree")=nullptr,
+             py::arg("multiThread")=true, py::arg("maxThreadCount")=0,
+             py::arg("progressCb")=nullptr,
+             CloudSamplingToolsPy_noiseFilterMask_doc)
         ;
 }
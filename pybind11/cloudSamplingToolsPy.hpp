@@ -22,6 +22,20 @@
 #ifndef CLOUDSAMPLINGTOOLSPY_HPP_
 #define CLOUDSAMPLINGTOOLSPY_HPP_
 
+#include <GenericIndexedCloudPersist.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
 void export_cloudSamplingTools();
 
+//! selects points such that no selected point has another selected point within its distance, in parallel
+//! (defined in cloudSamplingToolsPy.cpp, see resampleCloudSpatiallyParallel)
+void greedySpatialSelection(CCCoreLib::GenericIndexedCloudPersist* cloud,
+                            double maxDistance,
+                            const std::function<double(unsigned)>& pointDistance,
+                            std::vector<uint8_t>& keep,
+                            bool multiThread);
+
 #endif
@@ -164,6 +164,28 @@ and repeating these two steps until the result is reached
 :rtype: ReferenceCloud
 )";
 
+const char* CloudSamplingToolsPy_resampleCloudSpatiallyParallel_doc= R"(
+Resamples a point cloud (process based on inter point distance), in parallel
+
+Same spacing guarantee as :py:meth:`resampleCloudSpatially`: there is no point nearer than the min distance
+to another point of the result (with the modulation, the min distance of the point kept first).
+The points are binned in a grid of cells not smaller than the min distance, and the cells are split in 8 colours
+(parity of the cell coordinates). The cells of a colour are processed in parallel (greedy selection
+of the points of the cell, removing their neighbours), the colours one after the other.
+The result is deterministic: it does not depend on the number of threads.
+As the points are not processed in the same order, the selection is not the same as with :py:meth:`resampleCloudSpatially`.
+
+:param GenericIndexedCloudPersist cloud: the point cloud to resample
+:param float minDistance: the distance under which a point in the resulting cloud cannot have any neighbour
+       (not used if the modulation is enabled)
+:param SFModulationParams modParams: parameters of the subsampling behavior modulation with a scalar field (optional):
+       min distance = max(0, a * scalar value + b), the points without a valid scalar value are removed
+:param bool,optional multiThread: default True, use several threads
+
+:return: a reference cloud corresponding to the resampling 'selection'
+:rtype: ReferenceCloud
+)";
+
 const char* CloudSamplingToolsPy_sorFilter_doc= R"(
 Statistical Outliers Removal (SOR) filter
 
@@ -207,4 +229,167 @@ This filter removes points based on their distance relatively to the best fit pl
 :rtype: ReferenceCloud
 )";
 
+const char* CloudSamplingToolsPy_voxelGridDownsample_doc= R"(
+Voxel grid downsampling, with an arbitrary voxel size and aggregation of the point attributes per voxel
+
+The points are binned in parallel in a regular grid of cubical voxels (origin: the cloud bounding box minimum),
+using a hash of the voxel coordinates, and each non empty voxel gives one point of the output cloud:
+
+- the centroid of its points (VOXEL_CENTROID), or the point nearest to the centroid (VOXEL_NEAREST_TO_CENTROID),
+  with its normal, and its color if the colors are not averaged
+- the mean color of its points (meanColors)
+- the mean of the chosen scalar fields (same names), and the max of the chosen scalar fields ("<name> (max)")
+- the number of points of the voxel (scalar field "Point count")
+
+Unlike :py:meth:`subsampleCloudWithOctreeAtLevel`, the voxel size is not constrained to the octree cell sizes.
+The output order is deterministic.
+
+:param ccPointCloud cloud: the point cloud to downsample
+:param float voxelSize: the voxel edge length
+:param VOXEL_REPRESENTATIVE,optional representative: default VOXEL_CENTROID, the output point of each voxel
+:param bool,optional meanColors: default True, average the colors of each voxel (if the cloud has colors)
+:param list,optional meanSFs: default [], indexes of the scalar fields to average per voxel
+:param list,optional maxSFs: default [], indexes of the scalar fields to aggregate with the max per voxel
+:param bool,optional countSF: default True, add the number of points per voxel as a scalar field
+:param bool,optional multiThread: default True, use several threads
+
+:return: the downsampled cloud
+:rtype: ccPointCloud
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_doc= R"(
+Random subsampling of a stream of chunks, with an exact target count, without loading all the points
+
+The points are fed chunk by chunk (clouds loaded one after the other, tiles, or coordinate arrays
+read by any chunked reader) and a reservoir keeps a uniform random sample of fixed size of all the points fed.
+Once the reservoir is full, the number of points skipped before the next replacement is drawn directly
+(Algorithm L), so the cost of a chunk is much lower than its number of points.
+The result depends only on the seed and on the sequence of chunks: the random numbers are drawn directly
+from a Mersenne Twister (mt19937_64, the same sequence with all compilers), not from implementation-defined distributions.
+The skips use std::log and std::exp: the last bit of these functions may differ between math libraries,
+which may very rarely change a skip length.
+Only the sample is kept in memory: a chunk can be deleted once fed.
+
+Example::
+
+    sampler = cc.ReservoirSampler(100000, seed=42)
+    for f in files:
+        cloud = cc.loadPointCloud(f)
+        sampler.addCloud(cloud)
+        cc.deleteEntity(cloud)
+    sample = sampler.toCloud()
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_ctor_doc= R"(
+Creates an empty reservoir.
+
+:param int targetCount: the number of points of the sample
+:param int,optional seed: (default 0) the seed of the random generator
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_addCloud_doc= R"(
+Feeds the points of a cloud.
+
+The global coordinates, the colors and the scalar fields are kept for the sampled points.
+The scalar fields are those of the first cloud (the values are NaN for the clouds without them,
+and for the points fed before by :py:meth:`addPoints`), the colors are kept if all the chunks have colors.
+The global shift and scale of the sample are those of the first chunk: the shift and scale of the cloud
+if it is the first chunk. The points of a cloud with another global shift or scale are rebased on
+the shift of the sample, a cloud too far for this shift (coordinates that would need another shift)
+is rejected with a ValueError.
+
+:param ccPointCloud cloud: the cloud (a chunk of the stream)
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_addPoints_doc= R"(
+Feeds points given by their global coordinates (no colors, NaN for the scalar fields).
+
+If this is the first chunk, the global shift of the sample is the shift suggested for its first point
+(as for a loaded cloud, no shift for small coordinates), with a scale of 1.
+Points too far for the global shift of the sample are rejected with a ValueError.
+Arrays of 2^32 points or more are processed as successive chunks, with the same result.
+
+:param ndarray coords: the coordinates, Numpy array of shape (n, 3)
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_seenCount_doc= R"(
+Returns the number of points fed so far.
+
+:return: the number of points fed
+:rtype: int
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_size_doc= R"(
+Returns the number of points of the sample: the target count, or all the points fed if there are less.
+
+:return: the number of sampled points
+:rtype: int
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_sourceIndexes_doc= R"(
+Returns the indexes of the sampled points in the sequence of all the points fed (in the order of the reservoir).
+
+:return: the indexes, Numpy array of uint64
+:rtype: ndarray
+)";
+
+const char* CloudSamplingToolsPy_ReservoirSampler_toCloud_doc= R"(
+Creates a new cloud with the sampled points, ordered by source index.
+
+:return: the sample cloud
+:rtype: ccPointCloud
+)";
+
+const char* CloudSamplingToolsPy_sorFilterMask_doc= R"(
+Statistical Outliers Removal (SOR) filter, returning a keep mask instead of a reference cloud
+
+Same filter as :py:meth:`sorFilter`: the mean distance of each point to its knn neighbours is computed
+(octree cells processed in parallel), then the points with a mean distance above
+average + nSigma * standard deviation are removed. As in :py:meth:`sorFilter`, the points without neighbour are removed.
+The result is a Numpy array of uint8 (1 byte per point), optionally exported as a scalar field ("SOR keep mask"),
+or applied in place: the cloud is compacted (coordinates and all the point attributes),
+without a second cloud in memory (the scan grids and waveforms of the cloud, if any, are removed).
+
+:param GenericIndexedCloudPersist cloud: the point cloud to filter
+:param int,optional knn: default 6, number of neighbors
+:param float,optional nSigma: default 1.0, number of sigmas under which the points should be kept
+:param bool,optional exportSF: default False, add the keep mask as a scalar field (ccPointCloud only)
+:param bool,optional inPlace: default False, remove the filtered points from the cloud (ccPointCloud only)
+:param DgmOctree,optional octree: default None, associated octree if available
+:param bool,optional multiThread: default True, use several threads
+:param int,optional maxThreadCount: default 0 = max, maximum number of threads to use
+:param GenericProgressCallback,optional progressCb: default None, the client method for progress bar
+
+:return: the keep mask, one value per point of the input cloud: 1 if kept, 0 if removed
+:rtype: ndarray
+)";
+
+const char* CloudSamplingToolsPy_noiseFilterMask_doc= R"(
+Noise filter based on the distance to the approximate local surface, returning a keep mask instead of a reference cloud
+
+Same filter as :py:meth:`noiseFilter`, with the octree cells processed in parallel.
+The result is a Numpy array of uint8 (1 byte per point), optionally exported as a scalar field ("Noise filter keep mask"),
+or applied in place: the cloud is compacted (coordinates and all the point attributes),
+without a second cloud in memory (the scan grids and waveforms of the cloud, if any, are removed).
+
+:param GenericIndexedCloudPersist cloud: the point cloud to filter
+:param float kernelRadius: neighborhood radius
+:param float nSigma: number of sigmas under which the points should be kept
+:param bool,optional removeIsolatedPoints: default False, whether to remove isolated points
+       (i.e. with 3 points or less in the neighborhood)
+:param bool,optional useKnn: default False, whether to use a constant number of neighbors instead of a radius
+:param int,optional knn: default 6, number of neighbors (if useKnn is true)
+:param bool,optional useAbsoluteError: default True, whether to use an absolute error instead of 'n' sigmas
+:param float,optional absoluteError: default 0.0, absolute error (if useAbsoluteError is true)
+:param bool,optional exportSF: default False, add the keep mask as a scalar field (ccPointCloud only)
+:param bool,optional inPlace: default False, remove the filtered points from the cloud (ccPointCloud only)
+:param DgmOctree,optional octree: default None, associated octree if available
+:param bool,optional multiThread: default True, use several threads
+:param int,optional maxThreadCount: default 0 = max, maximum number of threads to use
+:param GenericProgressCallback,optional progressCb: default None, the client method for progress bar
+
+:return: the keep mask, one value per point of the input cloud: 1 if kept, 0 if removed
+:rtype: ndarray
+)";
+
 #endif /* CLOUDSAMPLINGTOOLSPY_DOCSTRINGS_HPP_ */
@@ -29,12 +29,23 @@
 #include <DistanceComputationTools.h>
 #include <GenericProgressCallback.h>
 #include <ccMesh.h>
+#include <ccHObjectCaster.h>
 #include <MeshSamplingTools.h>
+#include <ReferenceCloud.h>
+#include <Neighbourhood.h>
 #include "distanceComputationToolsPy_DocStrings.hpp"
 
 #include "PyScalarType.h"
 #include "pyccTrace.h"
 
+#include <QScopedPointer>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
 class PyGenericProgressCallback : public CCCoreLib::GenericProgressCallback {
 public:
     /* Trampoline (need one for each virtual function) */
@@ -90,13 +101,226 @@ public:
     }
 };
 
+//! Statistics of a distance scalar field: moments, histogram and percentiles, computed in parallel passes
+struct DistanceStatistics
+{
+    // settings
+    unsigned nbBins = 64;
+    double histoMin = 0;                //!< histogram range, automatic (min, max of the values) if histoMin == histoMax
+    double histoMax = 0;
+    std::vector<double> percentileLevels; //!< in [0, 100]
+
+    // results
+    size_t count = 0;                   //!< number of valid values
+    size_t underflow = 0;               //!< number of valid values below the histogram range
+    size_t overflow = 0;                //!< number of valid values above the histogram range
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double variance = std::numeric_limits<double>::quiet_NaN();
+    std::vector<uint64_t> histogram;
+    std::vector<double> binEdges;
+    std::vector<double> percentiles;
+};
+
+//! partial statistics of a chunk of values, merged at the end (Chan et al. for the variance)
+struct DistanceStatisticsAccumulator
+{
+    size_t count = 0;
+    size_t underflow = 0;
+    size_t overflow = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = -std::numeric_limits<double>::max();
+    double mean = 0;
+    double m2 = 0;
+    std::vector<uint64_t> histogram;
+
+    void add(double v)
+    {
+        ++count;
+        min = std::min(min, v);
+        max = std::max(max, v);
+        double delta = v - mean;
+        mean += delta / count;
+        m2 += delta * (v - mean);
+    }
+
+    //! histogram bin of a value, values out of [histoMin, histoMax] are counted apart (clamped in the range if clampToRange)
+    void addToHistogram(double v, double histoMin, double binScale, bool clampToRange)
+    {
+        double b = (v - histoMin) * binScale;
+        if (clampToRange)
+            b = std::min(std::max(b, 0.0), static_cast<double>(histogram.size()));
+        if (b < 0)
+            ++underflow;
+        else if (b > histogram.size())
+            ++overflow;
+        else
+            ++histogram[std::min(static_cast<size_t>(b), histogram.size() - 1)];
+    }
+
+    void merge(const DistanceStatisticsAccumulator& other)
+    {
+        underflow += other.underflow;
+        overflow += other.overflow;
+        for (size_t i = 0; i < histogram.size(); ++i)
+            histogram[i] += other.histogram[i];
+        if (other.count == 0)
+            return;
+        size_t n = count + other.count;
+        double delta = other.mean - mean;
+        mean += delta * other.count / n;
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / n);
+        count = n;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+//! one parallel pass over the valid values of a scalar field, with one accumulator per chunk of values
+/*! moments: count, min, max, mean and variance
+ *  nbBins > 0: histogram of nbBins bins from histoMin (binScale = nbBins / histogram range)
+ */
+static DistanceStatisticsAccumulator accumulateDistanceStatistics(const CCCoreLib::ScalarField* sf,
+                                                                  bool moments,
+                                                                  unsigned nbBins,
+                                                                  double histoMin,
+                                                                  double binScale,
+                                                                  bool clampToRange,
+                                                                  bool multiThread)
+{
+    const size_t valueCount = sf->size();
+    const size_t chunkSize = 1 << 16;
+    size_t chunkCount = (valueCount + chunkSize - 1) / chunkSize;
+    std::vector<DistanceStatisticsAccumulator> partials(chunkCount);
+    std::vector<size_t> chunks(chunkCount);
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+        chunks[c] = c;
+        partials[c].histogram.resize(nbBins, 0);
+    }
+    auto processChunk = [&](const size_t& c)
+    {
+        DistanceStatisticsAccumulator& acc = partials[c];
+        size_t end = std::min(valueCount, (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i)
+        {
+            ScalarType v = sf->getValue(i);
+            if (!CCCoreLib::ScalarField::ValidValue(v))
+                continue;
+            if (moments)
+                acc.add(v);
+            if (nbBins > 0)
+                acc.addToHistogram(v, histoMin, binScale, clampToRange);
+        }
+    };
+    if (multiThread && chunkCount > 1)
+        QtConcurrent::blockingMap(chunks, processChunk);
+    else
+        std::for_each(chunks.begin(), chunks.end(), processChunk);
+
+    DistanceStatisticsAccumulator total;
+    total.histogram.resize(nbBins, 0);
+    for (const DistanceStatisticsAccumulator& acc : partials)
+        total.merge(acc);
+    return total;
+}
+
+//! fills the statistics from a distance scalar field
+/*! With a given histogram range, moments, min, max and histogram are accumulated in a single pass.
+ *  With an automatic range, the binning is deferred to a second pass, once the min and max are known:
+ *  the histogram range comes from the accumulated min and max, not from the scalar field ones.
+ *  The scalar field itself is not modified (ScalarField::computeMinAndMax is up to the caller).
+ *  The values out of a given range are counted in underflow and overflow, so that the percentiles
+ *  are those of all the valid values. Percentiles are interpolated in the histogram bins (precision: one bin width),
+ *  and between min and histoMin (resp. histoMax and max) for the underflow (resp. overflow) values.
+ */
+static void computeDistanceStatistics(const CCCoreLib::ScalarField* sf, DistanceStatistics& stats, bool multiThread = true)
+{
+    unsigned nbBins = std::max(1u, stats.nbBins);
+    double histoMin = stats.histoMin;
+    double histoMax = stats.histoMax;
+    const bool automaticRange = (histoMax <= histoMin);
+
+    DistanceStatisticsAccumulator total;
+    if (automaticRange)
+    {
+        total = accumulateDistanceStatistics(sf, true, 0, 0, 0, false, multiThread);
+        histoMin = (total.count > 0 ? total.min : 0);
+        histoMax = (total.count > 0 ? total.max : 0);
+        double binScale = (histoMax > histoMin) ? nbBins / (histoMax - histoMin) : 0;
+        if (total.count > 0)
+            total.histogram = accumulateDistanceStatistics(sf, false, nbBins, histoMin, binScale, true, multiThread).histogram;
+        else
+            total.histogram.resize(nbBins, 0);
+    }
+    else
+    {
+        double binScale = nbBins / (histoMax - histoMin);
+        total = accumulateDistanceStatistics(sf, true, nbBins, histoMin, binScale, false, multiThread);
+    }
+
+    stats.count = total.count;
+    stats.underflow = total.underflow;
+    stats.overflow = total.overflow;
+    stats.histogram = total.histogram;
+    stats.binEdges.resize(nbBins + 1);
+    for (unsigned b = 0; b <= nbBins; ++b)
+        stats.binEdges[b] = histoMin + (histoMax - histoMin) * b / nbBins;
+    stats.percentiles.clear();
+    if (total.count == 0)
+    {
+        stats.min = stats.max = stats.mean = stats.variance = std::numeric_limits<double>::quiet_NaN();
+        stats.percentiles.resize(stats.percentileLevels.size(), std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+    stats.min = total.min;
+    stats.max = total.max;
+    stats.mean = total.mean;
+    stats.variance = total.m2 / total.count;
+
+    //percentiles of all the valid values, by linear interpolation in the cumulated histogram
+    for (double level : stats.percentileLevels)
+    {
+        double target = std::min(std::max(level, 0.0), 100.0) / 100.0 * total.count;
+        double value = total.max;
+        uint64_t cumul = total.underflow;
+        if (total.underflow > 0 && target <= cumul)
+        {
+            value = total.min + target / total.underflow * (histoMin - total.min);
+        }
+        else
+        {
+            bool found = false;
+            for (unsigned b = 0; b < nbBins; ++b)
+            {
+                if (total.histogram[b] > 0 && cumul + total.histogram[b] >= target)
+                {
+                    double frac = (target - cumul) / total.histogram[b];
+                    value = stats.binEdges[b] + frac * (stats.binEdges[b + 1] - stats.binEdges[b]);
+                    found = true;
+                    break;
+                }
+                cumul += total.histogram[b];
+            }
+            if (!found && total.overflow > 0)
+            {
+                double frac = std::min(std::max((target - cumul) / total.overflow, 0.0), 1.0);
+                value = histoMax + frac * (total.max - histoMax);
+            }
+        }
+        stats.percentiles.push_back(value);
+    }
+}
+
 std::vector<double> computeApproxCloud2CloudDistance_py(CCCoreLib::GenericIndexedCloudPersist* comparedCloud,
                                                         CCCoreLib::GenericIndexedCloudPersist* referenceCloud,
                                                         unsigned char octreeLevel = 7,
                                                         PointCoordinateType maxSearchDist = 0,
                                                         CCCoreLib::GenericProgressCallback* progressCb=nullptr,
                                                         CCCoreLib::DgmOctree* compOctree=nullptr,
-                                                        CCCoreLib::DgmOctree* refOctree=nullptr)
+                                                        CCCoreLib::DgmOctree* refOctree=nullptr,
+                                                        DistanceStatistics* stats=nullptr)
 {
     std::vector<double> result;
     ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(comparedCloud);
@@ -128,23 +352,71 @@ std::vector<double> computeApproxCloud2CloudDistance_py(CCCoreLib::GenericIndexe
     if (ret < 0)
         return result;
     CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
-    ScalarType mean;
-    ScalarType variance;
     sf->computeMinAndMax();
-    sf->computeMeanAndVariance(mean,&variance);
+    DistanceStatistics localStats;
+    if (!stats)
+        stats = &localStats;
+    computeDistanceStatistics(sf, *stats);
     result.resize(5);
-    result[0] = sf->getMin();
-    result[1] = sf->getMax();
-    result[2] = mean;
-    result[3] = variance;
-    if (!compCloud->getOctree())
-        compCloud->computeOctree();
-    result[4] = compCloud->getOctree()->getCellSize(octreeLevel)/2.0;
+    result[0] = stats->min;
+    result[1] = stats->max;
+    result[2] = stats->mean;
+    result[3] = stats->variance;
+    if (compOctree)
+    {
+        result[4] = compOctree->getCellSize(octreeLevel)/2.0;
+    }
+    else
+    {
+        if (!compCloud->getOctree())
+            compCloud->computeOctree();
+        result[4] = compCloud->getOctree()->getCellSize(octreeLevel)/2.0;
+    }
     return result;
 }
 
+static int bestOctreeLevelFromApproxDistances(const CCCoreLib::DgmOctree* compOctree,
+                                              const CCCoreLib::ScalarField* approxDistances,
+                                              CCCoreLib::GenericIndexedMesh* refMesh,
+                                              const CCCoreLib::DgmOctree* refOctree,
+                                              double maxSearchDist);
+
+//! one pass of approximate cloud to mesh distances at a given level, in the "Approx. distances" scalar field
+static int approxCloud2MeshDistanceAtLevel(ccPointCloud* compCloud,
+                                           CCCoreLib::GenericIndexedMesh* mesh,
+                                           unsigned char octreeLevel,
+                                           PointCoordinateType maxSearchDist,
+                                           bool multiThread,
+                                           int maxThreadCount,
+                                           CCCoreLib::GenericProgressCallback* progressCb,
+                                           CCCoreLib::DgmOctree* cloudOctree)
+{
+    CCCoreLib::DistanceComputationTools::Cloud2MeshDistancesComputationParams c2mParams;
+    {
+        c2mParams.octreeLevel = octreeLevel;
+        c2mParams.maxSearchDist = maxSearchDist;
+        c2mParams.useDistanceMap = true;
+        c2mParams.signedDistances = false;
+        c2mParams.flipNormals = false;
+        c2mParams.multiThread = multiThread;
+        c2mParams.maxThreadCount = maxThreadCount;
+    }
+    return CCCoreLib::DistanceComputationTools::computeCloud2MeshDistances( compCloud,
+                                                                            mesh,
+                                                                            c2mParams,
+                                                                            progressCb,
+                                                                            cloudOctree);
+}
+
 std::vector<double> computeApproxCloud2MeshDistance_py(CCCoreLib::GenericIndexedCloudPersist* cloud,
-                                                       CCCoreLib::GenericIndexedMesh* mesh)
+                                                       CCCoreLib::GenericIndexedMesh* mesh,
+                                                       unsigned char octreeLevel = 7,
+                                                       PointCoordinateType maxSearchDist = 0,
+                                                       bool multiThread = true,
+                                                       int maxThreadCount = 0,
+                                                       CCCoreLib::GenericProgressCallback* progressCb=nullptr,
+                                                       CCCoreLib::DgmOctree* cloudOctree=nullptr,
+                                                       DistanceStatistics* stats=nullptr)
 {
     std::vector<double> result;
     ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(cloud);
@@ -153,142 +425,1843 @@ std::vector<double> computeApproxCloud2MeshDistance_py(CCCoreLib::GenericIndexed
         CCTRACE("comparedCloud is not of the right type");
         return result;
     }
+    if (octreeLevel > CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL)
+    {
+        CCTRACE("invalid octree level: " << static_cast<int>(octreeLevel));
+        return result;
+    }
     //does the cloud has already a temporary scalar field that we can use?
     int sfIdx = compCloud->getScalarFieldIndexByName("Approx. distances");
     if (sfIdx < 0)
     {
-        //we need to create a new scalar field
-        sfIdx = compCloud->addScalarField("Approx. distances");
+        //we need to create a new scalar field
+        sfIdx = compCloud->addScalarField("Approx. distances");
+        if (sfIdx < 0)
+        {
+            CCTRACE("Couldn't allocate a new scalar field for computing approx. distances! Try to free some memory ...");
+            return result;
+        }
+    }
+    compCloud->setCurrentScalarField(sfIdx);
+
+    //the same octree is used for the distance computation(s) and the cell size
+    ccOctree::Shared octreeHolder;
+    CCCoreLib::DgmOctree* octree = cloudOctree;
+    if (!octree)
+    {
+        octreeHolder = compCloud->getOctree();
+        if (!octreeHolder)
+            octreeHolder = compCloud->computeOctree(progressCb);
+        octree = octreeHolder.data();
+        if (!octree)
+        {
+            CCTRACE("Couldn't compute the octree of the compared cloud");
+            return result;
+        }
+    }
+
+    //adaptive level: a first pass at the default level, then the best level for this cloud and mesh,
+    //estimated from the distances of the first pass (same octree)
+    bool adaptive = (octreeLevel == 0);
+    if (adaptive)
+        octreeLevel = 7;
+    int ret = approxCloud2MeshDistanceAtLevel(compCloud, mesh, octreeLevel, maxSearchDist,
+                                              multiThread, maxThreadCount, progressCb, octree);
+    if (ret != 1)
+        return result;
+    if (adaptive)
+    {
+        int bestLevel = bestOctreeLevelFromApproxDistances(octree, compCloud->getScalarField(sfIdx), mesh, nullptr, maxSearchDist);
+        //a coarser level would give less precise distances than the first pass: they are kept
+        if (bestLevel > octreeLevel)
+        {
+            octreeLevel = static_cast<unsigned char>(bestLevel);
+            compCloud->setCurrentScalarField(sfIdx);
+            ret = approxCloud2MeshDistanceAtLevel(compCloud, mesh, octreeLevel, maxSearchDist,
+                                                  multiThread, maxThreadCount, progressCb, octree);
+            if (ret != 1)
+                return result;
+        }
+        CCTRACE("approx. C2M distances, adaptive octree level: " << static_cast<int>(octreeLevel));
+    }
+    CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
+    sf->computeMinAndMax();
+    DistanceStatistics localStats;
+    if (!stats)
+        stats = &localStats;
+    computeDistanceStatistics(sf, *stats);
+    result.resize(5);
+    result[0] = stats->min;
+    result[1] = stats->max;
+    result[2] = stats->mean;
+    result[3] = stats->variance;
+    result[4] = octree->getCellSize(octreeLevel)/2.0;
+    return result;
+}
+
+int computeCloud2CloudDistances_py( CCCoreLib::GenericIndexedCloudPersist* comparedCloud,
+                                    CCCoreLib::GenericIndexedCloudPersist* referenceCloud,
+                                    CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams& params,
+                                    CCCoreLib::GenericProgressCallback* progressCb=nullptr,
+                                    CCCoreLib::DgmOctree* compOctree=nullptr,
+                                    CCCoreLib::DgmOctree* refOctree=nullptr)
+{
+    ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(comparedCloud);
+    if (compCloud == nullptr)
+        return CCCoreLib::DistanceComputationTools::ERROR_NULL_COMPAREDCLOUD;
+    //does the cloud has already a temporary scalar field that we can use?
+    int sfIdx = compCloud->getScalarFieldIndexByName("Temp. approx. distances");
+    if (sfIdx < 0)
+    {
+        //we need to create a new scalar field
+        sfIdx = compCloud->addScalarField("Temp. approx. distances");
+        if (sfIdx < 0)
+        {
+            CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
+            return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+        }
+    }
+    compCloud->setCurrentScalarField(sfIdx);
+    int ret = CCCoreLib::DistanceComputationTools::computeCloud2CloudDistances(compCloud, referenceCloud, params,
+                                                                               progressCb, compOctree, refOctree);
+    CCTRACE("return code computeCloud2CloudDistances: " << ret);
+    if (ret <= 0)
+        return ret;
+    CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
+    sf->computeMinAndMax();
+    QString sfName = "C2C absolute distances";
+    if (params.maxSearchDist > 0)
+    {
+        sfName += QString("[<%1]").arg(params.maxSearchDist);
+    }
+    sf->setName(qPrintable(sfName));
+    const char* sfNames[] = {qPrintable(sfName + " (X)"), qPrintable(sfName + " (Y)"), qPrintable(sfName + " (Z)")};
+    for (int i=0; i<3; i++)
+    if (ccScalarField* sfi = dynamic_cast<ccScalarField*>(params.splitDistances[i]))
+    {
+        sfi->computeMinAndMax();
+        sfi->setName(sfNames[i]);
+        int isf = compCloud->addScalarField(sfi);
+        params.splitDistances[i] = nullptr;
+    }
+    return 1;
+}
+
+//! return code of computeCloud2CloudDistancesTiled_py for invalid parameters (CCCoreLib error codes are <= -1000)
+static const int TILED_C2C_INVALID_PARAMETERS = -1;
+
+int computeCloud2CloudDistancesTiled_py(CCCoreLib::GenericIndexedCloudPersist* comparedCloud,
+                                        CCCoreLib::GenericIndexedCloudPersist* referenceCloud,
+                                        CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams& params,
+                                        PointCoordinateType tileSize,
+                                        CCCoreLib::GenericProgressCallback* progressCb=nullptr)
+{
+    ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(comparedCloud);
+    if (compCloud == nullptr)
+        return CCCoreLib::DistanceComputationTools::ERROR_NULL_COMPAREDCLOUD;
+    if (referenceCloud == nullptr)
+        return CCCoreLib::DistanceComputationTools::ERROR_NULL_REFERENCECLOUD;
+    if (params.maxSearchDist <= 0 || !(tileSize > 0))
+    {
+        CCTRACE("tiled distance computation requires a max search distance (the tile margin) and a positive tile size");
+        return TILED_C2C_INVALID_PARAMETERS;
+    }
+    if (params.localModel != CCCoreLib::NO_MODEL || params.CPSet || params.splitDistances[0])
+    {
+        CCTRACE("local models, split distances and closest point set are not available in tiled mode");
+        return TILED_C2C_INVALID_PARAMETERS;
+    }
+
+    unsigned compCount = compCloud->size();
+    unsigned refCount = referenceCloud->size();
+    if (compCount == 0)
+        return CCCoreLib::DistanceComputationTools::ERROR_EMPTY_COMPAREDCLOUD;
+
+    //tiles grid on the compared cloud bounding box (sizes computed in double: no int overflow with tiny tiles)
+    static const double s_maxTileCount = static_cast<double>(1 << 24);
+    CCVector3 bbMin, bbMax;
+    compCloud->getBoundingBox(bbMin, bbMax);
+    int gridSize[3];
+    double tileCountD = 1.0;
+    for (unsigned char d = 0; d < 3; ++d)
+    {
+        double n = std::max(1.0, std::ceil((static_cast<double>(bbMax.u[d]) - bbMin.u[d]) / tileSize));
+        tileCountD *= n;
+        if (tileCountD > s_maxTileCount)
+        {
+            CCTRACE("tile size too small: too many tiles");
+            return TILED_C2C_INVALID_PARAMETERS;
+        }
+        gridSize[d] = static_cast<int>(n);
+    }
+    const uint64_t tileCount = static_cast<uint64_t>(tileCountD);
+    const int margin = static_cast<int>(std::min<double>(std::ceil(params.maxSearchDist / tileSize), 1 << 24)); // in tiles
+
+    //the grid is processed slab by slab along its longest dimension, the two other dimensions are the slab plane
+    const unsigned char sd = static_cast<unsigned char>(gridSize[0] >= gridSize[1] ? (gridSize[0] >= gridSize[2] ? 0 : 2)
+                                                                                    : (gridSize[1] >= gridSize[2] ? 1 : 2));
+    const unsigned char pd[2] = { static_cast<unsigned char>((sd + 1) % 3), static_cast<unsigned char>((sd + 2) % 3) };
+    const size_t planeCount = static_cast<size_t>(gridSize[pd[0]]) * gridSize[pd[1]];
+
+    auto tileCoord = [&](const CCVector3* P, unsigned char d) -> int
+    {
+        double i = std::floor((static_cast<double>(P->u[d]) - bbMin.u[d]) / tileSize);
+        return static_cast<int>(std::min(std::max(i, 0.0), static_cast<double>(gridSize[d] - 1)));
+    };
+    auto planeIndex = [&](const CCVector3* P) -> size_t
+    {
+        return tileCoord(P, pd[0]) + static_cast<size_t>(gridSize[pd[0]]) * tileCoord(P, pd[1]);
+    };
+
+    const CCVector3 marginVec(params.maxSearchDist, params.maxSearchDist, params.maxSearchDist);
+    const CCVector3 refMin = bbMin - marginVec;
+    const CCVector3 refMax = bbMax + marginVec;
+
+    //both clouds are bucketed by slab once (counting sort on the slab coordinate), each slab is then
+    //processed from its buckets. The reference points out of the compared bounding box enlarged by the
+    //max search distance are dropped, the others are in the bucket of their (clamped) slab.
+    std::vector<unsigned> compSlabOffsets, compBySlab, refSlabOffsets, refBySlab;
+    try
+    {
+        compSlabOffsets.resize(static_cast<size_t>(gridSize[sd]) + 1, 0);
+        refSlabOffsets.resize(static_cast<size_t>(gridSize[sd]) + 1, 0);
+        for (unsigned i = 0; i < compCount; ++i)
+            ++compSlabOffsets[tileCoord(compCloud->getPoint(i), sd) + 1];
+        for (unsigned i = 0; i < refCount; ++i)
+        {
+            const CCVector3* P = referenceCloud->getPoint(i);
+            if (   P->x >= refMin.x && P->y >= refMin.y && P->z >= refMin.z
+                && P->x <= refMax.x && P->y <= refMax.y && P->z <= refMax.z)
+                ++refSlabOffsets[tileCoord(P, sd) + 1];
+        }
+        for (int s = 0; s < gridSize[sd]; ++s)
+        {
+            compSlabOffsets[s + 1] += compSlabOffsets[s];
+            refSlabOffsets[s + 1] += refSlabOffsets[s];
+        }
+        compBySlab.resize(compCount);
+        refBySlab.resize(refSlabOffsets.back());
+        std::vector<unsigned> fill(compSlabOffsets.begin(), compSlabOffsets.end() - 1);
+        for (unsigned i = 0; i < compCount; ++i)
+            compBySlab[fill[tileCoord(compCloud->getPoint(i), sd)]++] = i;
+        fill.assign(refSlabOffsets.begin(), refSlabOffsets.end() - 1);
+        for (unsigned i = 0; i < refCount; ++i)
+        {
+            const CCVector3* P = referenceCloud->getPoint(i);
+            if (   P->x >= refMin.x && P->y >= refMin.y && P->z >= refMin.z
+                && P->x <= refMax.x && P->y <= refMax.y && P->z <= refMax.z)
+                refBySlab[fill[tileCoord(P, sd)]++] = i;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        CCTRACE("Not enough memory to sort the points by slab");
+        return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+    }
+
+    //does the cloud has already a temporary scalar field that we can use?
+    int sfIdx = compCloud->getScalarFieldIndexByName("Temp. approx. distances");
+    if (sfIdx < 0)
+    {
+        //we need to create a new scalar field
+        sfIdx = compCloud->addScalarField("Temp. approx. distances");
+        if (sfIdx < 0)
+        {
+            CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
+            return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+        }
+    }
+    compCloud->setCurrentScalarField(sfIdx);
+    CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
+
+    CCCoreLib::NormalizedProgress nProgress(progressCb, compCount);
+    if (progressCb)
+    {
+        if (progressCb->textCanBeEdited())
+        {
+            progressCb->setMethodTitle("Tiled C2C distances");
+            progressCb->setInfo(qPrintable(QString("Tiles: %1").arg(tileCount)));
+        }
+        progressCb->update(0);
+        progressCb->start();
+    }
+
+    CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams tileParams = params;
+    tileParams.resetFormerDistances = true;
+    unsigned processedTiles = 0;
+    int ret = 1;
+    for (int s = 0; s < gridSize[sd] && ret > 0; ++s)
+    {
+        const unsigned slabCompBegin = compSlabOffsets[s];
+        const unsigned slabCompEnd = compSlabOffsets[s + 1];
+        if (slabCompBegin == slabCompEnd)
+            continue;
+
+        //points of the slab sorted by tile of the slab plane (counting sort). The reference points are taken
+        //in the buckets of the neighbour slabs, within the slab enlarged by the max search distance.
+        //Memory is proportional to one slab.
+        std::vector<unsigned> compOffsets, refOffsets, compSorted, refSorted, slabRef;
+        try
+        {
+            const double refSlabMin = bbMin.u[sd] + static_cast<double>(s) * tileSize - params.maxSearchDist;
+            const double refSlabMax = refSlabMin + tileSize + 2.0 * params.maxSearchDist;
+            const unsigned refBegin = refSlabOffsets[std::max(0, s - margin)];
+            const unsigned refEnd = refSlabOffsets[std::min(gridSize[sd] - 1, s + margin) + 1];
+            for (unsigned k = refBegin; k < refEnd; ++k)
+            {
+                const CCVector3* P = referenceCloud->getPoint(refBySlab[k]);
+                if (P->u[sd] >= refSlabMin && P->u[sd] <= refSlabMax)
+                    slabRef.push_back(refBySlab[k]);
+            }
+
+            compOffsets.resize(planeCount + 1, 0);
+            for (unsigned k = slabCompBegin; k < slabCompEnd; ++k)
+                ++compOffsets[planeIndex(compCloud->getPoint(compBySlab[k])) + 1];
+            refOffsets.resize(planeCount + 1, 0);
+            for (unsigned i : slabRef)
+                ++refOffsets[planeIndex(referenceCloud->getPoint(i)) + 1];
+            for (size_t t = 0; t < planeCount; ++t)
+            {
+                compOffsets[t + 1] += compOffsets[t];
+                refOffsets[t + 1] += refOffsets[t];
+            }
+            compSorted.resize(slabCompEnd - slabCompBegin);
+            refSorted.resize(slabRef.size());
+            {
+                std::vector<unsigned> fill(compOffsets.begin(), compOffsets.end() - 1);
+                for (unsigned k = slabCompBegin; k < slabCompEnd; ++k)
+                    compSorted[fill[planeIndex(compCloud->getPoint(compBySlab[k]))]++] = compBySlab[k];
+                fill.assign(refOffsets.begin(), refOffsets.end() - 1);
+                for (unsigned i : slabRef)
+                    refSorted[fill[planeIndex(referenceCloud->getPoint(i))]++] = i;
+            }
+        }
+        catch (const std::bad_alloc&)
+        {
+            CCTRACE("Not enough memory to sort the points of a slab by tiles");
+            ret = CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        slabRef.clear();
+        slabRef.shrink_to_fit();
+
+        for (int tv = 0; tv < gridSize[pd[1]] && ret > 0; ++tv)
+        for (int tu = 0; tu < gridSize[pd[0]] && ret > 0; ++tu)
+        {
+            size_t t = tu + static_cast<size_t>(gridSize[pd[0]]) * tv;
+            unsigned tileCompCount = compOffsets[t + 1] - compOffsets[t];
+            if (tileCompCount == 0)
+                continue;
+
+            //tile box, enlarged by the max search distance for the reference points
+            int tilePos[3];
+            tilePos[sd] = s;
+            tilePos[pd[0]] = tu;
+            tilePos[pd[1]] = tv;
+            CCVector3 tileMin, tileMax;
+            for (unsigned char d = 0; d < 3; ++d)
+            {
+                tileMin.u[d] = static_cast<PointCoordinateType>(bbMin.u[d] + static_cast<double>(tilePos[d]) * tileSize - params.maxSearchDist);
+                tileMax.u[d] = static_cast<PointCoordinateType>(bbMin.u[d] + static_cast<double>(tilePos[d] + 1) * tileSize + params.maxSearchDist);
+            }
+
+            CCCoreLib::ReferenceCloud compTile(compCloud);
+            CCCoreLib::ReferenceCloud refTile(referenceCloud);
+            if (!compTile.reserve(tileCompCount))
+            {
+                ret = CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+                break;
+            }
+            for (unsigned k = compOffsets[t]; k < compOffsets[t + 1]; ++k)
+                compTile.addPointIndex(compSorted[k]);
+
+            for (int nv = std::max(0, tv - margin); nv <= std::min(gridSize[pd[1]] - 1, tv + margin) && ret > 0; ++nv)
+            for (int nu = std::max(0, tu - margin); nu <= std::min(gridSize[pd[0]] - 1, tu + margin); ++nu)
+            {
+                size_t n = nu + static_cast<size_t>(gridSize[pd[0]]) * nv;
+                for (unsigned k = refOffsets[n]; k < refOffsets[n + 1]; ++k)
+                {
+                    const CCVector3* P = referenceCloud->getPoint(refSorted[k]);
+                    if (   P->x >= tileMin.x && P->y >= tileMin.y && P->z >= tileMin.z
+                        && P->x <= tileMax.x && P->y <= tileMax.y && P->z <= tileMax.z)
+                    {
+                        if (!refTile.addPointIndex(refSorted[k]))
+                        {
+                            ret = CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+                            break;
+                        }
+                    }
+                }
+                if (ret <= 0)
+                    break;
+            }
+            if (ret <= 0)
+                break;
+
+            if (refTile.size() == 0)
+            {
+                //no reference point in reach: same value as the one given by the standard computation
+                for (unsigned k = compOffsets[t]; k < compOffsets[t + 1]; ++k)
+                    sf->setValue(compSorted[k], static_cast<ScalarType>(params.maxSearchDist));
+            }
+            else
+            {
+                //octrees limited to the tile (and its margin)
+                CCCoreLib::DgmOctree* compOctree = nullptr;
+                CCCoreLib::DgmOctree* refOctree = nullptr;
+                CCCoreLib::DistanceComputationTools::SOReturnCode soCode =
+                    CCCoreLib::DistanceComputationTools::synchronizeOctrees(&compTile, &refTile, compOctree, refOctree,
+                                                                            params.maxSearchDist);
+                if (soCode == CCCoreLib::DistanceComputationTools::SYNCHRONIZED)
+                {
+                    tileParams.octreeLevel = params.octreeLevel;
+                    if (tileParams.octreeLevel == 0)
+                        tileParams.octreeLevel = compOctree->findBestLevelForComparisonWithOctree(refOctree);
+                    ret = CCCoreLib::DistanceComputationTools::computeCloud2CloudDistances(&compTile, &refTile, tileParams,
+                                                                                           nullptr, compOctree, refOctree);
+                }
+                else if (soCode == CCCoreLib::DistanceComputationTools::DISJOINT)
+                {
+                    for (unsigned k = compOffsets[t]; k < compOffsets[t + 1]; ++k)
+                        sf->setValue(compSorted[k], static_cast<ScalarType>(params.maxSearchDist));
+                }
+                else
+                {
+                    ret = CCCoreLib::DistanceComputationTools::ERROR_SYNCHRONIZE_OCTREES_FAILURE;
+                }
+                delete compOctree;
+                delete refOctree;
+            }
+            ++processedTiles;
+
+            if (progressCb && !nProgress.steps(tileCompCount))
+            {
+                ret = CCCoreLib::DistanceComputationTools::CANCELED_BY_USER;
+                break;
+            }
+        }
+    }
+    if (progressCb)
+        progressCb->stop();
+    CCTRACE("tiled C2C: " << processedTiles << " non empty tiles on " << tileCount << ", return code: " << ret);
+    if (ret <= 0)
+        return ret;
+
+    sf->computeMinAndMax();
+    QString sfName = QString("C2C absolute distances[<%1]").arg(params.maxSearchDist);
+    sf->setName(qPrintable(sfName));
+    return 1;
+}
+
+//! Batch of triangles, stored as structure of arrays for the point to triangle distance kernel
+/*! Per triangle data (vertex A, edges, normal, inverse squared lengths...) are computed once per batch
+ *  and shared by all the points of an octree cell. The batch size is padded to a multiple of
+ *  TriangleBatch::LANES so that the kernel loop has a fixed width the compiler can vectorize.
+ */
+struct TriangleBatch
+{
+    static const unsigned LANES = 16;
+
+    std::vector<PointCoordinateType> ax, ay, az;
+    std::vector<PointCoordinateType> e0x, e0y, e0z;   // B - A
+    std::vector<PointCoordinateType> e1x, e1y, e1z;   // C - A
+    std::vector<PointCoordinateType> e2x, e2y, e2z;   // C - B
+    std::vector<PointCoordinateType> nx, ny, nz;      // (B - A) x (C - A)
+    std::vector<PointCoordinateType> d00, d01, d11;
+    std::vector<PointCoordinateType> invDenom, invNN, invD00, invD11, invD22;
+    size_t count = 0;
+
+    void resize(size_t n)
+    {
+        count = n;
+        size_t padded = ((n + LANES - 1) / LANES) * LANES;
+        for (std::vector<PointCoordinateType>* v : { &ax, &ay, &az, &e0x, &e0y, &e0z, &e1x, &e1y, &e1z,
+                                                    &e2x, &e2y, &e2z, &nx, &ny, &nz, &d00, &d01, &d11,
+                                                    &invDenom, &invNN, &invD00, &invD11, &invD22 })
+            v->resize(padded);
+    }
+
+    size_t paddedSize() const { return ax.size(); }
+
+    void set(size_t k, const CCVector3& A, const CCVector3& B, const CCVector3& C)
+    {
+        CCVector3 e0 = B - A;
+        CCVector3 e1 = C - A;
+        CCVector3 e2 = C - B;
+        CCVector3 n = e0.cross(e1);
+        ax[k] = A.x; ay[k] = A.y; az[k] = A.z;
+        e0x[k] = e0.x; e0y[k] = e0.y; e0z[k] = e0.z;
+        e1x[k] = e1.x; e1y[k] = e1.y; e1z[k] = e1.z;
+        e2x[k] = e2.x; e2y[k] = e2.y; e2z[k] = e2.z;
+        nx[k] = n.x; ny[k] = n.y; nz[k] = n.z;
+        d00[k] = e0.norm2(); d01[k] = e0.dot(e1); d11[k] = e1.norm2();
+        PointCoordinateType denom = d00[k] * d11[k] - d01[k] * d01[k];
+        PointCoordinateType nn = n.norm2();
+        //degenerate triangles: no 'inside' region, only the edges (or vertices) count
+        invDenom[k] = (denom > 0 && nn > 0) ? 1 / denom : 0;
+        invNN[k] = nn > 0 ? 1 / nn : 0;
+        invD00[k] = d00[k] > 0 ? 1 / d00[k] : 0;
+        invD11[k] = d11[k] > 0 ? 1 / d11[k] : 0;
+        PointCoordinateType d22 = e2.norm2();
+        invD22[k] = d22 > 0 ? 1 / d22 : 0;
+    }
+
+    //! fills the padding with copies of the last triangle (neutral for a min)
+    void pad()
+    {
+        if (count == 0)
+            return;
+        for (size_t k = count; k < paddedSize(); ++k)
+        {
+            for (std::vector<PointCoordinateType>* v : { &ax, &ay, &az, &e0x, &e0y, &e0z, &e1x, &e1y, &e1z,
+                                                        &e2x, &e2y, &e2z, &nx, &ny, &nz, &d00, &d01, &d11,
+                                                        &invDenom, &invNN, &invD00, &invD11, &invD22 })
+                (*v)[k] = (*v)[count - 1];
+        }
+    }
+};
+
+//! squared distance from a point to the triangles [begin, end) of a batch (all by default), returns the minimum
+/*! Branch free formulation: projection inside the triangle gives the distance to the plane,
+ *  otherwise the distance to the closest edge (clamped segment projections).
+ *  The inner loop works on TriangleBatch::LANES triangles at a time with lane-wise minima,
+ *  so that it is vectorized by the compiler (SSE/AVX/AVX-512 depending on the build flags),
+ *  and stays valid scalar code otherwise. begin and end must be multiples of TriangleBatch::LANES.
+ */
+static PointCoordinateType minSquareDistanceToTriangles(const CCVector3& P, const TriangleBatch& batch,
+                                                        size_t begin = 0, size_t end = 0)
+{
+    const unsigned L = TriangleBatch::LANES;
+    PointCoordinateType laneMin[L];
+    for (unsigned l = 0; l < L; ++l)
+        laneMin[l] = std::numeric_limits<PointCoordinateType>::max();
+
+    const size_t n = (end > 0 ? std::min(end, batch.paddedSize()) : batch.paddedSize());
+    for (size_t start = begin; start < n; start += L)
+    {
+        PointCoordinateType d2[L];
+        for (unsigned l = 0; l < L; ++l)
+        {
+            const size_t k = start + l;
+            PointCoordinateType vx = P.x - batch.ax[k];
+            PointCoordinateType vy = P.y - batch.ay[k];
+            PointCoordinateType vz = P.z - batch.az[k];
+            PointCoordinateType d20 = vx * batch.e0x[k] + vy * batch.e0y[k] + vz * batch.e0z[k];
+            PointCoordinateType d21 = vx * batch.e1x[k] + vy * batch.e1y[k] + vz * batch.e1z[k];
+
+            //barycentric coordinates of the projection
+            PointCoordinateType b1 = (batch.d11[k] * d20 - batch.d01[k] * d21) * batch.invDenom[k];
+            PointCoordinateType b2 = (batch.d00[k] * d21 - batch.d01[k] * d20) * batch.invDenom[k];
+            bool inside = (batch.invDenom[k] > 0) & (b1 >= 0) & (b2 >= 0) & (b1 + b2 <= 1);
+            PointCoordinateType vn = vx * batch.nx[k] + vy * batch.ny[k] + vz * batch.nz[k];
+            PointCoordinateType planeD2 = vn * vn * batch.invNN[k];
+
+            //edge AB
+            PointCoordinateType t = std::min<PointCoordinateType>(std::max<PointCoordinateType>(d20 * batch.invD00[k], 0), 1);
+            PointCoordinateType ex = vx - t * batch.e0x[k];
+            PointCoordinateType ey = vy - t * batch.e0y[k];
+            PointCoordinateType ez = vz - t * batch.e0z[k];
+            PointCoordinateType edgeD2 = ex * ex + ey * ey + ez * ez;
+            //edge AC
+            t = std::min<PointCoordinateType>(std::max<PointCoordinateType>(d21 * batch.invD11[k], 0), 1);
+            ex = vx - t * batch.e1x[k];
+            ey = vy - t * batch.e1y[k];
+            ez = vz - t * batch.e1z[k];
+            edgeD2 = std::min(edgeD2, ex * ex + ey * ey + ez * ez);
+            //edge BC
+            PointCoordinateType wx = vx - batch.e0x[k];
+            PointCoordinateType wy = vy - batch.e0y[k];
+            PointCoordinateType wz = vz - batch.e0z[k];
+            t = (wx * batch.e2x[k] + wy * batch.e2y[k] + wz * batch.e2z[k]) * batch.invD22[k];
+            t = std::min<PointCoordinateType>(std::max<PointCoordinateType>(t, 0), 1);
+            ex = wx - t * batch.e2x[k];
+            ey = wy - t * batch.e2y[k];
+            ez = wz - t * batch.e2z[k];
+            edgeD2 = std::min(edgeD2, ex * ex + ey * ey + ez * ez);
+
+            d2[l] = inside ? planeD2 : edgeD2;
+        }
+        for (unsigned l = 0; l < L; ++l)
+            laneMin[l] = std::min(laneMin[l], d2[l]);
+    }
+
+    PointCoordinateType minD2 = laneMin[0];
+    for (unsigned l = 1; l < L; ++l)
+        minD2 = std::min(minD2, laneMin[l]);
+    return minD2;
+}
+
+//! Regular grid of the mesh triangles (each triangle is referenced by all the grid cells its bounding box intersects)
+struct TriangleGrid
+{
+    CCVector3 minCorner;
+    PointCoordinateType step = 0;
+    int dims[3] = { 0, 0, 0 };
+    std::vector<size_t> offsets;        // first entry of each grid cell in 'triangles' (size: cell count + 1)
+    std::vector<unsigned> triangles;
+
+    void cellRange(const CCVector3& bbMin, const CCVector3& bbMax, int lo[3], int hi[3]) const
+    {
+        for (unsigned char d = 0; d < 3; ++d)
+        {
+            lo[d] = static_cast<int>(std::floor((bbMin.u[d] - minCorner.u[d]) / step));
+            hi[d] = static_cast<int>(std::floor((bbMax.u[d] - minCorner.u[d]) / step));
+            lo[d] = std::min(std::max(lo[d], 0), dims[d] - 1);
+            hi[d] = std::min(std::max(hi[d], 0), dims[d] - 1);
+        }
+    }
+
+    size_t cellIndex(int i, int j, int k) const
+    {
+        return i + static_cast<size_t>(dims[0]) * (j + static_cast<size_t>(dims[1]) * k);
+    }
+
+    bool build(CCCoreLib::GenericIndexedMesh* mesh, PointCoordinateType cellStep)
+    {
+        CCVector3 bbMax;
+        mesh->getBoundingBox(minCorner, bbMax);
+        step = cellStep;
+        const uint64_t maxCellCount = static_cast<uint64_t>(1) << 24;
+        uint64_t cellCount = 0;
+        do
+        {
+            cellCount = 1;
+            for (unsigned char d = 0; d < 3; ++d)
+            {
+                dims[d] = std::max(1, static_cast<int>(std::ceil((bbMax.u[d] - minCorner.u[d]) / step)));
+                cellCount *= dims[d];
+            }
+            if (cellCount > maxCellCount)
+                step *= 2;
+        }
+        while (cellCount > maxCellCount);
+
+        try
+        {
+            offsets.assign(cellCount + 1, 0);
+            unsigned triCount = mesh->size();
+            CCVector3 A, B, C;
+            int lo[3], hi[3];
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                std::vector<size_t> fill;
+                if (pass == 1)
+                {
+                    for (size_t c = 0; c < cellCount; ++c)
+                        offsets[c + 1] += offsets[c];
+                    triangles.resize(offsets.back());
+                    fill.assign(offsets.begin(), offsets.end() - 1);
+                }
+                for (unsigned t = 0; t < triCount; ++t)
+                {
+                    mesh->getTriangleVertices(t, A, B, C);
+                    CCVector3 tMin(std::min(A.x, std::min(B.x, C.x)), std::min(A.y, std::min(B.y, C.y)), std::min(A.z, std::min(B.z, C.z)));
+                    CCVector3 tMax(std::max(A.x, std::max(B.x, C.x)), std::max(A.y, std::max(B.y, C.y)), std::max(A.z, std::max(B.z, C.z)));
+                    cellRange(tMin, tMax, lo, hi);
+                    for (int k = lo[2]; k <= hi[2]; ++k)
+                        for (int j = lo[1]; j <= hi[1]; ++j)
+                            for (int i = lo[0]; i <= hi[0]; ++i)
+                            {
+                                size_t c = cellIndex(i, j, k);
+                                if (pass == 0)
+                                    ++offsets[c + 1];
+                                else
+                                    triangles[fill[c]++] = t;
+                            }
+                }
+            }
+        }
+        catch (const std::bad_alloc&)
+        {
+            offsets.clear();
+            triangles.clear();
+            return false;
+        }
+        return true;
+    }
+};
+
+//! cell function for computeCloud2MeshDistancesWithBatchKernel: distances from the points of a cell to the mesh
+/*! additionalParameters:
+ *  [0] triangle grid
+ *  [1] mesh
+ *  [2] output scalar field
+ *  [3] max search distance (0 = no limit)
+ *  The search box around the cell points grows until all the points have found their nearest triangle:
+ *  the triangles of the new grid cells are gathered in one batch, evaluated for all the points of the cell.
+ */
+static bool computeCellDistancesToMesh(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                       void** additionalParameters,
+                                       CCCoreLib::NormalizedProgress* nProgress)
+{
+    const TriangleGrid& grid = *static_cast<TriangleGrid*>(additionalParameters[0]);
+    CCCoreLib::GenericIndexedMesh* mesh = static_cast<CCCoreLib::GenericIndexedMesh*>(additionalParameters[1]);
+    CCCoreLib::ScalarField* sf = static_cast<CCCoreLib::ScalarField*>(additionalParameters[2]);
+    double maxSearchDist = *static_cast<double*>(additionalParameters[3]);
+
+    //buffers of the cell, reused by the successive enlargements of the search box
+    std::vector<CCVector3> points;
+    std::vector<PointCoordinateType> minD2;
+    std::vector<unsigned> candidates;
+    TriangleBatch batch;
+
+    unsigned pointCount = cell.points->size();
+    try
+    {
+        points.resize(pointCount);
+        minD2.assign(pointCount, std::numeric_limits<PointCoordinateType>::max());
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+    CCVector3 bbMin, bbMax;
+    for (unsigned i = 0; i < pointCount; ++i)
+    {
+        cell.points->getPoint(i, points[i]);
+        if (i == 0)
+        {
+            bbMin = bbMax = points[0];
+        }
+        else
+        {
+            for (unsigned char d = 0; d < 3; ++d)
+            {
+                bbMin.u[d] = std::min(bbMin.u[d], points[i].u[d]);
+                bbMax.u[d] = std::max(bbMax.u[d], points[i].u[d]);
+            }
+        }
+    }
+
+    int prevLo[3] = { 1, 1, 1 };
+    int prevHi[3] = { 0, 0, 0 }; // empty range
+    double r = grid.step;
+    if (maxSearchDist > 0)
+        r = std::min(r, maxSearchDist);
+    CCVector3 A, B, C;
+    while (true)
+    {
+        CCVector3 margin(static_cast<PointCoordinateType>(r), static_cast<PointCoordinateType>(r), static_cast<PointCoordinateType>(r));
+        int lo[3], hi[3];
+        grid.cellRange(bbMin - margin, bbMax + margin, lo, hi);
+
+        //triangles of the grid cells not visited yet
+        candidates.clear();
+        for (int k = lo[2]; k <= hi[2]; ++k)
+            for (int j = lo[1]; j <= hi[1]; ++j)
+                for (int i = lo[0]; i <= hi[0]; ++i)
+                {
+                    if (   i >= prevLo[0] && i <= prevHi[0]
+                        && j >= prevLo[1] && j <= prevHi[1]
+                        && k >= prevLo[2] && k <= prevHi[2])
+                        continue;
+                    size_t c = grid.cellIndex(i, j, k);
+                    candidates.insert(candidates.end(), grid.triangles.begin() + grid.offsets[c], grid.triangles.begin() + grid.offsets[c + 1]);
+                }
+        if (!candidates.empty())
+        {
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            batch.resize(candidates.size());
+            for (size_t t = 0; t < candidates.size(); ++t)
+            {
+                mesh->getTriangleVertices(candidates[t], A, B, C);
+                batch.set(t, A, B, C);
+            }
+            batch.pad();
+            for (unsigned i = 0; i < pointCount; ++i)
+                minD2[i] = std::min(minD2[i], minSquareDistanceToTriangles(points[i], batch));
+        }
+        std::copy(lo, lo + 3, prevLo);
+        std::copy(hi, hi + 3, prevHi);
+
+        //the triangles not visited yet are farther than r from all the cell points
+        PointCoordinateType maxD2 = *std::max_element(minD2.begin(), minD2.end());
+        bool allFound = (maxD2 <= r * r);
+        bool wholeGrid = true;
+        for (unsigned char d = 0; d < 3; ++d)
+            wholeGrid = wholeGrid && (lo[d] == 0) && (hi[d] == grid.dims[d] - 1);
+        if (allFound || wholeGrid || (maxSearchDist > 0 && r >= maxSearchDist))
+            break;
+        r *= 2;
+        if (maxSearchDist > 0)
+            r = std::min(r, maxSearchDist);
+    }
+
+    for (unsigned i = 0; i < pointCount; ++i)
+    {
+        double dist = sqrt(static_cast<double>(minD2[i]));
+        if (maxSearchDist > 0 && dist > maxSearchDist)
+            dist = maxSearchDist;
+        sf->setValue(cell.points->getPointGlobalIndex(i), static_cast<ScalarType>(dist));
+    }
+
+    if (nProgress && !nProgress->steps(pointCount))
+        return false;
+    return true;
+}
+
+//! unsigned cloud to mesh distances with the batched point to triangle kernel (see TriangleBatch)
+static int computeCloud2MeshDistancesWithBatchKernel(ccPointCloud* compCloud,
+                                                     CCCoreLib::GenericIndexedMesh* mesh,
+                                                     CCCoreLib::DistanceComputationTools::Cloud2MeshDistancesComputationParams& params,
+                                                     CCCoreLib::ScalarField* sf,
+                                                     CCCoreLib::GenericProgressCallback* progressCb,
+                                                     CCCoreLib::DgmOctree* cloudOctree)
+{
+    if (mesh == nullptr)
+        return CCCoreLib::DistanceComputationTools::ERROR_NULL_REFERENCEMESH;
+    if (mesh->size() == 0)
+        return CCCoreLib::DistanceComputationTools::ERROR_EMPTY_REFERENCEMESH;
+    if (compCloud->size() == 0)
+        return CCCoreLib::DistanceComputationTools::ERROR_EMPTY_COMPAREDCLOUD;
+
+    QScopedPointer<CCCoreLib::DgmOctree> localOctree;
+    CCCoreLib::DgmOctree* octree = cloudOctree;
+    if (!octree)
+    {
+        localOctree.reset(new CCCoreLib::DgmOctree(compCloud));
+        if (localOctree->build(progressCb) <= 0)
+            return CCCoreLib::DistanceComputationTools::ERROR_BUILD_OCTREE_FAILURE;
+        octree = localOctree.data();
+    }
+    unsigned char level = params.octreeLevel;
+    if (level == 0 || level > CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL)
+        level = octree->findBestLevelForAGivenPopulationPerCell(16);
+
+    TriangleGrid grid;
+    if (!grid.build(mesh, octree->getCellSize(level)))
+        return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+
+    double maxSearchDist = params.maxSearchDist;
+    void* additionalParameters[4] = { &grid, mesh, sf, &maxSearchDist };
+    unsigned processed = octree->executeFunctionForAllCellsAtLevel(level,
+                                                                   &computeCellDistancesToMesh,
+                                                                   additionalParameters,
+                                                                   params.multiThread,
+                                                                   progressCb,
+                                                                   "C2M distances (batch kernel)",
+                                                                   params.maxThreadCount);
+    if (processed == 0)
+        return CCCoreLib::DistanceComputationTools::CANCELED_BY_USER;
+    return 1;
+}
+
+//! cell function for computeCloud2CloudWithinTolerance_py: flags the points of a cell having a reference point within the tolerance
+/*! additionalParameters:
+ *  [0] reference octree (same bounding box as the compared octree)
+ *  [1] tolerance
+ *  [2] output mask (uint8, one per compared point)
+ *  The reference points of the neighbour cells are gathered once for the cell (central cell first),
+ *  the search stops at the first reference point within the tolerance.
+ */
+static bool computeCellWithinTolerance(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                       void** additionalParameters,
+                                       CCCoreLib::NormalizedProgress* nProgress)
+{
+    const CCCoreLib::DgmOctree* refOctree = static_cast<CCCoreLib::DgmOctree*>(additionalParameters[0]);
+    double tolerance = *static_cast<double*>(additionalParameters[1]);
+    uint8_t* mask = static_cast<uint8_t*>(additionalParameters[2]);
+
+    Tuple3i cellPos;
+    refOctree->getCellPos(cell.truncatedCode, cell.level, cellPos, true);
+    const int n = static_cast<int>(std::ceil(tolerance / refOctree->getCellSize(cell.level)));
+    const int maxPos = (1 << cell.level) - 1;
+
+    CCCoreLib::ReferenceCloud candidates(refOctree->associatedCloud());
+    refOctree->getPointsInCell(cell.truncatedCode, cell.level, &candidates, true, false);
+    for (int k = std::max(0, cellPos.z - n); k <= std::min(maxPos, cellPos.z + n); ++k)
+        for (int j = std::max(0, cellPos.y - n); j <= std::min(maxPos, cellPos.y + n); ++j)
+            for (int i = std::max(0, cellPos.x - n); i <= std::min(maxPos, cellPos.x + n); ++i)
+            {
+                if (i == cellPos.x && j == cellPos.y && k == cellPos.z)
+                    continue;
+                Tuple3i pos(i, j, k);
+                refOctree->getPointsInCell(CCCoreLib::DgmOctree::GenerateTruncatedCellCode(pos, cell.level),
+                                           cell.level, &candidates, true, false);
+            }
+
+    unsigned candidateCount = candidates.size();
+    std::vector<CCVector3> refPoints(candidateCount);
+    for (unsigned c = 0; c < candidateCount; ++c)
+        candidates.getPoint(c, refPoints[c]);
+
+    const double squareTol = tolerance * tolerance;
+    unsigned pointCount = cell.points->size();
+    for (unsigned i = 0; i < pointCount; ++i)
+    {
+        const CCVector3* P = cell.points->getPoint(i);
+        uint8_t within = 0;
+        for (unsigned c = 0; c < candidateCount; ++c)
+        {
+            if ((refPoints[c] - *P).norm2d() <= squareTol)
+            {
+                within = 1;
+                break;
+            }
+        }
+        mask[cell.points->getPointGlobalIndex(i)] = within;
+    }
+
+    if (nProgress && !nProgress->steps(pointCount))
+        return false;
+    return true;
+}
+
+py::array_t<uint8_t> computeCloud2CloudWithinTolerance_py(CCCoreLib::GenericIndexedCloudPersist* comparedCloud,
+                                                          CCCoreLib::GenericIndexedCloudPersist* referenceCloud,
+                                                          double tolerance,
+                                                          bool multiThread = true,
+                                                          int maxThreadCount = 0,
+                                                          CCCoreLib::GenericProgressCallback* progressCb=nullptr)
+{
+    if (comparedCloud == nullptr || referenceCloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    if (tolerance <= 0)
+        throw std::invalid_argument("tolerance must be positive");
+    unsigned count = comparedCloud->size();
+    py::array_t<uint8_t> mask(count);
+    uint8_t* maskPtr = mask.mutable_data();
+    std::fill(maskPtr, maskPtr + count, 0);
+    if (count == 0 || referenceCloud->size() == 0)
+        return mask;
+
+    CCCoreLib::DgmOctree* compOctree = nullptr;
+    CCCoreLib::DgmOctree* refOctree = nullptr;
+    CCCoreLib::DistanceComputationTools::SOReturnCode soCode =
+        CCCoreLib::DistanceComputationTools::synchronizeOctrees(comparedCloud, referenceCloud, compOctree, refOctree,
+                                                                static_cast<PointCoordinateType>(tolerance), progressCb);
+    if (soCode == CCCoreLib::DistanceComputationTools::SYNCHRONIZED)
+    {
+        //finest level with cells not smaller than the tolerance: the search is limited to the 27 neighbour cells
+        unsigned char level = 1;
+        while (level < CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL && compOctree->getCellSize(level + 1) >= tolerance)
+            ++level;
+        double tol = tolerance;
+        void* additionalParameters[3] = { refOctree, &tol, maskPtr };
+        unsigned processed = compOctree->executeFunctionForAllCellsAtLevel(level,
+                                                                           &computeCellWithinTolerance,
+                                                                           additionalParameters,
+                                                                           multiThread,
+                                                                           progressCb,
+                                                                           "C2C within tolerance",
+                                                                           maxThreadCount);
+        delete compOctree;
+        delete refOctree;
+        if (processed == 0)
+            throw std::runtime_error("C2C within tolerance: computation failed or canceled");
+    }
+    else
+    {
+        delete compOctree;
+        delete refOctree;
+        if (soCode != CCCoreLib::DistanceComputationTools::DISJOINT)
+            throw std::runtime_error("C2C within tolerance: failed to build the octrees");
+    }
+    return mask;
+}
+
+//! true if one of the triangles of the batch is within the square tolerance (stops at the first block of triangles found)
+static bool anyTriangleWithin(const CCVector3& P, const TriangleBatch& batch, PointCoordinateType squareTol)
+{
+    const unsigned L = TriangleBatch::LANES;
+    const size_t n = batch.paddedSize();
+    for (size_t start = 0; start < n; start += L)
+    {
+        if (minSquareDistanceToTriangles(P, batch, start, start + L) <= squareTol)
+            return true;
+    }
+    return false;
+}
+
+//! cell function for computeCloud2MeshWithinTolerance_py: flags the points of a cell within the tolerance of the mesh
+/*! additionalParameters:
+ *  [0] triangle grid
+ *  [1] mesh
+ *  [2] tolerance
+ *  [3] output mask (uint8, one per compared point)
+ */
+static bool computeCellWithinToleranceOfMesh(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                             void** additionalParameters,
+                                             CCCoreLib::NormalizedProgress* nProgress)
+{
+    const TriangleGrid& grid = *static_cast<TriangleGrid*>(additionalParameters[0]);
+    CCCoreLib::GenericIndexedMesh* mesh = static_cast<CCCoreLib::GenericIndexedMesh*>(additionalParameters[1]);
+    double tolerance = *static_cast<double*>(additionalParameters[2]);
+    uint8_t* mask = static_cast<uint8_t*>(additionalParameters[3]);
+
+    unsigned pointCount = cell.points->size();
+    CCVector3 bbMin, bbMax;
+    std::vector<CCVector3> points(pointCount);
+    for (unsigned i = 0; i < pointCount; ++i)
+    {
+        cell.points->getPoint(i, points[i]);
+        if (i == 0)
+        {
+            bbMin = bbMax = points[0];
+        }
+        else
+        {
+            for (unsigned char d = 0; d < 3; ++d)
+            {
+                bbMin.u[d] = std::min(bbMin.u[d], points[i].u[d]);
+                bbMax.u[d] = std::max(bbMax.u[d], points[i].u[d]);
+            }
+        }
+    }
+
+    //the triangles within the tolerance of the cell
+    CCVector3 margin(static_cast<PointCoordinateType>(tolerance), static_cast<PointCoordinateType>(tolerance), static_cast<PointCoordinateType>(tolerance));
+    bbMin -= margin;
+    bbMax += margin;
+    std::vector<unsigned> candidates;
+    CCVector3 gridMax = grid.minCorner + CCVector3(grid.dims[0] * grid.step, grid.dims[1] * grid.step, grid.dims[2] * grid.step);
+    bool overlap = true;
+    for (unsigned char d = 0; d < 3; ++d)
+        overlap = overlap && (bbMax.u[d] >= grid.minCorner.u[d]) && (bbMin.u[d] <= gridMax.u[d]);
+    if (overlap)
+    {
+        int lo[3], hi[3];
+        grid.cellRange(bbMin, bbMax, lo, hi);
+        for (int k = lo[2]; k <= hi[2]; ++k)
+            for (int j = lo[1]; j <= hi[1]; ++j)
+                for (int i = lo[0]; i <= hi[0]; ++i)
+                {
+                    size_t c = grid.cellIndex(i, j, k);
+                    candidates.insert(candidates.end(), grid.triangles.begin() + grid.offsets[c], grid.triangles.begin() + grid.offsets[c + 1]);
+                }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    if (candidates.empty())
+    {
+        for (unsigned i = 0; i < pointCount; ++i)
+            mask[cell.points->getPointGlobalIndex(i)] = 0;
+    }
+    else
+    {
+        TriangleBatch batch;
+        batch.resize(candidates.size());
+        CCVector3 A, B, C;
+        for (size_t t = 0; t < candidates.size(); ++t)
+        {
+            mesh->getTriangleVertices(candidates[t], A, B, C);
+            batch.set(t, A, B, C);
+        }
+        batch.pad();
+        const PointCoordinateType squareTol = static_cast<PointCoordinateType>(tolerance * tolerance);
+        for (unsigned i = 0; i < pointCount; ++i)
+            mask[cell.points->getPointGlobalIndex(i)] = anyTriangleWithin(points[i], batch, squareTol) ? 1 : 0;
+    }
+
+    if (nProgress && !nProgress->steps(pointCount))
+        return false;
+    return true;
+}
+
+py::array_t<uint8_t> computeCloud2MeshWithinTolerance_py(CCCoreLib::GenericIndexedCloudPersist* pointCloud,
+                                                         CCCoreLib::GenericIndexedMesh* mesh,
+                                                         double tolerance,
+                                                         bool multiThread = true,
+                                                         int maxThreadCount = 0,
+                                                         CCCoreLib::GenericProgressCallback* progressCb=nullptr)
+{
+    if (pointCloud == nullptr || mesh == nullptr)
+        throw std::invalid_argument("null cloud or mesh");
+    if (tolerance <= 0)
+        throw std::invalid_argument("tolerance must be positive");
+    unsigned count = pointCloud->size();
+    py::array_t<uint8_t> mask(count);
+    uint8_t* maskPtr = mask.mutable_data();
+    std::fill(maskPtr, maskPtr + count, 0);
+    if (count == 0 || mesh->size() == 0)
+        return mask;
+
+    CCCoreLib::DgmOctree octree(pointCloud);
+    if (octree.build(progressCb) <= 0)
+        throw std::runtime_error("C2M within tolerance: failed to build the octree");
+    unsigned char level = 1;
+    while (level < CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL && octree.getCellSize(level + 1) >= tolerance)
+        ++level;
+
+    TriangleGrid grid;
+    if (!grid.build(mesh, static_cast<PointCoordinateType>(std::max<double>(tolerance, octree.getCellSize(level)))))
+        throw std::runtime_error("C2M within tolerance: not enough memory");
+
+    double tol = tolerance;
+    void* additionalParameters[4] = { &grid, mesh, &tol, maskPtr };
+    unsigned processed = octree.executeFunctionForAllCellsAtLevel(level,
+                                                                  &computeCellWithinToleranceOfMesh,
+                                                                  additionalParameters,
+                                                                  multiThread,
+                                                                  progressCb,
+                                                                  "C2M within tolerance",
+                                                                  maxThreadCount);
+    if (processed == 0)
+        throw std::runtime_error("C2M within tolerance: computation failed or canceled");
+    return mask;
+}
+
+int computeCloud2MeshDistances_py(  CCCoreLib::GenericIndexedCloudPersist* pointCloud,
+                                    CCCoreLib::GenericIndexedMesh* mesh,
+                                    CCCoreLib::DistanceComputationTools::Cloud2MeshDistancesComputationParams& params,
+                                    CCCoreLib::GenericProgressCallback* progressCb=nullptr,
+                                    CCCoreLib::DgmOctree* cloudOctree=nullptr,
+                                    bool useBatchKernel=false)
+{
+    ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(pointCloud);
+    if (useBatchKernel && (params.signedDistances || params.useDistanceMap || params.CPSet))
+        throw std::invalid_argument("batch kernel: only for unsigned distances, without distance map or closest point set");
+    if (compCloud == nullptr)
+        return CCCoreLib::DistanceComputationTools::ERROR_NULL_COMPAREDCLOUD;
+    //does the cloud has already a temporary scalar field that we can use?
+    int sfIdx = compCloud->getScalarFieldIndexByName("Temp. approx. distances");
+    if (sfIdx < 0)
+    {
+        //we need to create a new scalar field
+        sfIdx = compCloud->addScalarField("Temp. approx. distances");
+        if (sfIdx < 0)
+        {
+            CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
+            return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+        }
+    }
+    compCloud->setCurrentScalarField(sfIdx);
+    int ret = 0;
+    if (useBatchKernel)
+        ret = computeCloud2MeshDistancesWithBatchKernel(compCloud, mesh, params, compCloud->getScalarField(sfIdx),
+                                                        progressCb, cloudOctree);
+    else
+        ret = CCCoreLib::DistanceComputationTools::computeCloud2MeshDistances(compCloud, mesh, params,
+                                                                              progressCb, cloudOctree);
+    if (ret != 1)
+        return ret;
+    CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
+    sf->computeMinAndMax();
+    QString sfName = "C2M absolute distances";
+    if (params.signedDistances)
+        sfName = "C2M signed distances";
+    if (params.maxSearchDist > 0)
+    {
+        sfName += QString("[<%1]").arg(params.maxSearchDist);
+    }
+    sf->setName(qPrintable(sfName));
+    return 1;
+}
+
+//! index value for "no nearest point within the max search distance"
+static const uint32_t NEAREST_INDEX_NONE = std::numeric_limits<uint32_t>::max();
+
+//! cell function for computeCloud2MultiCloudDistances_py: distances from the points of a cell to each reference
+/*! additionalParameters:
+ *  [0] reference octrees (same bounding box as the compared octree)
+ *  [1] one scalar field per reference
+ *  [2] max search distance (0 = no limit)
+ *  [3] optional (nullptr): one array per reference, for the index of the nearest reference point
+ *      (NEAREST_INDEX_NONE if none within the max search distance)
+ *  The search structure of each reference is set once per cell and shared by all the points of the cell.
+ */
+static bool computeCellMultiCloudDistances(const CCCoreLib::DgmOctree::octreeCell& cell,
+                                           void** additionalParameters,
+                                           CCCoreLib::NormalizedProgress* nProgress)
+{
+    const std::vector<CCCoreLib::DgmOctree*>& refOctrees = *static_cast<std::vector<CCCoreLib::DgmOctree*>*>(additionalParameters[0]);
+    const std::vector<CCCoreLib::ScalarField*>& sfs = *static_cast<std::vector<CCCoreLib::ScalarField*>*>(additionalParameters[1]);
+    double maxSearchDist = *static_cast<double*>(additionalParameters[2]);
+    const std::vector<uint32_t*>* nearestIndexes = static_cast<std::vector<uint32_t*>*>(additionalParameters[3]);
+
+    unsigned pointCount = cell.points->size();
+    for (size_t r = 0; r < refOctrees.size(); ++r)
+    {
+        CCCoreLib::ScalarField* sf = sfs[r];
+        uint32_t* indexes = nearestIndexes ? (*nearestIndexes)[r] : nullptr;
+        if (!refOctrees[r])
+        {
+            //no reference point in reach
+            for (unsigned i = 0; i < pointCount; ++i)
+            {
+                sf->setValue(cell.points->getPointGlobalIndex(i), static_cast<ScalarType>(maxSearchDist));
+                if (indexes)
+                    indexes[cell.points->getPointGlobalIndex(i)] = NEAREST_INDEX_NONE;
+            }
+            continue;
+        }
+        const CCCoreLib::DgmOctree* refOctree = refOctrees[r];
+        CCCoreLib::DgmOctree::NearestNeighboursSearchStruct nNSS;
+        nNSS.level = cell.level;
+        nNSS.minNumberOfNeighbors = 1;
+        if (maxSearchDist > 0)
+            nNSS.maxSearchSquareDistd = maxSearchDist * maxSearchDist;
+        refOctree->getCellPos(cell.truncatedCode, cell.level, nNSS.cellPos, true);
+        refOctree->computeCellCenter(nNSS.cellPos, cell.level, nNSS.cellCenter);
+
+        for (unsigned i = 0; i < pointCount; ++i)
+        {
+            cell.points->getPoint(i, nNSS.queryPoint);
+            double squareDist = refOctree->findTheNearestNeighborStartingFromCell(nNSS);
+            ScalarType dist = (squareDist >= 0 ? static_cast<ScalarType>(sqrt(squareDist))
+                                               : static_cast<ScalarType>(maxSearchDist > 0 ? maxSearchDist : CCCoreLib::NAN_VALUE));
+            sf->setValue(cell.points->getPointGlobalIndex(i), dist);
+            if (indexes)
+                indexes[cell.points->getPointGlobalIndex(i)] = (squareDist >= 0 ? nNSS.theNearestPointIndex : NEAREST_INDEX_NONE);
+        }
+    }
+
+    if (nProgress && !nProgress->steps(pointCount))
+        return false;
+    return true;
+}
+
+std::vector<int> computeCloud2MultiCloudDistances_py(ccPointCloud* compCloud,
+                                                     std::vector<ccPointCloud*> refClouds,
+                                                     unsigned char octreeLevel = 0,
+                                                     double maxSearchDist = 0,
+                                                     bool multiThread = true,
+                                                     int maxThreadCount = 0,
+                                                     CCCoreLib::GenericProgressCallback* progressCb=nullptr)
+{
+    std::vector<int> sfIndexes;
+    if (compCloud == nullptr || compCloud->size() == 0)
+        throw std::invalid_argument("the compared cloud is null or empty");
+    if (refClouds.empty())
+        throw std::invalid_argument("no reference cloud");
+    for (ccPointCloud* refCloud : refClouds)
+        if (refCloud == nullptr || refCloud->size() == 0)
+            throw std::invalid_argument("a reference cloud is null or empty");
+    if (octreeLevel > CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL)
+        throw std::invalid_argument("invalid octree level");
+
+    //common cubical bounding box for all the octrees (limited to the max search distance around the compared cloud)
+    CCVector3 bbMin, bbMax;
+    compCloud->getBoundingBox(bbMin, bbMax);
+    if (maxSearchDist > 0)
+    {
+        CCVector3 margin(maxSearchDist, maxSearchDist, maxSearchDist);
+        bbMin -= margin;
+        bbMax += margin;
+    }
+    else
+    {
+        for (ccPointCloud* refCloud : refClouds)
+        {
+            CCVector3 rMin, rMax;
+            refCloud->getBoundingBox(rMin, rMax);
+            for (unsigned char d = 0; d < 3; ++d)
+            {
+                bbMin.u[d] = std::min(bbMin.u[d], rMin.u[d]);
+                bbMax.u[d] = std::max(bbMax.u[d], rMax.u[d]);
+            }
+        }
+    }
+    const CCVector3 pointsMinFilter = bbMin;
+    const CCVector3 pointsMaxFilter = bbMax;
+    {
+        CCVector3 dims = bbMax - bbMin;
+        PointCoordinateType maxDim = std::max(dims.x, std::max(dims.y, dims.z)) * static_cast<PointCoordinateType>(1.01);
+        CCVector3 center = (bbMax + bbMin) / 2;
+        CCVector3 halfDiag(maxDim / 2, maxDim / 2, maxDim / 2);
+        bbMin = center - halfDiag;
+        bbMax = center + halfDiag;
+    }
+
+    CCCoreLib::DgmOctree compOctree(compCloud);
+    if (compOctree.build(bbMin, bbMax, nullptr, nullptr, progressCb) <= 0)
+    {
+        CCTRACE("Failed to compute the octree of the compared cloud");
+        return sfIndexes;
+    }
+    std::vector<CCCoreLib::DgmOctree*> refOctrees(refClouds.size(), nullptr);
+    auto releaseOctrees = [&refOctrees]()
+    {
+        for (CCCoreLib::DgmOctree*& octree : refOctrees)
+        {
+            delete octree;
+            octree = nullptr;
+        }
+    };
+    for (size_t r = 0; r < refClouds.size(); ++r)
+    {
+        CCCoreLib::DgmOctree* refOctree = new CCCoreLib::DgmOctree(refClouds[r]);
+        if (refOctree->build(bbMin, bbMax, &pointsMinFilter, &pointsMaxFilter, progressCb) <= 0)
+        {
+            //no reference point in reach
+            delete refOctree;
+            refOctree = nullptr;
+            if (maxSearchDist <= 0)
+            {
+                releaseOctrees();
+                CCTRACE("Failed to compute the octree of reference cloud " << r);
+                return sfIndexes;
+            }
+        }
+        refOctrees[r] = refOctree;
+    }
+
+    if (octreeLevel == 0)
+    {
+        //mean of the best levels for each reference
+        unsigned levelSum = 0;
+        unsigned levelCount = 0;
+        for (CCCoreLib::DgmOctree* refOctree : refOctrees)
+        {
+            if (refOctree)
+            {
+                levelSum += compOctree.findBestLevelForComparisonWithOctree(refOctree);
+                ++levelCount;
+            }
+        }
+        octreeLevel = levelCount ? static_cast<unsigned char>((levelSum + levelCount / 2) / levelCount) : 7;
+        CCTRACE("multi reference C2C, octree level: " << static_cast<int>(octreeLevel));
+    }
+
+    //one scalar field per reference, the reference index makes the name unique (references may share a name)
+    std::vector<CCCoreLib::ScalarField*> sfs;
+    for (size_t r = 0; r < refClouds.size(); ++r)
+    {
+        QString sfName = QString("C2C absolute distances (#%1 %2)").arg(r).arg(refClouds[r]->getName());
+        if (maxSearchDist > 0)
+        {
+            sfName += QString("[<%1]").arg(maxSearchDist);
+        }
+        int sfIdx = compCloud->getScalarFieldIndexByName(qPrintable(sfName));
+        if (sfIdx < 0)
+            sfIdx = compCloud->addScalarField(qPrintable(sfName));
         if (sfIdx < 0)
         {
-            CCTRACE("Couldn't allocate a new scalar field for computing approx. distances! Try to free some memory ...");
-            return result;
+            CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
+            releaseOctrees();
+            return std::vector<int>();
+        }
+        if (std::find(sfIndexes.begin(), sfIndexes.end(), sfIdx) != sfIndexes.end())
+        {
+            releaseOctrees();
+            throw std::runtime_error("scalar field " + sfName.toStdString() + " already used for another reference");
         }
+        sfIndexes.push_back(sfIdx);
+        sfs.push_back(compCloud->getScalarField(sfIdx));
     }
-    compCloud->setCurrentScalarField(sfIdx);
-    CCCoreLib::DistanceComputationTools::Cloud2MeshDistancesComputationParams c2mParams;
+
+    void* additionalParameters[4] = { &refOctrees, &sfs, &maxSearchDist, nullptr };
+    unsigned processed = compOctree.executeFunctionForAllCellsAtLevel(octreeLevel,
+                                                                      &computeCellMultiCloudDistances,
+                                                                      additionalParameters,
+                                                                      multiThread,
+                                                                      progressCb,
+                                                                      "Multi reference C2C distances",
+                                                                      maxThreadCount);
+    releaseOctrees();
+    if (processed == 0)
     {
-        c2mParams.octreeLevel = 7;
-        c2mParams.maxSearchDist = 0;
-        c2mParams.useDistanceMap = true;
-        c2mParams.signedDistances = false;
-        c2mParams.flipNormals = false;
-        c2mParams.multiThread = false;
+        CCTRACE("multi reference C2C distances failed or canceled");
+        return std::vector<int>();
     }
-    int ret = CCCoreLib::DistanceComputationTools::computeCloud2MeshDistances( compCloud,
-                                                                               mesh,
-                                                                               c2mParams,
-                                                                               nullptr,
-                                                                               nullptr);
-    if (ret != 1)
-        return result;
-    CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
-    ScalarType mean;
-    ScalarType variance;
-    sf->computeMinAndMax();
-    sf->computeMeanAndVariance(mean,&variance);
-    result.resize(5);
-    result[0] = sf->getMin();
-    result[1] = sf->getMax();
-    result[2] = mean;
-    result[3] = variance;
-    if (!compCloud->getOctree())
-        compCloud->computeOctree();
-    result[4] = compCloud->getOctree()->getCellSize(7)/2.0;
-    return result;
+    for (CCCoreLib::ScalarField* sf : sfs)
+        sf->computeMinAndMax();
+    return sfIndexes;
 }
 
-int computeCloud2CloudDistances_py( CCCoreLib::GenericIndexedCloudPersist* comparedCloud,
-                                    CCCoreLib::GenericIndexedCloudPersist* referenceCloud,
-                                    CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams& params,
-                                    CCCoreLib::GenericProgressCallback* progressCb=nullptr,
-                                    CCCoreLib::DgmOctree* compOctree=nullptr,
-                                    CCCoreLib::DgmOctree* refOctree=nullptr)
+py::tuple computeCloud2CloudDistancesWithIndexes_py(CCCoreLib::GenericIndexedCloudPersist* comparedCloud,
+                                                    CCCoreLib::GenericIndexedCloudPersist* referenceCloud,
+                                                    CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams& params,
+                                                    CCCoreLib::GenericProgressCallback* progressCb=nullptr,
+                                                    CCCoreLib::DgmOctree* compOctree=nullptr,
+                                                    CCCoreLib::DgmOctree* refOctree=nullptr)
 {
+    if (comparedCloud == nullptr || referenceCloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    unsigned count = comparedCloud->size();
+
+    if (params.maxSearchDist <= 0)
+    {
+        //the Closest Point Set of the standard computation gives the indexes
+        CCCoreLib::ReferenceCloud CPSet(referenceCloud);
+        CCCoreLib::ReferenceCloud* formerCPSet = params.CPSet;
+        params.CPSet = &CPSet;
+        int ret = computeCloud2CloudDistances_py(comparedCloud, referenceCloud, params, progressCb, compOctree, refOctree);
+        params.CPSet = formerCPSet;
+        if (ret <= 0 || CPSet.size() != count)
+            return py::make_tuple(ret, py::none());
+        py::array_t<uint32_t> indexes(count);
+        uint32_t* ptr = indexes.mutable_data();
+        for (unsigned i = 0; i < count; ++i)
+            ptr[i] = CPSet.getPointGlobalIndex(i);
+        return py::make_tuple(ret, indexes);
+    }
+
+    //with a max search distance (no Closest Point Set in this case), the nearest neighbour search is done here
+    if (params.localModel != CCCoreLib::NO_MODEL || params.splitDistances[0])
+        throw std::invalid_argument("local models and split distances are not available with a max search distance");
     ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(comparedCloud);
     if (compCloud == nullptr)
-        return CCCoreLib::DistanceComputationTools::ERROR_NULL_COMPAREDCLOUD;
-    //does the cloud has already a temporary scalar field that we can use?
+        return py::make_tuple(static_cast<int>(CCCoreLib::DistanceComputationTools::ERROR_NULL_COMPAREDCLOUD), py::none());
+    if (count == 0)
+        return py::make_tuple(static_cast<int>(CCCoreLib::DistanceComputationTools::ERROR_EMPTY_COMPAREDCLOUD), py::none());
+
     int sfIdx = compCloud->getScalarFieldIndexByName("Temp. approx. distances");
     if (sfIdx < 0)
-    {
-        //we need to create a new scalar field
         sfIdx = compCloud->addScalarField("Temp. approx. distances");
-        if (sfIdx < 0)
+    if (sfIdx < 0)
+    {
+        CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
+        return py::make_tuple(static_cast<int>(CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY), py::none());
+    }
+    compCloud->setCurrentScalarField(sfIdx);
+    std::vector<CCCoreLib::ScalarField*> sfs(1, compCloud->getScalarField(sfIdx));
+
+    py::array_t<uint32_t> indexes(count);
+    std::vector<uint32_t*> indexPtrs(1, indexes.mutable_data());
+
+    CCCoreLib::DgmOctree* cOctree = compOctree;
+    CCCoreLib::DgmOctree* rOctree = refOctree;
+    CCCoreLib::DistanceComputationTools::SOReturnCode soCode =
+        CCCoreLib::DistanceComputationTools::synchronizeOctrees(compCloud, referenceCloud, cOctree, rOctree,
+                                                                params.maxSearchDist, progressCb);
+    int ret = 1;
+    if (soCode == CCCoreLib::DistanceComputationTools::SYNCHRONIZED)
+    {
+        unsigned char level = params.octreeLevel;
+        if (level == 0 || level > CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL)
+            level = cOctree->findBestLevelForComparisonWithOctree(rOctree);
+        std::vector<CCCoreLib::DgmOctree*> refOctrees(1, rOctree);
+        double maxSearchDist = params.maxSearchDist;
+        void* additionalParameters[4] = { &refOctrees, &sfs, &maxSearchDist, &indexPtrs };
+        if (cOctree->executeFunctionForAllCellsAtLevel(level,
+                                                       &computeCellMultiCloudDistances,
+                                                       additionalParameters,
+                                                       params.multiThread,
+                                                       progressCb,
+                                                       "C2C distances and nearest indexes",
+                                                       params.maxThreadCount) == 0)
         {
-            CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
-            return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+            ret = CCCoreLib::DistanceComputationTools::CANCELED_BY_USER;
         }
     }
-    compCloud->setCurrentScalarField(sfIdx);
-    int ret = CCCoreLib::DistanceComputationTools::computeCloud2CloudDistances(compCloud, referenceCloud, params,
-                                                                               progressCb, compOctree, refOctree);
-    CCTRACE("return code computeCloud2CloudDistances: " << ret);
+    else if (soCode == CCCoreLib::DistanceComputationTools::DISJOINT)
+    {
+        sfs[0]->fill(static_cast<ScalarType>(params.maxSearchDist));
+        std::fill(indexPtrs[0], indexPtrs[0] + count, NEAREST_INDEX_NONE);
+    }
+    else
+    {
+        ret = CCCoreLib::DistanceComputationTools::ERROR_SYNCHRONIZE_OCTREES_FAILURE;
+    }
+    //only the octrees created by synchronizeOctrees are released
+    if (cOctree != compOctree)
+        delete cOctree;
+    if (rOctree != refOctree)
+        delete rOctree;
     if (ret <= 0)
-        return ret;
-    CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
+        return py::make_tuple(ret, py::none());
+
+    CCCoreLib::ScalarField* sf = sfs[0];
     sf->computeMinAndMax();
-    QString sfName = "C2C absolute distances";
-    if (params.maxSearchDist > 0)
+    QString sfName = QString("C2C absolute distances[<%1]").arg(params.maxSearchDist);
+    sf->setName(qPrintable(sfName));
+    return py::make_tuple(ret, indexes);
+}
+
+//! Cache of the local models (fitted plane normals) of a reference cloud, for signed cloud to cloud distances
+/*! The local models are computed on demand, only for the reference points that are the nearest neighbour
+ *  of a compared point, and kept for the next calls with the same reference cloud (and same settings).
+ *  Not used when the reference normals are used directly (nothing to compute).
+ */
+struct LocalModelCache
+{
+    unsigned referenceID = 0;                   //!< unique ID of the reference cloud
+    unsigned referenceSize = 0;
+    const CCCoreLib::DgmOctree* referenceOctree = nullptr; //!< octree of the reference cloud when the models were computed
+    CCVector3 bbMin, bbMax;                     //!< bounding box of the reference cloud
+    uint64_t fingerprint = 0;                   //!< hash of a sample of the reference points
+    unsigned kNN = 0;
+    CCVector3 preferredOrientation;
+    std::vector<CCVector3> normals;
+    std::vector<uint8_t> valid;                 //!< 0: not computed, 1: computed, 2: failed (not enough neighbours)
+
+    size_t modelCount() const
     {
-        sfName += QString("[<%1]").arg(params.maxSearchDist);
+        return std::count(valid.begin(), valid.end(), 1);
     }
-    sf->setName(qPrintable(sfName));
-    const char* sfNames[] = {qPrintable(sfName + " (X)"), qPrintable(sfName + " (Y)"), qPrintable(sfName + " (Z)")};
-    for (int i=0; i<3; i++)
-    if (ccScalarField* sfi = dynamic_cast<ccScalarField*>(params.splitDistances[i]))
+
+    void clear()
     {
-        sfi->computeMinAndMax();
-        sfi->setName(sfNames[i]);
-        int isf = compCloud->addScalarField(sfi);
-        params.splitDistances[i] = nullptr;
+        referenceID = 0;
+        referenceSize = 0;
+        referenceOctree = nullptr;
+        fingerprint = 0;
+        normals.clear();
+        valid.clear();
     }
-    return 1;
-}
 
-int computeCloud2MeshDistances_py(  CCCoreLib::GenericIndexedCloudPersist* pointCloud,
-                                    CCCoreLib::GenericIndexedMesh* mesh,
-                                    CCCoreLib::DistanceComputationTools::Cloud2MeshDistancesComputationParams& params,
-                                    CCCoreLib::GenericProgressCallback* progressCb=nullptr,
-                                    CCCoreLib::DgmOctree* cloudOctree=nullptr)
+    //! FNV-1a hash of the coordinates of a regular sample of at most 4096 points
+    static uint64_t computeFingerprint(ccPointCloud* refCloud)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        auto hashBytes = [&hash](const void* data, size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t b = 0; b < size; ++b)
+            {
+                hash ^= bytes[b];
+                hash *= 1099511628211ULL;
+            }
+        };
+        const unsigned count = refCloud->size();
+        const unsigned step = std::max(1u, count / 4096);
+        for (unsigned i = 0; i < count; i += step)
+            hashBytes(refCloud->getPoint(i)->u, sizeof(PointCoordinateType) * 3);
+        return hash;
+    }
+
+    //! (re)initializes the cache if the reference cloud or the settings changed
+    /*! The key is the cloud unique ID and size, its octree, its bounding box and a hash of a sample of
+     *  its points, plus the settings. A modification of points out of the sample, without change of
+     *  the bounding box and octree, is not detected: call clear().
+     */
+    bool prepare(ccPointCloud* refCloud, const CCCoreLib::DgmOctree* refOctree, unsigned k, const CCVector3& orientation)
+    {
+        CCVector3 bbMinCloud, bbMaxCloud;
+        refCloud->getBoundingBox(bbMinCloud, bbMaxCloud);
+        uint64_t hash = computeFingerprint(refCloud);
+        if (   refCloud->getUniqueID() == referenceID && refCloud->size() == referenceSize
+            && refOctree == referenceOctree && bbMinCloud == bbMin && bbMaxCloud == bbMax && hash == fingerprint
+            && k == kNN && orientation == preferredOrientation)
+            return true;
+        clear();
+        try
+        {
+            normals.resize(refCloud->size());
+            valid.resize(refCloud->size(), 0);
+        }
+        catch (const std::bad_alloc&)
+        {
+            clear();
+            return false;
+        }
+        referenceID = refCloud->getUniqueID();
+        referenceSize = refCloud->size();
+        referenceOctree = refOctree;
+        bbMin = bbMinCloud;
+        bbMax = bbMaxCloud;
+        fingerprint = hash;
+        kNN = k;
+        preferredOrientation = orientation;
+        return true;
+    }
+};
+
+int computeCloud2CloudSignedDistances_py(ccPointCloud* compCloud,
+                                         ccPointCloud* refCloud,
+                                         double maxSearchDist = 0,
+                                         bool useNormals = true,
+                                         unsigned kNN = 12,
+                                         CCVector3 preferredOrientation = CCVector3(0, 0, 1),
+                                         LocalModelCache* cache = nullptr,
+                                         bool multiThread = true,
+                                         CCCoreLib::GenericProgressCallback* progressCb = nullptr)
 {
-    ccPointCloud* compCloud = dynamic_cast<ccPointCloud*>(pointCloud);
-    if (compCloud == nullptr)
-        return CCCoreLib::DistanceComputationTools::ERROR_NULL_COMPAREDCLOUD;
-    //does the cloud has already a temporary scalar field that we can use?
+    if (compCloud == nullptr || refCloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    if (refCloud->size() == 0)
+        return CCCoreLib::DistanceComputationTools::ERROR_EMPTY_REFERENCECLOUD;
+    if (compCloud->size() == 0)
+        return CCCoreLib::DistanceComputationTools::ERROR_EMPTY_COMPAREDCLOUD;
+    if (useNormals && !refCloud->hasNormals())
+        throw std::invalid_argument("the reference cloud has no normals");
+    if (!useNormals && kNN < 3)
+        throw std::invalid_argument("at least 3 neighbours are required to fit a local plane");
+
+    //the octree of the reference cloud is kept with the cloud, and reused by the next calls
+    ccOctree::Shared refOctree = refCloud->getOctree();
+    if (!refOctree)
+        refOctree = refCloud->computeOctree(progressCb);
+    if (!refOctree)
+        return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+
+    //the reference normals are used directly: no local model to compute, the cache is not used
+    LocalModelCache localCache;
+    if (!cache || useNormals)
+        cache = &localCache;
+    if (!useNormals && !cache->prepare(refCloud, refOctree.data(), kNN, preferredOrientation))
+        return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+    unsigned char level = refOctree->findBestLevelForAGivenPopulationPerCell(std::max(3u, kNN));
+
     int sfIdx = compCloud->getScalarFieldIndexByName("Temp. approx. distances");
     if (sfIdx < 0)
-    {
-        //we need to create a new scalar field
         sfIdx = compCloud->addScalarField("Temp. approx. distances");
-        if (sfIdx < 0)
-        {
-            CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
-            return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
-        }
+    if (sfIdx < 0)
+    {
+        CCTRACE("Couldn't allocate a new scalar field for computing distances! Try to free some memory ...");
+        return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
     }
     compCloud->setCurrentScalarField(sfIdx);
-    int ret = CCCoreLib::DistanceComputationTools::computeCloud2MeshDistances(compCloud, mesh, params,
-                                                                              progressCb, cloudOctree);
-    if (ret != 1)
-        return ret;
     CCCoreLib::ScalarField* sf = compCloud->getScalarField(sfIdx);
+
+    //items processed by chunks (in parallel), a chunk function gets the [begin, end[ range of its items
+    const unsigned chunkSize = 1 << 14;
+    auto forEachChunk = [&](unsigned itemCount, const std::function<void(unsigned, unsigned)>& func)
+    {
+        std::vector<unsigned> chunks((itemCount + chunkSize - 1) / chunkSize);
+        for (size_t c = 0; c < chunks.size(); ++c)
+            chunks[c] = static_cast<unsigned>(c);
+        auto chunkFunc = [&](const unsigned& c)
+        {
+            func(c * chunkSize, std::min(itemCount, (c + 1) * chunkSize));
+        };
+        if (multiThread)
+            QtConcurrent::blockingMap(chunks, chunkFunc);
+        else
+            std::for_each(chunks.begin(), chunks.end(), chunkFunc);
+    };
+    const unsigned count = compCloud->size();
+
+    //1) nearest reference point of each compared point
+    std::vector<unsigned> nearest;
+    try
+    {
+        nearest.resize(count, NEAREST_INDEX_NONE);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return CCCoreLib::DistanceComputationTools::ERROR_OUT_OF_MEMORY;
+    }
+    forEachChunk(count, [&](unsigned begin, unsigned end)
+    {
+        CCCoreLib::ReferenceCloud Yk(refCloud);
+        for (unsigned i = begin; i < end; ++i)
+        {
+            Yk.clear();
+            double maxSquareDist = 0;
+            if (refOctree->findPointNeighbourhood(compCloud->getPoint(i), &Yk, 1, level, maxSquareDist, maxSearchDist) > 0)
+                nearest[i] = Yk.getPointGlobalIndex(0);
+        }
+    });
+
+    //2) local planes of the reference points not in the cache yet
+    if (!useNormals)
+    {
+        std::vector<unsigned> toCompute;
+        {
+            std::vector<uint8_t> needed(refCloud->size(), 0);
+            for (unsigned idx : nearest)
+                if (idx != NEAREST_INDEX_NONE && cache->valid[idx] == 0 && !needed[idx])
+                {
+                    needed[idx] = 1;
+                    toCompute.push_back(idx);
+                }
+        }
+        CCTRACE("signed C2C: " << toCompute.size() << " new local models, " << cache->modelCount() << " in cache");
+        forEachChunk(static_cast<unsigned>(toCompute.size()), [&](unsigned begin, unsigned end)
+        {
+            CCCoreLib::ReferenceCloud Yk(refCloud);
+            for (unsigned t = begin; t < end; ++t)
+            {
+                unsigned idx = toCompute[t];
+                CCVector3 N;
+                Yk.clear();
+                double maxSquareDist = 0;
+                bool ok = (refOctree->findPointNeighbourhood(refCloud->getPoint(idx), &Yk, kNN, level, maxSquareDist) >= 3);
+                if (ok)
+                {
+                    CCCoreLib::Neighbourhood Z(&Yk);
+                    const PointCoordinateType* lsPlane = Z.getLSPlane();
+                    ok = (lsPlane != nullptr);
+                    if (ok)
+                    {
+                        N = CCVector3(lsPlane[0], lsPlane[1], lsPlane[2]);
+                        if (N.dot(preferredOrientation) < 0)
+                            N = -N;
+                    }
+                }
+                cache->normals[idx] = N;
+                cache->valid[idx] = ok ? 1 : 2;
+            }
+        });
+    }
+
+    //3) signed distance to the local plane of the nearest reference point
+    forEachChunk(count, [&](unsigned begin, unsigned end)
+    {
+        for (unsigned i = begin; i < end; ++i)
+        {
+            ScalarType dist = CCCoreLib::NAN_VALUE;
+            unsigned idx = nearest[i];
+            if (idx != NEAREST_INDEX_NONE)
+            {
+                CCVector3 PQ = *compCloud->getPoint(i) - *refCloud->getPoint(idx);
+                if (useNormals)
+                    dist = static_cast<ScalarType>(PQ.dot(refCloud->getPointNormal(idx)));
+                else if (cache->valid[idx] == 1)
+                    dist = static_cast<ScalarType>(PQ.dot(cache->normals[idx]));
+            }
+            sf->setValue(i, dist);
+        }
+    });
+
     sf->computeMinAndMax();
-    QString sfName = "C2M absolute distances";
-    if (params.signedDistances)
-        sfName = "C2M signed distances";
-    if (params.maxSearchDist > 0)
+    QString sfName = "C2C signed distances";
+    if (maxSearchDist > 0)
     {
-        sfName += QString("[<%1]").arg(params.maxSearchDist);
+        sfName += QString("[<%1]").arg(maxSearchDist);
     }
     sf->setName(qPrintable(sfName));
     return 1;
 }
 
+//! Symmetric distances between two entities: both directions, with their statistics
+struct SymmetricDistanceReport
+{
+    DistanceStatistics statsAB;     //!< distances from A to B (on A points)
+    DistanceStatistics statsBA;     //!< distances from B to A (on B points)
+    double hausdorff = std::numeric_limits<double>::quiet_NaN();
+    double rmsAB = std::numeric_limits<double>::quiet_NaN();
+    double rmsBA = std::numeric_limits<double>::quiet_NaN();
+    double rms = std::numeric_limits<double>::quiet_NaN(); //!< RMS of all the distances of both directions
+    int sfIndexA = -1;              //!< index of the scalar field on A (cloud or mesh vertices)
+    int sfIndexB = -1;              //!< index of the scalar field on B (cloud or mesh vertices)
+};
+
+//! the points of an entity: the cloud itself, or the vertices of a mesh
+static ccPointCloud* entityPoints(ccHObject* entity)
+{
+    if (ccMesh* mesh = ccHObjectCaster::ToMesh(entity))
+        return ccHObjectCaster::ToPointCloud(mesh->getAssociatedCloud());
+    return ccHObjectCaster::ToPointCloud(entity);
+}
+
+SymmetricDistanceReport computeSymmetricDistances_py(ccHObject* entityA,
+                                                     ccHObject* entityB,
+                                                     unsigned char octreeLevel = 0,
+                                                     double maxSearchDist = 0,
+                                                     unsigned nbBins = 64,
+                                                     std::vector<double> percentiles = { 50, 95, 99 },
+                                                     bool multiThread = true,
+                                                     int maxThreadCount = 0)
+{
+    ccPointCloud* pointsA = entityPoints(entityA);
+    ccPointCloud* pointsB = entityPoints(entityB);
+    if (!pointsA || !pointsB)
+        throw std::invalid_argument("entities must be point clouds or meshes");
+    if (pointsA == pointsB)
+        throw std::invalid_argument("the two entities share the same points");
+    ccMesh* meshA = ccHObjectCaster::ToMesh(entityA);
+    ccMesh* meshB = ccHObjectCaster::ToMesh(entityB);
+
+    //cloud/cloud: both octrees built once, on the same bounding box, used for both directions
+    CCCoreLib::DgmOctree* octreeA = nullptr;
+    CCCoreLib::DgmOctree* octreeB = nullptr;
+    if (!meshA && !meshB)
+    {
+        if (CCCoreLib::DistanceComputationTools::synchronizeOctrees(pointsA, pointsB, octreeA, octreeB)
+            != CCCoreLib::DistanceComputationTools::SYNCHRONIZED)
+        {
+            delete octreeA;
+            delete octreeB;
+            throw std::runtime_error("failed to build the octrees");
+        }
+    }
+
+    //best octree level of a direction, estimated from approximate distances to this reference: the temporary
+    //"Approx. distances" scalar field is removed, a former one (other reference?) is set aside meanwhile
+    auto bestLevelFromApproxDistances = [](ccPointCloud* cloud, CCCoreLib::GenericIndexedMesh* mesh,
+                                           ccPointCloud* refCloud, double maxDist) -> unsigned char
+    {
+        CCCoreLib::ScalarField* formerSF = nullptr;
+        int formerIdx = cloud->getScalarFieldIndexByName("Approx. distances");
+        if (formerIdx >= 0)
+        {
+            formerSF = cloud->getScalarField(formerIdx);
+            formerSF->setName("Approx. distances (former)");
+        }
+        int best = determineBestOctreeLevel_py(cloud, mesh, refCloud, maxDist);
+        int approxIdx = cloud->getScalarFieldIndexByName("Approx. distances");
+        if (approxIdx >= 0)
+            cloud->deleteScalarField(approxIdx);
+        if (formerSF)
+            formerSF->setName("Approx. distances");
+        return static_cast<unsigned char>(best > 0 ? best : 7);
+    };
+
+    //parameters of each direction
+    CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams c2cParams[2];
+    CCCoreLib::DistanceComputationTools::Cloud2MeshDistancesComputationParams c2mParams[2];
+    ccPointCloud* compared[2] = { pointsA, pointsB };
+    ccPointCloud* refPoints[2] = { pointsB, pointsA };
+    ccMesh* refMesh[2] = { meshB, meshA };
+    CCCoreLib::DgmOctree* compOctrees[2] = { octreeA, octreeB };
+    CCCoreLib::DgmOctree* refOctrees[2] = { octreeB, octreeA };
+    for (int dir = 0; dir < 2; ++dir)
+    {
+        unsigned char level = octreeLevel;
+        if (refMesh[dir])
+        {
+            if (level == 0)
+                level = bestLevelFromApproxDistances(compared[dir], refMesh[dir], nullptr, maxSearchDist);
+            c2mParams[dir].octreeLevel = level;
+            c2mParams[dir].maxSearchDist = static_cast<PointCoordinateType>(maxSearchDist);
+            c2mParams[dir].multiThread = multiThread;
+            c2mParams[dir].maxThreadCount = maxThreadCount;
+        }
+        else
+        {
+            if (level == 0)
+            {
+                if (compOctrees[dir])
+                    level = compOctrees[dir]->findBestLevelForComparisonWithOctree(refOctrees[dir]);
+                else
+                    level = bestLevelFromApproxDistances(compared[dir], nullptr, refPoints[dir], maxSearchDist);
+            }
+            c2cParams[dir].octreeLevel = level;
+            c2cParams[dir].maxSearchDist = static_cast<PointCoordinateType>(maxSearchDist);
+            c2cParams[dir].multiThread = multiThread;
+            c2cParams[dir].maxThreadCount = maxThreadCount;
+        }
+    }
+
+    //the directions run one after the other, each one multithreaded: the CCCoreLib parallel
+    //octree traversal relies on static data, two traversals must not run at the same time
+    int ret[2] = { 0, 0 };
+    for (int dir = 0; dir < 2; ++dir)
+    {
+        if (refMesh[dir])
+            ret[dir] = computeCloud2MeshDistances_py(compared[dir], refMesh[dir], c2mParams[dir]);
+        else
+            ret[dir] = computeCloud2CloudDistances_py(compared[dir], refPoints[dir], c2cParams[dir],
+                                                      nullptr, compOctrees[dir], refOctrees[dir]);
+        if (ret[dir] <= 0)
+            break;
+    }
+    delete octreeA;
+    delete octreeB;
+    if (ret[0] <= 0 || ret[1] <= 0)
+        throw std::runtime_error(QString("distance computation failed, return codes: %1, %2").arg(ret[0]).arg(ret[1]).toStdString());
+
+    SymmetricDistanceReport report;
+    report.sfIndexA = pointsA->getCurrentInScalarFieldIndex();
+    report.sfIndexB = pointsB->getCurrentInScalarFieldIndex();
+    for (DistanceStatistics* stats : { &report.statsAB, &report.statsBA })
+    {
+        stats->nbBins = nbBins;
+        stats->percentileLevels = percentiles;
+    }
+    computeDistanceStatistics(pointsA->getScalarField(report.sfIndexA), report.statsAB, multiThread);
+    computeDistanceStatistics(pointsB->getScalarField(report.sfIndexB), report.statsBA, multiThread);
+
+    const DistanceStatistics& ab = report.statsAB;
+    const DistanceStatistics& ba = report.statsBA;
+    report.hausdorff = std::max(ab.max, ba.max);
+    report.rmsAB = sqrt(ab.variance + ab.mean * ab.mean);
+    report.rmsBA = sqrt(ba.variance + ba.mean * ba.mean);
+    if (ab.count + ba.count > 0)
+        report.rms = sqrt((ab.count * report.rmsAB * report.rmsAB + ba.count * report.rmsBA * report.rmsBA) / (ab.count + ba.count));
+    CCTRACE("symmetric distances, Hausdorff: " << report.hausdorff << " RMS: " << report.rms);
+    return report;
+}
+
 int determineBestOctreeLevel_py(ccPointCloud* compCloud,
-                                CCCoreLib::GenericIndexedMesh* refMesh=nullptr,
-                                ccPointCloud* refCloud=nullptr,
-                                double maxSearchDist=0.)
+                                CCCoreLib::GenericIndexedMesh* refMesh,
+                                ccPointCloud* refCloud,
+                                double maxSearchDist)
 {
     // adapted from ccComparisonDlg::determineBestOctreeLevel
     if ((refMesh == nullptr && refCloud == nullptr) || (refMesh != nullptr && refCloud != nullptr))
@@ -322,6 +2295,35 @@ int determineBestOctreeLevel_py(ccPointCloud* compCloud,
         return -1;
     }
 
+    ccOctree::Shared refOctree = nullptr;
+    if (refCloud)
+    {
+        refOctree = refCloud->getOctree();
+        if (!refOctree)
+        {
+            //CCTRACE("compute octree for ref cloud...")
+            refOctree = refCloud->computeOctree();
+        }
+    }
+    ccOctree::Shared compOctree = nullptr;
+    compOctree = compCloud->getOctree();
+    if (!compOctree)
+    {
+        CCTRACE("Strange, octree should be computed here...")
+        compOctree = compCloud->computeOctree();
+    }
+    if (!compOctree)
+        return -1;
+    return bestOctreeLevelFromApproxDistances(compOctree.data(), approxDistances, refMesh, refOctree.data(), maxSearchDist);
+}
+
+//! best octree level from the approximate distances of the points of the compared cloud
+static int bestOctreeLevelFromApproxDistances(const CCCoreLib::DgmOctree* compOctree,
+                                              const CCCoreLib::ScalarField* approxDistances,
+                                              CCCoreLib::GenericIndexedMesh* refMesh,
+                                              const CCCoreLib::DgmOctree* refOctree,
+                                              double maxSearchDist)
+{
     //evalutate the theoretical time for each octree level
     const int MAX_OCTREE_LEVEL = refMesh ? 9 : CCCoreLib::DgmOctree::MAX_OCTREE_LEVEL; //DGM: can't go higher than level 9 with a mesh as the grid is 'plain' and would take too much memory!
     std::vector<double> timings;
@@ -338,16 +2340,6 @@ int determineBestOctreeLevel_py(ccPointCloud* compCloud,
     //if the reference is a mesh
     double meanTriangleSurface = 1.0;
     CCCoreLib::GenericIndexedMesh* mesh = nullptr;
-    ccOctree::Shared refOctree = nullptr;
-    if (refCloud)
-    {
-        refOctree = refCloud->getOctree();
-        if (!refOctree)
-        {
-            //CCTRACE("compute octree for ref cloud...")
-            refOctree = refCloud->computeOctree();
-        }
-    }
     if (!refOctree)
     {
         if (!refMesh)
@@ -381,14 +2373,6 @@ int determineBestOctreeLevel_py(ccPointCloud* compCloud,
 
     uint64_t maxNeighbourhoodVolume = static_cast<uint64_t>(1) << (3 * MAX_OCTREE_LEVEL);
 
-    ccOctree::Shared compOctree = nullptr;
-    compOctree = compCloud->getOctree();
-    if (!compOctree)
-    {
-        CCTRACE("Strange, octree should be computed here...")
-        compOctree = compCloud->computeOctree();
-    }
-
     //for each level
     for (int level = s_minOctreeLevel; level < MAX_OCTREE_LEVEL; ++level)
     {
@@ -469,7 +2453,7 @@ int determineBestOctreeLevel_py(ccPointCloud* compCloud,
                 cellDist = 0;
                 tempCode = truncatedCode;
             }
-            ScalarType pointDist = approxDistances->getValue(index);
+            ScalarType pointDist = approxDistances->getValue(c->theIndex);
             if (maxDistanceDefined && pointDist > maxDistance)
             {
                 pointDist = maxDistance;
@@ -534,6 +2518,65 @@ void export_distanceComputationTools(py::module &m0)
     py::class_<CCCoreLib::GenericProgressCallback, PyGenericProgressCallback>(m0, "GenericProgressCallback")
         ;
 
+    py::class_<DistanceStatistics>(m0, "DistanceStatistics", distanceComputationToolsPy_DistanceStatistics_doc)
+        .def(py::init([](unsigned nbBins, std::vector<double> percentiles, double histoMin, double histoMax)
+                      {
+                          DistanceStatistics* stats = new DistanceStatistics;
+                          stats->nbBins = nbBins;
+                          stats->percentileLevels = percentiles;
+                          stats->histoMin = histoMin;
+                          stats->histoMax = histoMax;
+                          return stats;
+                      }),
+             py::arg("nbBins")=64, py::arg("percentiles")=std::vector<double>(),
+             py::arg("histoMin")=0., py::arg("histoMax")=0.,
+             distanceComputationToolsPy_DistanceStatistics_ctor_doc)
+        .def("computeFromScalarField",
+             [](DistanceStatistics& self, CCCoreLib::ScalarField* sf, bool multiThread)
+             {
+                 if (sf == nullptr)
+                     throw std::invalid_argument("null scalar field");
+                 computeDistanceStatistics(sf, self, multiThread);
+                 sf->computeMinAndMax();
+             },
+             py::arg("sf"), py::arg("multiThread")=true,
+             distanceComputationToolsPy_DistanceStatistics_computeFromScalarField_doc)
+        .def_readwrite("nbBins", &DistanceStatistics::nbBins)
+        .def_readwrite("histoMin", &DistanceStatistics::histoMin)
+        .def_readwrite("histoMax", &DistanceStatistics::histoMax)
+        .def_readwrite("percentileLevels", &DistanceStatistics::percentileLevels)
+        .def_readonly("count", &DistanceStatistics::count)
+        .def_readonly("underflow", &DistanceStatistics::underflow)
+        .def_readonly("overflow", &DistanceStatistics::overflow)
+        .def_readonly("min", &DistanceStatistics::min)
+        .def_readonly("max", &DistanceStatistics::max)
+        .def_readonly("mean", &DistanceStatistics::mean)
+        .def_readonly("variance", &DistanceStatistics::variance)
+        .def_property_readonly("histogram", [](const DistanceStatistics& self)
+                               { return py::array_t<uint64_t>(self.histogram.size(), self.histogram.data()); })
+        .def_property_readonly("binEdges", [](const DistanceStatistics& self)
+                               { return py::array_t<double>(self.binEdges.size(), self.binEdges.data()); })
+        .def_property_readonly("percentiles", [](const DistanceStatistics& self)
+                               { return py::array_t<double>(self.percentiles.size(), self.percentiles.data()); })
+        ;
+
+    py::class_<LocalModelCache>(m0, "LocalModelCache", distanceComputationToolsPy_LocalModelCache_doc)
+        .def(py::init<>(), distanceComputationToolsPy_LocalModelCache_ctor_doc)
+        .def("clear", &LocalModelCache::clear, distanceComputationToolsPy_LocalModelCache_clear_doc)
+        .def("modelCount", &LocalModelCache::modelCount, distanceComputationToolsPy_LocalModelCache_modelCount_doc)
+        ;
+
+    py::class_<SymmetricDistanceReport>(m0, "SymmetricDistanceReport", distanceComputationToolsPy_SymmetricDistanceReport_doc)
+        .def_readonly("statsAB", &SymmetricDistanceReport::statsAB)
+        .def_readonly("statsBA", &SymmetricDistanceReport::statsBA)
+        .def_readonly("hausdorff", &SymmetricDistanceReport::hausdorff)
+        .def_readonly("rmsAB", &SymmetricDistanceReport::rmsAB)
+        .def_readonly("rmsBA", &SymmetricDistanceReport::rmsBA)
+        .def_readonly("rms", &SymmetricDistanceReport::rms)
+        .def_readonly("sfIndexA", &SymmetricDistanceReport::sfIndexA)
+        .def_readonly("sfIndexB", &SymmetricDistanceReport::sfIndexB)
+        ;
+
     py::class_<CCCoreLib::DistanceComputationTools::Cloud2CloudDistancesComputationParams>(m0, "Cloud2CloudDistancesComputationParams",
                                                                      distanceComputationToolsPy_Cloud2CloudDistancesComputationParams_doc)
         .def(py::init<>(), distanceComputationToolsPy_Cloud2CloudDistancesComputationParams_ctor_doc)
@@ -597,11 +2640,69 @@ void export_distanceComputationTools(py::module &m0)
                     py::arg("compOctree")=nullptr,
                     py::arg("refOctree")=nullptr,
                     distanceComputationToolsPy_computeCloud2CloudDistances_doc)
+        .def_static("computeCloud2CloudDistancesTiled",
+                    &computeCloud2CloudDistancesTiled_py,
+                    py::arg("comparedCloud"), py::arg("referenceCloud"), py::arg("params"),
+                    py::arg("tileSize"),
+                    py::arg("progressCb")=nullptr,
+                    distanceComputationToolsPy_computeCloud2CloudDistancesTiled_doc)
+        .def_static("computeCloud2CloudDistancesWithIndexes",
+                    &computeCloud2CloudDistancesWithIndexes_py,
+                    py::arg("comparedCloud"), py::arg("referenceCloud"), py::arg("params"),
+                    py::arg("progressCb")=nullptr,
+                    py::arg("compOctree")=nullptr,
+                    py::arg("refOctree")=nullptr,
+                    distanceComputationToolsPy_computeCloud2CloudDistancesWithIndexes_doc)
+        .def_static("computeCloud2CloudSignedDistances",
+                    &computeCloud2CloudSignedDistances_py,
+                    py::arg("comparedCloud"), py::arg("referenceCloud"),
+                    py::arg("maxSearchDist")=0,
+                    py::arg("useNormals")=true,
+                    py::arg("kNN")=12,
+                    py::arg("preferredOrientation")=CCVector3(0,0,1),
+                    py::arg("cache")=nullptr,
+                    py::arg("multiThread")=true,
+                    py::arg("progressCb")=nullptr,
+                    distanceComputationToolsPy_computeCloud2CloudSignedDistances_doc)
+        .def_static("computeCloud2CloudWithinTolerance",
+                    &computeCloud2CloudWithinTolerance_py,
+                    py::arg("comparedCloud"), py::arg("referenceCloud"), py::arg("tolerance"),
+                    py::arg("multiThread")=true,
+                    py::arg("maxThreadCount")=0,
+                    py::arg("progressCb")=nullptr,
+                    distanceComputationToolsPy_computeCloud2CloudWithinTolerance_doc)
+        .def_static("computeCloud2MeshWithinTolerance",
+                    &computeCloud2MeshWithinTolerance_py,
+                    py::arg("pointCloud"), py::arg("mesh"), py::arg("tolerance"),
+                    py::arg("multiThread")=true,
+                    py::arg("maxThreadCount")=0,
+                    py::arg("progressCb")=nullptr,
+                    distanceComputationToolsPy_computeCloud2MeshWithinTolerance_doc)
+        .def_static("computeSymmetricDistances",
+                    &computeSymmetricDistances_py,
+                    py::arg("entityA"), py::arg("entityB"),
+                    py::arg("octreeLevel")=0,
+                    py::arg("maxSearchDist")=0,
+                    py::arg("nbBins")=64,
+                    py::arg("percentiles")=std::vector<double>{50, 95, 99},
+                    py::arg("multiThread")=true,
+                    py::arg("maxThreadCount")=0,
+                    distanceComputationToolsPy_computeSymmetricDistances_doc)
+        .def_static("computeCloud2MultiCloudDistances",
+                    &computeCloud2MultiCloudDistances_py,
+                    py::arg("comparedCloud"), py::arg("referenceClouds"),
+                    py::arg("octreeLevel")=0,
+                    py::arg("maxSearchDist")=0,
+                    py::arg("multiThread")=true,
+                    py::arg("maxThreadCount")=0,
+                    py::arg("progressCb")=nullptr,
+                    distanceComputationToolsPy_computeCloud2MultiCloudDistances_doc)
         .def_static("computeCloud2MeshDistances",
                     &computeCloud2MeshDistances_py,
                     py::arg("pointCloud"), py::arg("mesh"), py::arg("params"),
                     py::arg("progressCb")=nullptr,
                     py::arg("cloudOctree")=nullptr,
+                    py::arg("useBatchKernel")=false,
                     distanceComputationToolsPy_computeCloud2MeshDistances_doc)
         .def_static("computeApproxCloud2CloudDistance",
                     &computeApproxCloud2CloudDistance_py,
@@ -610,9 +2711,17 @@ void export_distanceComputationTools(py::module &m0)
                     py::arg("progressCb")=nullptr,
                     py::arg("compOctree")=nullptr,
                     py::arg("refOctree")=nullptr,
+                    py::arg("stats")=nullptr,
                     distanceComputationToolsPy_computeApproxCloud2CloudDistance_doc)
         .def_static("computeApproxCloud2MeshDistance",
                     &computeApproxCloud2MeshDistance_py,
+                    py::arg("pointCloud"), py::arg("mesh"), py::arg("octreeLevel")=7,
+                    py::arg("maxSearchDist")=0,
+                    py::arg("multiThread")=true,
+                    py::arg("maxThreadCount")=0,
+                    py::arg("progressCb")=nullptr,
+                    py::arg("cloudOctree")=nullptr,
+                    py::arg("stats")=nullptr,
                     distanceComputationToolsPy_computeApproxCloud2MeshDistance_doc)
         .def_static("determineBestOctreeLevel",
                     &determineBestOctreeLevel_py,
@@ -162,6 +162,229 @@ determination of the Closest Point Set (Cloud2CloudDistanceComputationParams::CP
 :return: >0 if ok, a negative value otherwise
 :rtype: int )";
 
+const char* distanceComputationToolsPy_computeCloud2CloudDistancesTiled_doc= R"(
+Computes the "nearest neighbour distance" between two point clouds, tile by tile, with a bounded memory footprint.
+
+The bounding box of the compared cloud is split in cubical tiles. For each non empty tile, the distances
+are computed between the compared points of the tile and the reference points of the tile enlarged by
+the max search distance, with octrees limited to these points. The distances are written in the
+scalar field of the compared cloud as the tiles are processed, the octrees of a tile are released before
+the next tile. Only the octrees of one tile are in memory at a time, instead of the octrees of the whole clouds.
+
+The tiles are gathered in slabs along the longest dimension of the grid. Both clouds are sorted by slab
+once (one 32 bits index per point, reference points out of reach of the compared bounding box excluded),
+then each slab is processed from its points only: the sort by tile of a slab is released before the next slab.
+The time is linear in the number of points (plus the distance computations), whatever the number of slabs.
+
+**Memory limit** the tiling bounds the octrees memory, not the clouds one: both clouds must be entirely
+in memory (or accessible through a GenericIndexedCloudPersist implementation), with 4 bytes per point
+for the slab sort, plus the tile sort of the largest slab.
+
+As the tile margin is the max search distance, the result is identical to :py:meth:`computeCloud2CloudDistances`
+with the same max search distance.
+
+**WARNING** Cloud2CloudDistanceComputationParams::maxSearchDist must be > 0.
+Local models, split distances and Closest Point Set are not available in this mode.
+If Cloud2CloudDistanceComputationParams::octreeLevel is 0, the best level is determined for each tile.
+
+:param GenericIndexedCloudPersist comparedCloud: the compared cloud
+       (the distances will be computed on these points)
+:param GenericIndexedCloudPersist referenceCloud: the reference cloud
+       (the distances will be computed relatively to these points)
+:param Cloud2CloudDistancesComputationParams params: distance computation parameters
+:param float tileSize: the edge length of the cubical tiles
+:param GenericProgressCallback,optional progressCb: the client application can get some notification
+       of the process progress through this callback mechanism (see GenericProgressCallback)
+       default None.
+
+:return: >0 if ok, a negative value otherwise: -1 for invalid parameters (max search distance or tile size
+         not positive, too many tiles, local model, split distances or Closest Point Set requested),
+         a DistanceComputationTools error code otherwise.
+:rtype: int )";
+
+const char* distanceComputationToolsPy_computeCloud2CloudDistancesWithIndexes_doc= R"(
+Computes the "nearest neighbour distance" between two point clouds (see :py:meth:`computeCloud2CloudDistances`),
+and returns also, for each point of the compared cloud, the index of its nearest point in the reference cloud.
+
+The indexes can be used for attribute transfer, correspondence based registration, change labelling...
+without a second neighbour search.
+
+Without max search distance, the indexes are given by the Closest Point Set of the standard computation
+(all the options of the parameters are available, but with a local model, the index is the one of the nearest
+reference point, not a point of the local model).
+With a max search distance, the search is done in a dedicated parallel pass (local models and split distances
+are not available in this case) and the points without reference point within the max search distance get
+the index 4294967295 (0xFFFFFFFF).
+
+:param GenericIndexedCloudPersist comparedCloud: the compared cloud
+       (the distances will be computed on these points)
+:param GenericIndexedCloudPersist referenceCloud: the reference cloud
+       (the distances will be computed relatively to these points)
+:param Cloud2CloudDistancesComputationParams params: distance computation parameters
+:param GenericProgressCallback,optional progressCb: (default None) the client method for progress bar
+:param DgmOctree,optional compOctree: the pre-computed octree of the compared cloud
+       (warning: both octrees must have the same cubical bounding-box - it is automatically computed if 0)
+:param DgmOctree,optional refOctree: the pre-computed octree of the reference cloud
+       (warning: both octrees must have the same cubical bounding-box - it is automatically computed if 0)
+
+:return: a tuple (return code, indexes): return code >0 if ok, a negative value otherwise,
+         indexes: Numpy array of uint32, one per point of the compared cloud (None if problem)
+:rtype: tuple )";
+
+const char* distanceComputationToolsPy_LocalModelCache_doc= R"(
+Cache of the local models (oriented normals of fitted planes) of a reference cloud,
+for :py:meth:`DistanceComputationTools.computeCloud2CloudSignedDistances` with useNormals = `False`.
+With useNormals = `True`, the reference normals are used directly and the cache is ignored (nothing to compute).
+
+The local models are computed on demand, only for the reference points that are the nearest neighbour of a compared point,
+and kept for the next calls with the same reference cloud and the same settings (kNN, preferredOrientation).
+The cache is reset automatically if the reference cloud or the settings change: the cache key is the cloud
+unique ID and size, its octree, its bounding box and a hash of a sample of its points, plus the settings.
+A modification of the reference points that keeps the bounding box and the octree, and does not
+touch the sampled points (one point out of size/4096), is not detected: in this case, call :py:meth:`clear`.
+)";
+
+const char* distanceComputationToolsPy_LocalModelCache_ctor_doc= R"(
+Creates an empty cache.
+)";
+
+const char* distanceComputationToolsPy_LocalModelCache_clear_doc= R"(
+Removes all the local models from the cache.
+)";
+
+const char* distanceComputationToolsPy_LocalModelCache_modelCount_doc= R"(
+Returns the number of local models in the cache.
+
+:return: the number of local models
+:rtype: int )";
+
+const char* distanceComputationToolsPy_computeCloud2CloudSignedDistances_doc= R"(
+Computes signed distances between two point clouds, using the normals of the reference cloud, or fitted local planes.
+
+For each point P of the compared cloud, the nearest point Q of the reference cloud is searched,
+and the signed distance is the distance from P to the local plane at Q: (P - Q).N,
+where N is the normal of the reference point Q (useNormals = `True`), or the normal of the least square plane
+fitted on the kNN nearest neighbours of Q, oriented toward the preferred orientation.
+
+The local planes are fitted only for the reference points that are the nearest neighbour of a compared point,
+in parallel. With a :py:class:`LocalModelCache`, they are kept for the next calls with the same reference cloud
+(typically, several epochs compared to a fixed reference). The cache only helps with fitted planes:
+with useNormals = `True` it is not used. The octree of the reference cloud is kept with the cloud.
+
+The scalar field is named "C2C signed distances", with the "[<maxSearchDist]" suffix if a max search distance is given.
+Points without reference point within the max search distance, or without valid local model, get NaN.
+
+:param ccPointCloud comparedCloud: the compared cloud
+       (the distances will be computed on these points)
+:param ccPointCloud referenceCloud: the reference cloud
+:param float,optional maxSearchDist: (default 0) max search distance (0 = no limit)
+:param bool,optional useNormals: (default `True`) use the reference cloud normals (required), otherwise fit local planes
+:param int,optional kNN: (default 12) number of neighbours for the local planes
+:param tuple,optional preferredOrientation: (default (0,0,1)) orientation of the fitted local planes normals
+:param LocalModelCache,optional cache: (default None) cache of the local planes, to reuse in the next calls
+       (ignored with useNormals = `True`)
+:param bool,optional multiThread: (default `True`) use several threads
+:param GenericProgressCallback,optional progressCb: (default None) the client method for progress bar
+
+:return: >0 if ok, a negative value otherwise
+:rtype: int )";
+
+const char* distanceComputationToolsPy_computeCloud2CloudWithinTolerance_doc= R"(
+Classifies the points of a cloud: within a tolerance of a reference cloud or not.
+
+Faster than computing the distances and thresholding them: the octree level is chosen so that only
+the neighbour cells are searched, the reference points of these cells are gathered once per cell,
+and the search stops at the first reference point found within the tolerance. No scalar field is created.
+
+:param GenericIndexedCloudPersist comparedCloud: the compared cloud
+:param GenericIndexedCloudPersist referenceCloud: the reference cloud
+:param float tolerance: the distance threshold (a point at a distance <= tolerance is within the tolerance)
+:param bool,optional multiThread: (default `True`) use several threads
+:param int,optional maxThreadCount: (default 0 = max) maximum number of threads to use
+:param GenericProgressCallback,optional progressCb: (default None) the client method for progress bar
+
+:return: a Numpy array of uint8, one per point of the compared cloud: 1 if within the tolerance, 0 otherwise
+:rtype: ndarray )";
+
+const char* distanceComputationToolsPy_computeCloud2MeshWithinTolerance_doc= R"(
+Classifies the points of a cloud: within a tolerance of a mesh or not.
+
+The triangles within the tolerance of each octree cell are gathered once per cell, and evaluated with
+the batched point to triangle kernel (see :py:meth:`computeCloud2MeshDistances` with `useBatchKernel`),
+the search stops at the first group of triangles with a triangle within the tolerance. No scalar field is created.
+
+:param GenericIndexedCloudPersist pointCloud: the compared cloud
+:param GenericIndexedMesh mesh: the reference mesh
+:param float tolerance: the distance threshold (a point at a distance <= tolerance is within the tolerance)
+:param bool,optional multiThread: (default `True`) use several threads
+:param int,optional maxThreadCount: (default 0 = max) maximum number of threads to use
+:param GenericProgressCallback,optional progressCb: (default None) the client method for progress bar
+
+:return: a Numpy array of uint8, one per point of the cloud: 1 if within the tolerance, 0 otherwise
+:rtype: ndarray )";
+
+const char* distanceComputationToolsPy_SymmetricDistanceReport_doc= R"(
+Result of :py:meth:`DistanceComputationTools.computeSymmetricDistances`: the distances in both directions
+between two entities A and B, with their statistics.
+
+- statsAB: :py:class:`DistanceStatistics` of the distances from the points of A to B
+- statsBA: :py:class:`DistanceStatistics` of the distances from the points of B to A
+- hausdorff: the Hausdorff distance, max(statsAB.max, statsBA.max)
+- rmsAB, rmsBA: root mean square of the distances of each direction
+- rms: root mean square of all the distances of both directions
+- sfIndexA, sfIndexB: indexes of the distance scalar fields on A and B (on the vertices for a mesh)
+)";
+
+const char* distanceComputationToolsPy_computeSymmetricDistances_doc= R"(
+Computes the distances from A to B and from B to A in one call, and the symmetric distance report
+(Hausdorff distance, RMS, histograms and percentiles of both directions).
+
+Each entity is a point cloud or a mesh. The distances are computed on the points of each entity
+(the vertices for a mesh), to the other entity: cloud to cloud or cloud to mesh distances,
+stored in the usual scalar fields ("C2C absolute distances" or "C2M absolute distances").
+Between two clouds, the two octrees are built once, on a common bounding box, and used for both directions.
+Each direction is computed with several threads (multiThread), the directions one after the other.
+With the automatic octree level, the temporary "Approx. distances" scalar field used for the estimation is removed.
+
+:param ccHObject entityA: the first entity (ccPointCloud or ccMesh)
+:param ccHObject entityB: the second entity (ccPointCloud or ccMesh)
+:param int,optional octreeLevel: (default 0) the octree level, 0 = automatic (for each direction)
+:param float,optional maxSearchDist: (default 0) max search distance (0 = no limit).
+       With a limit, the Hausdorff distance is only reliable if it is below the limit.
+:param int,optional nbBins: (default 64) number of bins of the histograms
+:param list,optional percentiles: (default [50, 95, 99]) percentile levels, in [0, 100]
+:param bool,optional multiThread: (default `True`) use several threads
+:param int,optional maxThreadCount: (default 0 = max) maximum number of threads to use
+
+:return: the report
+:rtype: SymmetricDistanceReport )";
+
+const char* distanceComputationToolsPy_computeCloud2MultiCloudDistances_doc= R"(
+Computes the "nearest neighbour distance" between a point cloud and several reference clouds, in a single traversal.
+
+The octrees of the compared cloud and of all the reference clouds share the same bounding box:
+the compared octree is traversed once (in parallel), and for each cell, the neighbour search structure
+of each reference is set once and shared by all the points of the cell.
+One scalar field is created (or reused) per reference, named "C2C absolute distances (#<reference index> <reference name>)",
+with the "[<maxSearchDist]" suffix if a max search distance is given: references with the same name get distinct scalar fields.
+Points without reference point within the max search distance get the max search distance.
+
+Local models and split distances are not available with this method,
+use :py:meth:`computeCloud2CloudDistances` for those.
+
+:param ccPointCloud comparedCloud: the compared cloud
+       (the distances will be computed on these points)
+:param list referenceClouds: the list of reference clouds
+:param int,optional octreeLevel: (default 0) the octree level, 0 = automatic
+:param float,optional maxSearchDist: (default 0) max search distance (0 = no limit).
+       It also limits the reference octrees to the points in reach of the compared cloud.
+:param bool,optional multiThread: (default `True`) use several threads
+:param int,optional maxThreadCount: (default 0 = max) maximum number of threads to use
+:param GenericProgressCallback,optional progressCb: (default None) the client method for progress bar
+
+:return: the list of the scalar field indexes on the compared cloud, one per reference (empty list if problem)
+:rtype: list )";
+
 const char* distanceComputationToolsPy_computeCloud2MeshDistances_doc= R"(
 Computes the distance between a point cloud and a mesh.
 
@@ -183,10 +406,52 @@ It is the general way to compare a point cloud with a triangular mesh.
 :param DgmOctree,optional cloudOctree: the pre-computed octree of the compared cloud
        (warning: its bounding box should be equal to the union of both point cloud
        and mesh bbs and it should be cubical - it is automatically computed if 0)
+:param bool,optional useBatchKernel: (default `False`) use the batched point to triangle kernel:
+       the triangles are gathered by groups around each octree cell, and evaluated for all the points
+       of the cell with a vectorized kernel (multithreaded, including with a max search distance).
+       Only for unsigned distances, without distance map nor Closest Point Set.
+       If params.octreeLevel is 0, a level is chosen for about 16 points per cell.
 
 :return: >0 if ok, a negative value otherwise
 :rtype: int )";
 
+const char* distanceComputationToolsPy_DistanceStatistics_doc= R"(
+Statistics of a distance scalar field: number of valid values, min, max, mean, variance,
+histogram (Numpy arrays `histogram` and `binEdges`) and percentiles (Numpy array `percentiles`,
+one value per requested level in `percentileLevels`).
+
+The statistics are computed in parallel passes over the values, with partial results per chunk
+of values merged at the end. The min and max are accumulated with the moments, the automatic histogram range
+does not rely on the scalar field min and max. With a given histogram range (histoMin, histoMax),
+everything is computed in a single pass. With the automatic range, the histogram is deferred to a second pass,
+once the min and max are known.
+
+The values out of a given histogram range are not in the histogram, they are counted in `underflow`
+and `overflow`: the percentiles are those of all the valid values, not only of the values in the histogram range.
+The percentiles are interpolated in the histogram bins: their precision is the bin width.
+Percentiles below histoMin (resp. above histoMax) are interpolated between min and histoMin
+(resp. histoMax and max), and are only coarse approximations.
+
+Attributes `count, underflow, overflow, min, max, mean, variance, histogram, binEdges, percentiles` are read only.
+)";
+
+const char* distanceComputationToolsPy_DistanceStatistics_ctor_doc= R"(
+Defines the statistics to compute.
+
+:param int,optional nbBins: (default 64) number of histogram bins
+:param list,optional percentiles: (default []) percentile levels, in [0, 100], for instance [50, 95, 99]
+:param float,optional histoMin: (default 0) histogram lower bound
+:param float,optional histoMax: (default 0) histogram upper bound.
+       If histoMax <= histoMin, the range is the min, max of the values.
+)";
+
+const char* distanceComputationToolsPy_DistanceStatistics_computeFromScalarField_doc= R"(
+Computes the statistics of a scalar field (NaN values are ignored), and updates the scalar field min and max.
+
+:param ScalarField sf: the scalar field
+:param bool,optional multiThread: (default `True`) use several threads
+)";
+
 const char* distanceComputationToolsPy_computeApproxCloud2CloudDistance_doc= R"(
 Computes approximate distances between two point clouds.
 
@@ -209,6 +474,9 @@ the result will be (but more memory and time will be needed).
 :param DgmOctree,optional refOctree: the pre-computed octree of the reference cloud
        (warning: both octrees must have the same cubical bounding-box - it is automatically computed if 0)
 
+:param DistanceStatistics,optional stats: (default None) if given, filled with the statistics of the
+       distances (moments, histogram, percentiles), see :py:class:`DistanceStatistics`.
+
 :return: a list of statistics (min, max, mean, variance, max error) or an empty list if problem
 :rtype: list )";
 
@@ -221,6 +489,20 @@ an approximate distance between this node and the other cloud.
 :param GenericIndexedCloudPersist pointCloud: the compared cloud
        (the distances will be computed on these points)
 :param GenericIndexedMesh mesh: the reference mesh
+:param int,optional octreeLevel: (default 7) the octree level at which to compute the distance map.
+       If 0, a first pass is done at level 7, and the best level is estimated from its distances
+       (as :py:meth:`determineBestOctreeLevel`, with the same octree).
+       A second pass is done only if the best level is finer than 7, else the distances of the first pass are kept.
+:param float,optional maxSearchDist: (default 0) max search distance (0 = no limit)
+:param bool,optional multiThread: (default `True`) use several threads
+:param int,optional maxThreadCount: (default 0 = max) maximum number of threads to use
+:param GenericProgressCallback,optional progressCb: (default None) the client method for progress bar
+:param DgmOctree,optional cloudOctree: (default None) the pre-computed octree of the compared cloud.
+       If None, the octree of the cloud is used (computed if needed):
+       it also gives the cell size for the max error estimation.
+
+:param DistanceStatistics,optional stats: (default None) if given, filled with the statistics of the
+       distances (moments, histogram, percentiles), see :py:class:`DistanceStatistics`.
 
 :return: a list of statistics (min, max, mean, variance, max error) or an empty list if problem
 :rtype: list )";
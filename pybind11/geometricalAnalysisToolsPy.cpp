@@ -30,10 +30,37 @@
 #include <GeometricalAnalysisTools.h>
 #include <GenericProgressCallback.h>
 #include <ccMesh.h>
+#include "cloudSamplingToolsPy.hpp"
 #include "geometricalAnalysisToolsPy_DocStrings.hpp"
 
 #include "PyScalarType.h"
 #include "pyccTrace.h"
+#include "pyCC.h"
+
+#include <limits>
+
+unsigned RemoveDuplicatePoints_py(ccPointCloud* cloud,
+                                  double minDistanceBetweenPoints = std::numeric_limits<double>::epsilon(),
+                                  bool multiThread = true)
+{
+    if (cloud == nullptr)
+        throw std::invalid_argument("null cloud");
+    if (!(minDistanceBetweenPoints >= 0))
+        throw std::invalid_argument("the min distance must be positive or zero");
+    if (cloud->size() == 0)
+        return 0;
+
+    //same selection as the parallel spatial resampling, with a constant distance
+    std::vector<uint8_t> keep;
+    greedySpatialSelection(cloud,
+                           minDistanceBetweenPoints,
+                           [minDistanceBetweenPoints](unsigned) { return minDistanceBetweenPoints; },
+                           keep,
+                           multiThread);
+    unsigned removed = pyCC_CompactCloudInPlace(cloud, keep.data());
+    CCTRACE("RemoveDuplicatePoints: " << removed << " points removed, " << cloud->size() << " remaining");
+    return removed;
+}
 
 void export_geometricalAnalysisTools(py::module &m0)
 {
@@ -64,6 +91,11 @@ void export_geometricalAnalysisTools(py::module &m0)
              py::arg("progressCb")=nullptr,
              py::arg("inputOctree")=nullptr,
              geometricalAnalysisToolsPy_FlagDuplicatePoints_doc)
+        .def_static("RemoveDuplicatePoints",
+             &RemoveDuplicatePoints_py,
+             py::arg("cloud"), py::arg("minDistanceBetweenPoints")=std::numeric_limits<double>::epsilon(),
+             py::arg("multiThread")=true,
+             geometricalAnalysisToolsPy_RemoveDuplicatePoints_doc)
         ;
 
 }
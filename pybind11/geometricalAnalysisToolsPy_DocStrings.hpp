@@ -45,4 +45,22 @@ associated to scalar value 1 (and 0 for the others).
 )";
 
 
+const char* geometricalAnalysisToolsPy_RemoveDuplicatePoints_doc= R"(
+Removes the duplicate points of a cloud, in place.
+
+The points are binned in parallel with a spatial hash at the given tolerance, and for each group of points
+closer than the tolerance, only one point is kept (as with :py:meth:`FlagDuplicatePoints`).
+The cloud is compacted in place: coordinates, colors, normals and all the scalar fields
+(the scan grids and waveforms of the cloud, if any, are removed, its octree is deleted).
+No flag scalar field, no octree and no filtered copy of the cloud are needed.
+
+:param ccPointCloud cloud: processed cloud
+:param float,optional minDistanceBetweenPoints: min distance between (output) points,
+       default C++ std::numeric_limits<double>::epsilon() i.e. ~ 2.2 e-16
+:param bool,optional multiThread: (default True) use several threads
+
+:return: the number of removed points
+:rtype: int
+)";
+
 #endif /* GEOMETRICALANALYSISTOOLSPY_DOCSTRINGS_HPP_ */
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+#---octreeStats01-begin
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+octree = cloud.computeOctree(progressCb=None, autoAddChild=True)
+level = 6
+
+# --- per cell codes, positions and point counts, as Numpy arrays
+codes, positions, counts, sfMean, sfMin, sfMax = octree.getCellStatistics(level)
+#---octreeStats01-end
+
+if len(codes) != octree.getCellNumber(level):
+    raise RuntimeError
+if positions.shape != (len(codes), 3):
+    raise RuntimeError
+if counts.sum() != cloud.size():
+    raise RuntimeError
+if sfMean is not None or sfMin is not None or sfMax is not None:
+    raise RuntimeError
+if not np.array_equal(codes, np.array(octree.getCellCodes(level, False))):
+    raise RuntimeError
+tcodes = octree.getCellStatistics(level, truncatedCodes=True)[0]
+if not np.array_equal(tcodes, np.array(octree.getCellCodes(level, True))):
+    raise RuntimeError
+pos = octree.getCellPos(int(tcodes[10]), level, True)
+if tuple(positions[10]) != tuple(pos):
+    raise RuntimeError
+
+#---octreeStats02-begin
+# --- per cell statistics of a scalar field (here, the Z coordinate)
+cloud.exportCoordToSF(False, False, True)
+sf = cloud.getScalarField(cloud.getNumberOfScalarFields() - 1)
+codes2, positions2, counts2, sfMean, sfMin, sfMax = octree.getCellStatistics(level, sf)
+#---octreeStats02-end
+
+if not np.array_equal(counts, counts2):
+    raise RuntimeError
+if np.any(sfMin > sfMean + 1.e-5) or np.any(sfMean > sfMax + 1.e-5):
+    raise RuntimeError
+if not math.isclose(sfMin.min(), sf.getMin(), rel_tol=1.e-5, abs_tol=1.e-5):
+    raise RuntimeError
+if not math.isclose(sfMax.max(), sf.getMax(), rel_tol=1.e-5, abs_tol=1.e-5):
+    raise RuntimeError
+
+# --- single thread gives the same result
+counts3 = octree.getCellStatistics(level, sf, multiThread=False)[2]
+if not np.array_equal(counts, counts3):
+    raise RuntimeError
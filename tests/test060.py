@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0., (0., 0., 0.), (3.0, 0.0, 4.0))
+cylinder = cc.ccCylinder(0.5, 3.0, tr, 'aCylinder', 48)
+
+#---approxC2M01-begin
+# --- single thread, default level (former behaviour)
+stats1 = cc.DistanceComputationTools.computeApproxCloud2MeshDistance(cloud, cylinder, multiThread=False)
+
+# --- multi thread, same level: same results
+octree = cloud.getOctree()
+stats2 = cc.DistanceComputationTools.computeApproxCloud2MeshDistance(cloud, cylinder, octreeLevel=7,
+                                                                     multiThread=True, maxThreadCount=0,
+                                                                     cloudOctree=octree)
+#---approxC2M01-end
+
+if len(stats1) != 5 or len(stats2) != 5:
+    raise RuntimeError
+for i in range(5):
+    if not math.isclose(stats1[i], stats2[i], rel_tol=1.e-5, abs_tol=1.e-6):
+        raise RuntimeError
+if not math.isclose(stats1[4], octree.getCellSize(7)/2., rel_tol=1.e-6):
+    raise RuntimeError
+
+#---approxC2M02-begin
+# --- adaptive octree level: the max error is given by the cell size at the chosen level
+stats3 = cc.DistanceComputationTools.computeApproxCloud2MeshDistance(cloud, cylinder, octreeLevel=0)
+#---approxC2M02-end
+
+if len(stats3) != 5:
+    raise RuntimeError
+levels = [l for l in range(1, 11) if math.isclose(stats3[4], octree.getCellSize(l)/2., rel_tol=1.e-6)]
+if len(levels) != 1:
+    raise RuntimeError
+print("adaptive level:", levels[0], stats3)
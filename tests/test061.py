@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud1 = cc.loadPointCloud(getSampleCloud(5.0))
+cloud2 = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0.0, 0.0, 0.1, (0.0, 0.0, 0.05))
+cloud2.applyRigidTransformation(tr)
+
+# --- reference: standard computation, with a max search distance
+params = cc.Cloud2CloudDistancesComputationParams()
+params.maxSearchDist = 0.2
+params.octreeLevel = 8
+cc.DistanceComputationTools.computeCloud2CloudDistances(cloud1, cloud2, params)
+sf1 = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1)
+d1 = sf1.toNpArrayCopy()
+sf1.setName("C2C standard")
+
+#---C2Ctiled01-begin
+# --- tiled computation: octrees are built tile by tile
+params = cc.Cloud2CloudDistancesComputationParams()
+params.maxSearchDist = 0.2
+params.octreeLevel = 0  # best level for each tile
+ret = cc.DistanceComputationTools.computeCloud2CloudDistancesTiled(cloud1, cloud2, params, tileSize=2.0)
+#---C2Ctiled01-end
+
+if ret <= 0:
+    raise RuntimeError
+sf2 = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1)
+if sf2.getName() != "C2C absolute distances[<0.2]":
+    raise RuntimeError
+d2 = sf2.toNpArrayCopy()
+if len(d1) != len(d2):
+    raise RuntimeError
+if not np.allclose(d1, d2, atol=1.e-5, equal_nan=True):
+    raise RuntimeError
+
+# --- a max search distance is required
+params.maxSearchDist = 0.
+ret = cc.DistanceComputationTools.computeCloud2CloudDistancesTiled(cloud1, cloud2, params, tileSize=2.0)
+if ret != -1:
+    raise RuntimeError
+
+# --- a tile size too small for the cloud extent is rejected, without overflow
+params.maxSearchDist = 0.2
+ret = cc.DistanceComputationTools.computeCloud2CloudDistancesTiled(cloud1, cloud2, params, tileSize=1.e-9)
+if ret != -1:
+    raise RuntimeError
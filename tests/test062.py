@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+refs = []
+for i in range(3):
+    ref = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+    tr = cc.ccGLMatrix()
+    tr.initFromParameters(0.0, 0.0, 0.0, (0.0, 0.0, 0.02*(i+1)))
+    ref.applyRigidTransformation(tr)
+    ref.setName("epoch%d" % i)
+    refs.append(ref)
+
+#---C2CmultiRef01-begin
+# --- one scalar field per reference, in a single traversal of the compared octree
+sfIndexes = cc.DistanceComputationTools.computeCloud2MultiCloudDistances(cloud, refs, maxSearchDist=0.5)
+for i in sfIndexes:
+    sf = cloud.getScalarField(i)
+    print(sf.getName(), sf.getMin(), sf.getMax())
+#---C2CmultiRef01-end
+
+if len(sfIndexes) != 3:
+    raise RuntimeError
+if cloud.getScalarField(sfIndexes[1]).getName() != "C2C absolute distances (#1 epoch1)[<0.5]":
+    raise RuntimeError
+
+# --- compare with the standard computation, one reference at a time
+for i, ref in enumerate(refs):
+    params = cc.Cloud2CloudDistancesComputationParams()
+    params.maxSearchDist = 0.5
+    params.octreeLevel = 7
+    cc.DistanceComputationTools.computeCloud2CloudDistances(cloud, ref, params)
+    d1 = cloud.getScalarField(cloud.getNumberOfScalarFields()-1).toNpArrayCopy()
+    cloud.deleteScalarField(cloud.getNumberOfScalarFields()-1)
+    d2 = cloud.getScalarField(sfIndexes[i]).toNpArrayCopy()
+    if not np.allclose(d1, d2, atol=1.e-5):
+        raise RuntimeError
+
+# --- references with the same name: one scalar field each
+twins = [refs[0], refs[2]]
+for ref in twins:
+    ref.setName("twin")
+twinIndexes = cc.DistanceComputationTools.computeCloud2MultiCloudDistances(cloud, twins, maxSearchDist=0.5)
+if len(twinIndexes) != 2 or twinIndexes[0] == twinIndexes[1]:
+    raise RuntimeError
+for i, k in enumerate([0, 2]):
+    d1 = cloud.getScalarField(sfIndexes[k]).toNpArrayCopy()
+    d2 = cloud.getScalarField(twinIndexes[i]).toNpArrayCopy()
+    if not np.allclose(d1, d2, atol=1.e-5):
+        raise RuntimeError
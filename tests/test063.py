@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, getSampleCloud2, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+cloudm = cc.loadPointCloud(getSampleCloud2(3.0, 0, 0.1))
+mesh = cc.ccMesh.triangulate(cloudm, cc.TRIANGULATION_TYPES.DELAUNAY_2D_AXIS_ALIGNED, dim=2)
+nbTriangles = mesh.size()
+
+# --- standard computation
+params = cc.Cloud2MeshDistancesComputationParams()
+params.octreeLevel = 7
+t0 = time.perf_counter()
+cc.DistanceComputationTools.computeCloud2MeshDistances(cloud, mesh, params)
+t1 = time.perf_counter()
+sf1 = cloud.getScalarField(cloud.getNumberOfScalarFields()-1)
+sf1.setName("C2M standard")
+d1 = sf1.toNpArrayCopy()
+
+#---C2Mbatch01-begin
+# --- batched point to triangle kernel
+params = cc.Cloud2MeshDistancesComputationParams()
+params.octreeLevel = 7
+params.multiThread = True
+t2 = time.perf_counter()
+ret = cc.DistanceComputationTools.computeCloud2MeshDistances(cloud, mesh, params, useBatchKernel=True)
+t3 = time.perf_counter()
+#---C2Mbatch01-end
+
+if ret != 1:
+    raise RuntimeError
+d2 = cloud.getScalarField(cloud.getNumberOfScalarFields()-1).toNpArrayCopy()
+if not np.allclose(d1, d2, rtol=1.e-4, atol=1.e-5):
+    raise RuntimeError
+
+# --- benchmark: measured times on the same cloud and mesh
+print("standard path: %.3fs, %.3g points/s" % (t1 - t0, cloud.size()/(t1 - t0)))
+print("batch kernel : %.3fs, %.3g points/s" % (t3 - t2, cloud.size()/(t3 - t2)))
+print("points:", cloud.size(), "mesh triangles:", nbTriangles, "measured speedup: %.2f" % ((t1 - t0)/(t3 - t2)))
+
+# --- with a max search distance
+params.maxSearchDist = 0.3
+ret = cc.DistanceComputationTools.computeCloud2MeshDistances(cloud, mesh, params, useBatchKernel=True)
+if ret != 1:
+    raise RuntimeError
+d3 = cloud.getScalarField(cloud.getNumberOfScalarFields()-1).toNpArrayCopy()
+near = d1 < 0.29
+if not np.allclose(d1[near], d3[near], rtol=1.e-4, atol=1.e-5):
+    raise RuntimeError
+if d3.max() > 0.3 + 1.e-5:
+    raise RuntimeError
+
+# --- signed distances are not available with the batch kernel
+params.signedDistances = True
+try:
+    cc.DistanceComputationTools.computeCloud2MeshDistances(cloud, mesh, params, useBatchKernel=True)
+    raise RuntimeError
+except ValueError:
+    pass
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud1 = cc.loadPointCloud(getSampleCloud(5.0))
+cloud2 = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0.0, 0.0, 0.1, (0.0, 0.0, 0.05))
+cloud2.applyRigidTransformation(tr)
+
+#---distStats01-begin
+# --- statistics, histogram and percentiles of the approximate distances
+stats = cc.DistanceStatistics(nbBins=100, percentiles=[50., 95., 99.])
+res = cc.DistanceComputationTools.computeApproxCloud2CloudDistance(cloud1, cloud2, stats=stats)
+print("count:", stats.count, "min:", stats.min, "max:", stats.max, "mean:", stats.mean, "variance:", stats.variance)
+print("median, 95%, 99%:", stats.percentiles)
+histo = stats.histogram   # numpy array, 100 bins
+edges = stats.binEdges    # numpy array, 101 values
+#---distStats01-end
+
+if len(res) != 5:
+    raise RuntimeError
+if not math.isclose(res[0], stats.min) or not math.isclose(res[2], stats.mean):
+    raise RuntimeError
+if len(histo) != 100 or len(edges) != 101:
+    raise RuntimeError
+if histo.sum() != stats.count:
+    raise RuntimeError
+
+# --- compare with numpy
+sf = cloud1.getScalarField(cloud1.getScalarFieldDic()["Approx. distances"])
+d = sf.toNpArrayCopy()
+d = d[~np.isnan(d)]
+if d.size != stats.count:
+    raise RuntimeError
+if not math.isclose(d.mean(), stats.mean, rel_tol=1.e-4):
+    raise RuntimeError
+if not math.isclose(d.var(), stats.variance, rel_tol=1.e-3):
+    raise RuntimeError
+h, e = np.histogram(d, bins=100, range=(stats.min, stats.max))
+if np.abs(h - histo).sum() > 0.001 * d.size:   # bin boundaries: float rounding
+    raise RuntimeError
+binWidth = edges[1] - edges[0]
+for level, p in zip([50., 95., 99.], stats.percentiles):
+    if abs(np.percentile(d, level) - p) > binWidth:
+        raise RuntimeError
+
+#---distStats02-begin
+# --- statistics of any scalar field, with a given histogram range
+stats2 = cc.DistanceStatistics(nbBins=10, histoMin=0., histoMax=0.1)
+stats2.computeFromScalarField(sf)
+#---distStats02-end
+if stats2.histogram.sum() != np.count_nonzero(d <= 0.1):
+    raise RuntimeError
+if stats2.overflow != np.count_nonzero(d > 0.1) or stats2.underflow != 0:
+    raise RuntimeError
+if stats2.histogram.sum() + stats2.underflow + stats2.overflow != stats2.count:
+    raise RuntimeError
+if not math.isclose(sf.getMax(), stats2.max, rel_tol=1.e-6):
+    raise RuntimeError
+
+# --- percentiles of all the values, even with a histogram range not covering them
+upper = np.percentile(d, 90)
+stats3 = cc.DistanceStatistics(nbBins=50, percentiles=[50.], histoMin=0., histoMax=upper)
+stats3.computeFromScalarField(sf)
+if abs(np.percentile(d, 50) - stats3.percentiles[0]) > upper / 50 + 1.e-6:
+    raise RuntimeError
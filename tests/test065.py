@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud1 = cc.loadPointCloud(getSampleCloud(5.0))
+cloud2 = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0.0, 0.0, 0.1, (0.0, 0.0, 0.05))
+cloud2.applyRigidTransformation(tr)
+coords1 = cloud1.toNpArrayCopy()
+coords2 = cloud2.toNpArrayCopy()
+
+#---C2Cindexes01-begin
+# --- distances and index of the nearest reference point
+params = cc.Cloud2CloudDistancesComputationParams()
+ret, indexes = cc.DistanceComputationTools.computeCloud2CloudDistancesWithIndexes(cloud1, cloud2, params)
+# --- transfer an attribute: here the reference z coordinate
+zref = coords2[indexes, 2]
+#---C2Cindexes01-end
+
+if ret <= 0:
+    raise RuntimeError
+if indexes.dtype != np.uint32 or len(indexes) != cloud1.size():
+    raise RuntimeError
+d = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1).toNpArrayCopy()
+dcheck = np.linalg.norm(coords1 - coords2[indexes], axis=1)
+if not np.allclose(d, dcheck, atol=1.e-5):
+    raise RuntimeError
+
+#---C2Cindexes02-begin
+# --- with a max search distance: no index (0xFFFFFFFF) for the points without neighbour
+params = cc.Cloud2CloudDistancesComputationParams()
+params.maxSearchDist = 0.1
+ret, indexes2 = cc.DistanceComputationTools.computeCloud2CloudDistancesWithIndexes(cloud1, cloud2, params)
+found = indexes2 != 0xFFFFFFFF
+#---C2Cindexes02-end
+
+if ret <= 0:
+    raise RuntimeError
+d2 = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1).toNpArrayCopy()
+if not np.array_equal(found, d < 0.1):
+    n = np.count_nonzero(found != (d < 0.1))
+    if n > 0.0001 * len(d):  # ties at the max distance
+        raise RuntimeError
+dcheck2 = np.linalg.norm(coords1[found] - coords2[indexes2[found]], axis=1)
+if not np.allclose(d2[found], dcheck2, atol=1.e-5):
+    raise RuntimeError
+if not np.allclose(d2[found], d[found], atol=1.e-5):
+    raise RuntimeError
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+ref = cc.loadPointCloud(getSampleCloud(5.0))
+ref.setName("reference")
+
+epochs = []
+for dz in (0.02, -0.03):
+    epoch = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+    tr = cc.ccGLMatrix()
+    tr.initFromParameters(0.0, 0.0, 0.0, (0.0, 0.0, dz))
+    epoch.applyRigidTransformation(tr)
+    epochs.append(epoch)
+
+#---C2Csigned01-begin
+# --- signed distances to local planes fitted on the reference, the planes are kept in the cache
+cache = cc.LocalModelCache()
+for epoch in epochs:
+    ret = cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epoch, ref, useNormals=False, kNN=12,
+                                                                        preferredOrientation=(0., 0., 1.),
+                                                                        cache=cache)
+    print("local models in cache:", cache.modelCount())
+#---C2Csigned01-end
+    if ret <= 0:
+        raise RuntimeError
+
+d0 = epochs[0].getScalarField(epochs[0].getScalarFieldDic()["C2C signed distances"]).toNpArrayCopy()
+d1 = epochs[1].getScalarField(epochs[1].getScalarFieldDic()["C2C signed distances"]).toNpArrayCopy()
+if np.nanmedian(d0) <= 0 or np.nanmedian(d1) >= 0:
+    raise RuntimeError
+if abs(np.nanmedian(d0) - 0.02) > 0.01 or abs(np.nanmedian(d1) + 0.03) > 0.01:
+    raise RuntimeError
+
+# --- a new call with the same epoch does not compute new models
+n = cache.modelCount()
+cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epochs[0], ref, useNormals=False, kNN=12, cache=cache)
+if cache.modelCount() != n:
+    raise RuntimeError
+d0b = epochs[0].getScalarField(epochs[0].getScalarFieldDic()["C2C signed distances"]).toNpArrayCopy()
+if not np.allclose(d0, d0b, equal_nan=True):
+    raise RuntimeError
+
+# --- the cache is reset when the reference cloud is moved: same result as without cache
+refMoved = ref.cloneThis()
+cache2 = cc.LocalModelCache()
+cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epochs[0], refMoved, useNormals=False, kNN=12, cache=cache2)
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0.3, (1.0, 0.0, 0.0), (0.0, 0.0, 0.02))
+refMoved.applyRigidTransformation(tr)
+cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epochs[0], refMoved, useNormals=False, kNN=12, cache=cache2)
+d0c = epochs[0].getScalarField(epochs[0].getScalarFieldDic()["C2C signed distances"]).toNpArrayCopy()
+cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epochs[0], refMoved, useNormals=False, kNN=12)
+d0d = epochs[0].getScalarField(epochs[0].getScalarFieldDic()["C2C signed distances"]).toNpArrayCopy()
+if not np.allclose(d0c, d0d, equal_nan=True):
+    raise RuntimeError
+
+#---C2Csigned02-begin
+# --- with the reference normals
+cc.computeNormals([ref])
+ret = cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epochs[0], ref, maxSearchDist=0.5)
+#---C2Csigned02-end
+if ret <= 0:
+    raise RuntimeError
+d2 = epochs[0].getScalarField(epochs[0].getScalarFieldDic()["C2C signed distances[<0.5]"]).toNpArrayCopy()
+if abs(abs(np.nanmedian(d2)) - 0.02) > 0.01:  # normals orientation depends on computeNormals options
+    raise RuntimeError
+
+# --- the cache only holds fitted planes: ignored with the reference normals
+cache3 = cc.LocalModelCache()
+cc.DistanceComputationTools.computeCloud2CloudSignedDistances(epochs[0], ref, maxSearchDist=0.5, cache=cache3)
+if cache3.modelCount() != 0:
+    raise RuntimeError
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, getSampleCloud2, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud1 = cc.loadPointCloud(getSampleCloud(5.0))
+cloud2 = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0.0, 0.0, 0.1, (0.0, 0.0, 0.05))
+cloud2.applyRigidTransformation(tr)
+tol = 0.03
+
+# --- reference: full distances, then threshold
+t0 = time.perf_counter()
+params = cc.Cloud2CloudDistancesComputationParams()
+params.octreeLevel = cc.DistanceComputationTools.determineBestOctreeLevel(cloud1, None, cloud2)
+cc.DistanceComputationTools.computeCloud2CloudDistances(cloud1, cloud2, params)
+sf = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1)
+cloud1.setCurrentOutScalarField(cloud1.getNumberOfScalarFields()-1)
+fcloud = cc.filterBySFValue(0., tol, cloud1)
+t1 = time.perf_counter()
+d = sf.toNpArrayCopy()
+
+#---C2Ctolerance01-begin
+t2 = time.perf_counter()
+mask = cc.DistanceComputationTools.computeCloud2CloudWithinTolerance(cloud1, cloud2, tol)
+t3 = time.perf_counter()
+#---C2Ctolerance01-end
+
+if mask.dtype != np.uint8 or len(mask) != cloud1.size():
+    raise RuntimeError
+ref = (d <= tol).astype(np.uint8)
+ndiff = np.count_nonzero(mask != ref)
+print("C2C: distances + filter: %.3fs, within tolerance: %.3fs, speedup: %.2f, diff: %d"
+      % (t1 - t0, t3 - t2, (t1 - t0)/(t3 - t2), ndiff))
+if ndiff > 0.0001 * len(mask):  # float rounding at the threshold
+    raise RuntimeError
+if fcloud is not None and abs(fcloud.size() - int(mask.sum())) > 0.0001 * len(mask):
+    raise RuntimeError
+
+# --- cloud to mesh
+cloudm = cc.loadPointCloud(getSampleCloud2(3.0, 0, 0.1))
+mesh = cc.ccMesh.triangulate(cloudm, cc.TRIANGULATION_TYPES.DELAUNAY_2D_AXIS_ALIGNED, dim=2)
+t0 = time.perf_counter()
+params = cc.Cloud2MeshDistancesComputationParams()
+params.octreeLevel = cc.DistanceComputationTools.determineBestOctreeLevel(cloud1, mesh)
+cc.DistanceComputationTools.computeCloud2MeshDistances(cloud1, mesh, params)
+t1 = time.perf_counter()
+dm = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1).toNpArrayCopy()
+
+#---C2Mtolerance01-begin
+t2 = time.perf_counter()
+maskm = cc.DistanceComputationTools.computeCloud2MeshWithinTolerance(cloud1, mesh, 0.2)
+t3 = time.perf_counter()
+#---C2Mtolerance01-end
+
+refm = (dm <= 0.2).astype(np.uint8)
+ndiff = np.count_nonzero(maskm != refm)
+print("C2M: distances: %.3fs, within tolerance: %.3fs, speedup: %.2f, diff: %d"
+      % (t1 - t0, t3 - t2, (t1 - t0)/(t3 - t2), ndiff))
+if ndiff > 0.0001 * len(maskm):
+    raise RuntimeError
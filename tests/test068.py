@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, getSampleCloud2, dataDir, isCoordEqual, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud1 = cc.loadPointCloud(getSampleCloud(5.0))
+cloud2 = cc.loadPointCloud(getSampleCloud(5.0, 9.0))
+tr = cc.ccGLMatrix()
+tr.initFromParameters(0.0, 0.0, 0.1, (0.0, 0.0, 0.05))
+cloud2.applyRigidTransformation(tr)
+
+#---symmetricDistances01-begin
+report = cc.DistanceComputationTools.computeSymmetricDistances(cloud1, cloud2, percentiles=[50, 95])
+print("Hausdorff: %g, RMS: %g (A->B: %g, B->A: %g)" % (report.hausdorff, report.rms, report.rmsAB, report.rmsBA))
+print("A->B median: %g, 95%%: %g" % tuple(report.statsAB.percentiles))
+#---symmetricDistances01-end
+
+dab = cloud1.getScalarField(report.sfIndexA).toNpArrayCopy()
+dba = cloud2.getScalarField(report.sfIndexB).toNpArrayCopy()
+if cloud1.getScalarField(report.sfIndexA).getName() != "C2C absolute distances":
+    raise RuntimeError
+if not math.isclose(report.hausdorff, max(dab.max(), dba.max()), rel_tol=1e-5):
+    raise RuntimeError
+if not math.isclose(report.rmsAB, math.sqrt(np.mean(dab.astype(np.float64)**2)), rel_tol=1e-4):
+    raise RuntimeError
+if report.statsAB.count != cloud1.size() or report.statsBA.count != cloud2.size():
+    raise RuntimeError
+rms = math.sqrt((np.sum(dab.astype(np.float64)**2) + np.sum(dba.astype(np.float64)**2)) / (len(dab) + len(dba)))
+if not math.isclose(report.rms, rms, rel_tol=1e-4):
+    raise RuntimeError
+
+# --- same as the separate computations
+params = cc.Cloud2CloudDistancesComputationParams()
+params.octreeLevel = cc.DistanceComputationTools.determineBestOctreeLevel(cloud1, None, cloud2)
+cc.DistanceComputationTools.computeCloud2CloudDistances(cloud1, cloud2, params)
+d = cloud1.getScalarField(cloud1.getNumberOfScalarFields()-1).toNpArrayCopy()
+if not math.isclose(d.max(), report.statsAB.max, rel_tol=1e-5):
+    raise RuntimeError
+
+# --- cloud to mesh
+cloudm = cc.loadPointCloud(getSampleCloud2(3.0, 0, 0.1))
+mesh = cc.ccMesh.triangulate(cloudm, cc.TRIANGULATION_TYPES.DELAUNAY_2D_AXIS_ALIGNED, dim=2)
+
+#---symmetricDistances02-begin
+report = cc.DistanceComputationTools.computeSymmetricDistances(cloud1, mesh)
+#---symmetricDistances02-end
+
+vertices = mesh.getAssociatedCloud()
+dab = cloud1.getScalarField(report.sfIndexA).toNpArrayCopy()
+dba = vertices.getScalarField(report.sfIndexB).toNpArrayCopy()
+if vertices.getScalarField(report.sfIndexB).getName() != "C2C absolute distances":
+    raise RuntimeError
+if "Approx. distances" in vertices.getScalarFieldDic():  # temporary scalar field of the automatic level removed
+    raise RuntimeError
+if "Approx. distances" not in cloud1.getScalarFieldDic():  # the former one (determineBestOctreeLevel above) is kept
+    raise RuntimeError
+if cloud1.getScalarField(report.sfIndexA).getName() != "C2M absolute distances":
+    raise RuntimeError
+if not math.isclose(report.hausdorff, max(dab.max(), dba.max()), rel_tol=1e-5):
+    raise RuntimeError
+if len(report.statsBA.percentiles) != 3:
+    raise RuntimeError
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+refCloud = cc.CloudSamplingTools.subsampleCloudRandomly(cloud, 50000)
+(randomCloud, res) = cloud.partialClone(refCloud)
+
+# --- SOR filter: keep mask, compared to the reference cloud version
+refSor = cc.CloudSamplingTools.sorFilter(randomCloud)
+
+#---sorFilterMask01-begin
+mask = cc.CloudSamplingTools.sorFilterMask(randomCloud, knn=6, nSigma=1.0)
+#---sorFilterMask01-end
+
+if mask.dtype != np.uint8 or len(mask) != randomCloud.size():
+    raise RuntimeError
+print("SOR: reference cloud: %d, mask: %d" % (refSor.size(), int(mask.sum())))
+if abs(int(mask.sum()) - refSor.size()) > 0.005 * randomCloud.size():
+    raise RuntimeError
+
+# --- scalar field output
+nbsf = randomCloud.getNumberOfScalarFields()
+mask2 = cc.CloudSamplingTools.sorFilterMask(randomCloud, exportSF=True)
+if randomCloud.getNumberOfScalarFields() != nbsf + 1:
+    raise RuntimeError
+sfmask = randomCloud.getScalarField(nbsf).toNpArrayCopy()
+if not np.array_equal(sfmask.astype(np.uint8), mask2):
+    raise RuntimeError
+
+# --- in place
+coords = randomCloud.toNpArrayCopy()
+
+#---sorFilterMask02-begin
+mask3 = cc.CloudSamplingTools.sorFilterMask(randomCloud, inPlace=True)
+#---sorFilterMask02-end
+
+if randomCloud.size() != int(mask3.sum()):
+    raise RuntimeError
+if not np.array_equal(randomCloud.toNpArrayCopy(), coords[mask3 == 1]):
+    raise RuntimeError
+sfmask = randomCloud.getScalarField(nbsf).toNpArrayCopy()
+if not np.array_equal(sfmask.astype(np.uint8), mask2[mask3 == 1]):  # attributes follow the points
+    raise RuntimeError
+
+# --- noise filter
+refNoise = cc.CloudSamplingTools.noiseFilter(cloud, 0.04, 1.0)
+
+#---noiseFilterMask01-begin
+maskn = cc.CloudSamplingTools.noiseFilterMask(cloud, 0.04, 1.0)
+#---noiseFilterMask01-end
+
+print("noise filter: reference cloud: %d, mask: %d" % (refNoise.size(), int(maskn.sum())))
+if abs(int(maskn.sum()) - refNoise.size()) > 0.005 * cloud.size():
+    raise RuntimeError
+
+try:
+    cc.CloudSamplingTools.noiseFilterMask(cloud, 0.04, 1.0, exportSF=True, inPlace=True)
+    raise RuntimeError("exclusive options accepted")
+except ValueError:
+    pass
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+cloud.exportCoordToSF(False, False, True)
+dic = cloud.getScalarFieldDic()
+isf = dic['Coord. Z']
+voxelSize = 0.1
+
+#---voxelGrid01-begin
+voxCloud = cc.CloudSamplingTools.voxelGridDownsample(cloud, voxelSize, meanSFs=[isf], maxSFs=[isf])
+#---voxelGrid01-end
+
+# --- reference with numpy: number of voxels and point counts
+coords = cloud.toNpArrayCopy().astype(np.float64)
+ijk = np.floor((coords - coords.min(axis=0)) / voxelSize).astype(np.int64)
+keys, inverse, counts = np.unique(ijk, axis=0, return_inverse=True, return_counts=True)
+print("%d points, %d voxels" % (cloud.size(), voxCloud.size()))
+if voxCloud.size() != len(keys):
+    raise RuntimeError
+
+vdic = voxCloud.getScalarFieldDic()
+if 'Point count' not in vdic or 'Coord. Z' not in vdic or 'Coord. Z (max)' not in vdic:
+    raise RuntimeError
+cnt = voxCloud.getScalarField(vdic['Point count']).toNpArrayCopy()
+if int(cnt.sum()) != cloud.size():
+    raise RuntimeError
+if not np.array_equal(np.sort(cnt.astype(np.int64)), np.sort(counts)):
+    raise RuntimeError
+
+# centroids: the mean Z SF is the Z coordinate of the centroid, the max is above
+vcoords = voxCloud.toNpArrayCopy()
+meanz = voxCloud.getScalarField(vdic['Coord. Z']).toNpArrayCopy()
+maxz = voxCloud.getScalarField(vdic['Coord. Z (max)']).toNpArrayCopy()
+if np.max(np.abs(vcoords[:, 2] - meanz)) > 1.e-4:
+    raise RuntimeError
+if np.any(maxz < meanz - 1.e-5):
+    raise RuntimeError
+
+#---voxelGrid02-begin
+voxNearest = cc.CloudSamplingTools.voxelGridDownsample(cloud, voxelSize, cc.VOXEL_REPRESENTATIVE.VOXEL_NEAREST_TO_CENTROID,
+                                                       countSF=False)
+#---voxelGrid02-end
+
+if voxNearest.size() != voxCloud.size() or voxNearest.getNumberOfScalarFields() != 0:
+    raise RuntimeError
+# representative points are points of the original cloud, in their voxel
+nijk = np.floor((voxNearest.toNpArrayCopy().astype(np.float64) - coords.min(axis=0)) / voxelSize).astype(np.int64)
+if len(np.unique(nijk, axis=0)) != voxNearest.size():
+    raise RuntimeError
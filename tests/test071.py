@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+minDist = 0.05
+
+t0 = time.perf_counter()
+refCloud = cc.CloudSamplingTools.resampleCloudSpatially(cloud, minDist)
+t1 = time.perf_counter()
+
+#---resampleSpatiallyParallel01-begin
+refPar = cc.CloudSamplingTools.resampleCloudSpatiallyParallel(cloud, minDist)
+(spatialCloud, res) = cloud.partialClone(refPar)
+#---resampleSpatiallyParallel01-end
+t2 = time.perf_counter()
+
+print("sequential: %d points %.3fs, parallel: %d points %.3fs" % (refCloud.size(), t1 - t0, refPar.size(), t2 - t1))
+if abs(refPar.size() - refCloud.size()) > 0.1 * refCloud.size():
+    raise RuntimeError
+
+# spacing guarantee: the nearest neighbour of each kept point is beyond the min distance
+coords = spatialCloud.toNpArrayCopy()
+ref = cc.ccPointCloud()
+ref.coordsFromNPArray_copy(coords[1::2])
+test = cc.ccPointCloud()
+test.coordsFromNPArray_copy(coords[0::2])
+params = cc.Cloud2CloudDistancesComputationParams()
+params.octreeLevel = cc.DistanceComputationTools.determineBestOctreeLevel(test, None, ref)
+cc.DistanceComputationTools.computeCloud2CloudDistances(test, ref, params)
+d = test.getScalarField(test.getNumberOfScalarFields()-1).toNpArrayCopy()
+if d.min() < minDist * 0.999:
+    raise RuntimeError
+
+# every point of the input is within the min distance of a kept point
+params.octreeLevel = cc.DistanceComputationTools.determineBestOctreeLevel(cloud, None, spatialCloud)
+cc.DistanceComputationTools.computeCloud2CloudDistances(cloud, spatialCloud, params)
+d = cloud.getScalarField(cloud.getNumberOfScalarFields()-1).toNpArrayCopy()
+if d.max() > minDist * 1.001:
+    raise RuntimeError
+
+def keptIndexes(selection):
+    return np.array([selection.getPointGlobalIndex(i) for i in range(selection.size())])
+
+# deterministic, whatever the number of threads: same kept points
+refSeq = cc.CloudSamplingTools.resampleCloudSpatiallyParallel(cloud, minDist, multiThread=False)
+if not np.array_equal(keptIndexes(refSeq), keptIndexes(refPar)):
+    raise RuntimeError
+
+# modulation: a negative modulated distance is clamped to 0, the point removes no neighbour
+x = cloud.toNpArrayCopy()[:, 0]
+xMid = np.median(x)
+sfIdx = cloud.addScalarField("modulation")
+cloud.getScalarField(sfIdx).fromNpArrayCopy(np.where(x < xMid, -1., 1.).astype(cc.getScalarType()))
+cloud.setCurrentOutScalarField(sfIdx)
+modParams = cc.SFModulationParams()
+modParams.enabled = True
+modParams.a = minDist
+modParams.b = 0.
+refMod = cc.CloudSamplingTools.resampleCloudSpatiallyParallel(cloud, minDist, modParams)
+kept = keptIndexes(refMod)
+# the points farther than minDist from the positive half are all kept
+mustKeep = np.nonzero(x < xMid - minDist)[0]
+if not np.isin(mustKeep, kept).all():
+    raise RuntimeError
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+files = [getSampleCloud(5.0), getSampleCloud(5.0, 9.0), getSampleCloud2(3.0, 0, 0.1)]
+target = 20000
+
+#---reservoir01-begin
+sampler = cc.ReservoirSampler(target, seed=42)
+allCoords = []
+sizes = []
+for f in files:
+    cloud = cc.loadPointCloud(f)
+    cloud.exportCoordToSF(False, False, True)
+    allCoords.append(cloud.toNpArrayCopy())
+    sizes.append(cloud.size())
+    sampler.addCloud(cloud)
+    cc.deleteEntity(cloud)
+sample = sampler.toCloud()
+#---reservoir01-end
+
+allCoords = np.concatenate(allCoords)
+if sampler.seenCount() != len(allCoords):
+    raise RuntimeError
+if sampler.size() != target or sample.size() != target:
+    raise RuntimeError
+idx = np.sort(sampler.sourceIndexes())
+if len(np.unique(idx)) != target or idx[-1] >= len(allCoords):
+    raise RuntimeError
+if not np.allclose(sample.toNpArrayCopy(), allCoords[idx], atol=1.e-5):
+    raise RuntimeError
+z = sample.getScalarField(sample.getScalarFieldDic()['Coord. Z']).toNpArrayCopy()
+if not np.allclose(z, allCoords[idx, 2], atol=1.e-5):
+    raise RuntimeError
+
+# uniform: each chunk contributes in proportion of its size
+bounds = np.cumsum([0] + sizes)
+for i in range(3):
+    n = np.count_nonzero((idx >= bounds[i]) & (idx < bounds[i + 1]))
+    expected = target * sizes[i] / len(allCoords)
+    print("chunk %d: %d sampled, %.0f expected" % (i, n, expected))
+    if abs(n - expected) > 5 * math.sqrt(expected):
+        raise RuntimeError
+
+# reproducible, also with numpy chunks of coordinates
+#---reservoir02-begin
+sampler2 = cc.ReservoirSampler(target, seed=42)
+for i in range(3):
+    sampler2.addPoints(allCoords[bounds[i]:bounds[i + 1]])
+#---reservoir02-end
+if not np.array_equal(sampler2.sourceIndexes(), sampler.sourceIndexes()):
+    raise RuntimeError
+
+# less points than the target
+sampler3 = cc.ReservoirSampler(10, seed=1)
+sampler3.addPoints(allCoords[:5])
+if sampler3.size() != 5:
+    raise RuntimeError
+
+# large coordinates fed first by addPoints: the sample shift is derived from the first point
+offset = np.array([5.e6, 2.e6, 100.])
+sampler4 = cc.ReservoirSampler(1000, seed=3)
+sampler4.addPoints(allCoords[:bounds[1]] + offset)
+cloud = cc.loadPointCloud(files[1])
+cloud.exportCoordToSF(False, False, True)
+cloud.setGlobalShift(-offset[0], -offset[1], -offset[2])   # another shift: rebased on the sample shift
+sampler4.addCloud(cloud)
+cc.deleteEntity(cloud)
+sample4 = sampler4.toCloud()
+shift = np.array(sample4.getGlobalShift())
+if np.abs(shift).max() == 0:
+    raise RuntimeError
+globalCoords = sample4.toNpArrayCopy().astype(np.float64) - shift
+if np.abs(globalCoords - offset).max() > 20.:   # sample clouds are within a few units of the origin
+    raise RuntimeError
+if 'Coord. Z' not in sample4.getScalarFieldDic():   # scalar fields of the first cloud, NaN for the previous points
+    raise RuntimeError
+
+# points too far from the first chunk for the sample shift
+try:
+    sampler4.addPoints(allCoords[:10] - offset)
+    raise RuntimeError
+except ValueError:
+    pass
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud(5.0))
+n0 = cloud.size()
+cloud.exportCoordToSF(False, False, True)
+
+# merge the cloud with a copy of one half of it: overlapping scans
+refCloud = cc.CloudSamplingTools.subsampleCloudRandomly(cloud, n0 // 2)
+(half, res) = cloud.partialClone(refCloud)
+merged = cc.MergeEntities([cloud, half])
+n1 = merged.size()
+if n1 != n0 + half.size():
+    raise RuntimeError
+
+# reference: flag then filter
+flagged = merged.cloneThis()
+flagged.addScalarField("flags")
+flagged.setCurrentScalarField(flagged.getScalarFieldDic()["flags"])
+cc.GeometricalAnalysisTools.FlagDuplicatePoints(flagged)
+nflag = int(flagged.getScalarField(flagged.getScalarFieldDic()["flags"]).toNpArrayCopy().sum())
+
+#---removeDuplicates01-begin
+removed = cc.GeometricalAnalysisTools.RemoveDuplicatePoints(merged)
+#---removeDuplicates01-end
+
+print("points: %d, duplicates flagged: %d, removed: %d" % (n1, nflag, removed))
+if removed < half.size() or merged.size() != n1 - removed:
+    raise RuntimeError
+if removed != nflag:
+    raise RuntimeError
+
+# the attributes follow the points
+coords = merged.toNpArrayCopy()
+z = merged.getScalarField(merged.getScalarFieldDic()['Coord. Z']).toNpArrayCopy()
+if not np.allclose(coords[:, 2], z):
+    raise RuntimeError
+if len(np.unique(coords, axis=0)) != merged.size():
+    raise RuntimeError
+
+# with a tolerance: no two points closer than the tolerance
+tol = 0.02
+removed = cc.GeometricalAnalysisTools.RemoveDuplicatePoints(merged, tol)
+if removed == 0:
+    raise RuntimeError
+coords = merged.toNpArrayCopy()
+ref = cc.ccPointCloud()
+ref.coordsFromNPArray_copy(coords[1::2])
+test = cc.ccPointCloud()
+test.coordsFromNPArray_copy(coords[0::2])
+params = cc.Cloud2CloudDistancesComputationParams()
+params.octreeLevel = cc.DistanceComputationTools.determineBestOctreeLevel(test, None, ref)
+cc.DistanceComputationTools.computeCloud2CloudDistances(test, ref, params)
+d = test.getScalarField(test.getNumberOfScalarFields()-1).toNpArrayCopy()
+if d.min() < tol * 0.999:
+    raise RuntimeError
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+ref = cloud.cloneThis()
+radius = 0.06
+
+features = [cc.GeomFeature.Planarity, cc.GeomFeature.Linearity, cc.GeomFeature.Sphericity,
+            cc.GeomFeature.Verticality, cc.GeomFeature.Omnivariance, cc.GeomFeature.EigenEntropy]
+
+# reference: CCCoreLib (radius neighbourhoods), one call (one neighbourhood pass) per characteristic
+t0 = time.time()
+for f in features:
+    if not cc.computeFeature(f, radius, [ref]):
+        raise RuntimeError
+if not cc.computeCurvature(cc.CurvatureType.MEAN_CURV, radius, [ref]):
+    raise RuntimeError
+if not cc.computeCurvature(cc.CurvatureType.NORMAL_CHANGE_RATE, radius, [ref]):
+    raise RuntimeError
+if not cc.computeRoughness(radius, [ref]):
+    raise RuntimeError
+if not cc.computeLocalDensity(cc.Density.DENSITY_3D, radius, [ref]):
+    raise RuntimeError
+t1 = time.time()
+
+#---computeFeatures01-begin
+ok = cc.computeFeatures(features, radius, [cloud],
+                        curvatures=[cc.CurvatureType.MEAN_CURV, cc.CurvatureType.NORMAL_CHANGE_RATE],
+                        densities=[cc.Density.DENSITY_3D],
+                        roughness=True)
+#---computeFeatures01-end
+t2 = time.time()
+if not ok:
+    raise RuntimeError
+print("successive calls: %f s, single pass: %f s" % (t1 - t0, t2 - t1))
+
+dic = cloud.getScalarFieldDic()
+refDic = ref.getScalarFieldDic()
+print(dic)
+if len(dic) != len(refDic):
+    raise RuntimeError
+
+def checkSF(name, tol, maxMismatchRatio, absolute=False):
+    if name not in dic or name not in refDic:
+        raise RuntimeError
+    a = cloud.getScalarField(dic[name]).toNpArrayCopy().astype(np.float64)
+    b = ref.getScalarField(refDic[name]).toNpArrayCopy().astype(np.float64)
+    if absolute:
+        a = np.abs(a)
+        b = np.abs(b)
+    close = np.isclose(a, b, rtol=tol, atol=tol, equal_nan=True)
+    ratio = 1. - np.count_nonzero(close) / len(a)
+    print("%s: mismatch ratio %f" % (name, ratio))
+    if ratio > maxMismatchRatio:
+        raise RuntimeError
+
+for name in refDic:
+    if "curvature" in name.lower():
+        checkSF(name, 1.e-2, 0.01, absolute=True)
+    elif "density" in name.lower():
+        checkSF(name, 1.e-3, 0.01)   # points at the neighbourhood boundary: float rounding
+    else:
+        checkSF(name, 1.e-3, 0.001)
+
+# density: the point itself is always in its neighbourhood
+densName = [name for name in dic if "density" in name.lower()][0]
+dens = cloud.getScalarField(dic[densName]).toNpArrayCopy()
+if np.isnan(dens).any() or dens.min() <= 0:
+    raise RuntimeError
+
+# nothing to compute
+if cc.computeFeatures([], radius, [cloud]):
+    raise RuntimeError
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+ref = cloud.cloneThis()
+
+features = [cc.GeomFeature.Planarity, cc.GeomFeature.Linearity, cc.GeomFeature.Verticality]
+radii = [0.03, 0.045, 0.06, 0.09]
+
+# reference: one pass per scale
+t0 = time.time()
+for r in radii:
+    if not cc.computeFeatures(features, r, [ref], densities=[cc.Density.DENSITY_KNN], roughness=True):
+        raise RuntimeError
+t1 = time.time()
+
+#---multiScaleFeatures01-begin
+ok = cc.computeMultiScaleFeatures(features, radii, [cloud], densities=[cc.Density.DENSITY_KNN], roughness=True)
+#---multiScaleFeatures01-end
+t2 = time.time()
+if not ok:
+    raise RuntimeError
+print("one pass per scale: %f s, multi-scale pass: %f s" % (t1 - t0, t2 - t1))
+
+dic = cloud.getScalarFieldDic()
+refDic = ref.getScalarFieldDic()
+print(dic)
+if len(dic) != len(radii) * (len(features) + 2) or len(refDic) != len(dic):
+    raise RuntimeError
+
+for name in refDic:
+    if name not in dic:
+        raise RuntimeError
+    a = cloud.getScalarField(dic[name]).toNpArrayCopy().astype(np.float64)
+    b = ref.getScalarField(refDic[name]).toNpArrayCopy().astype(np.float64)
+    close = np.isclose(a, b, rtol=1.e-4, atol=1.e-5, equal_nan=True)
+    ratio = 1. - np.count_nonzero(close) / len(a)
+    print("%s: mismatch ratio %f" % (name, ratio))
+    if ratio > 0.001:
+        raise RuntimeError
+
+# nested neighbourhoods: the number of neighbours grows with the radius
+densNames = sorted([n for n in dic if "(r=" in n], key=lambda n: float(n.split("(r=")[1].rstrip(")")))
+if len(densNames) != len(radii):
+    raise RuntimeError
+counts = [cloud.getScalarField(dic[name]).toNpArrayCopy() for name in densNames]
+for i in range(1, len(counts)):
+    if (counts[i] < counts[i-1]).any():
+        raise RuntimeError
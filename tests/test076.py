@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+cloud.deleteAllScalarFields()
+n = cloud.size()
+radius = 0.06
+features = [cc.GeomFeature.Planarity, cc.GeomFeature.Verticality]
+
+# reference: all the points
+full = cloud.cloneThis()
+if not cc.computeFeatures(features, radius, [full], roughness=True):
+    raise RuntimeError
+fullDic = full.getScalarFieldDic()
+fullValues = {name: full.getScalarField(fullDic[name]).toNpArrayCopy() for name in fullDic}
+
+refCloud = cc.CloudSamplingTools.subsampleCloudRandomly(cloud, n // 10)
+core = np.array([refCloud.getPointGlobalIndex(i) for i in range(refCloud.size())], dtype=np.uint32)
+notCore = np.ones(n, dtype=bool)
+notCore[core] = False
+
+def checkCoreValues(values, name, indexes):
+    ref = fullValues[name][indexes]
+    if not np.allclose(values, ref, rtol=1.e-4, atol=1.e-5, equal_nan=True):
+        raise RuntimeError
+
+# core points given by a ReferenceCloud: other points are NaN
+#---coreFeatures01-begin
+ok = cc.computeCoreFeatures(features, [radius], cloud, refCloud, roughness=True)
+#---coreFeatures01-end
+if not ok:
+    raise RuntimeError
+dic = cloud.getScalarFieldDic()
+if len(dic) != len(fullDic):
+    raise RuntimeError
+for name in fullDic:
+    values = cloud.getScalarField(dic[name]).toNpArrayCopy()
+    checkCoreValues(values[core], name, core)
+    if not np.isnan(values[notCore]).all():
+        raise RuntimeError
+
+# core points given by an index array, values propagated from the nearest core point
+cloud2 = cloud.cloneThis()
+cloud2.deleteAllScalarFields()
+ok = cc.computeCoreFeatures(features, [radius], cloud2, core, propagate=True)
+if not ok:
+    raise RuntimeError
+dic2 = cloud2.getScalarFieldDic()
+for name in dic2:
+    values = cloud2.getScalarField(dic2[name]).toNpArrayCopy()
+    checkCoreValues(values[core], name, core)
+    # a non core point gets a value of a core point
+    propagated = values[notCore][:1000]
+    if not np.isin(propagated[~np.isnan(propagated)], values[core]).all():
+        raise RuntimeError
+
+# core points in a separate cloud (here, a subset of the cloud)
+#---coreFeatures02-begin
+(coreCloud, res) = cloud.partialClone(refCloud)
+coreCloud.deleteAllScalarFields()
+ok = cc.computeCoreFeatures(features, [radius], full, coreCloud, roughness=True, propagate=False)
+#---coreFeatures02-end
+if not ok:
+    raise RuntimeError
+coreDic = coreCloud.getScalarFieldDic()
+if len(coreDic) != len(fullDic):
+    raise RuntimeError
+for name in coreDic:
+    checkCoreValues(coreCloud.getScalarField(coreDic[name]).toNpArrayCopy(), name, core)
+
+# core points which are not in the cloud: shifted copy of the core points
+shifted = coreCloud.cloneThis()
+shifted.deleteAllScalarFields()
+shifted.translate((0., 0., 0.005))
+if not cc.computeCoreFeatures(features, [radius], cloud2, shifted, roughness=True, propagate=True):
+    raise RuntimeError
+shiftedDic = shifted.getScalarFieldDic()
+rough = shifted.getScalarField(shiftedDic[[name for name in shiftedDic if name.startswith("Roughness")][0]]).toNpArrayCopy()
+if np.count_nonzero(np.isnan(rough)) > len(rough) // 10:
+    raise RuntimeError
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+cloud.deleteAllScalarFields()
+radius = 0.06
+k = 12
+
+# --- k nearest neighbours: no distance limit
+
+#---computeFeaturesKnn01-begin
+ok = cc.computeFeatures([cc.GeomFeature.Planarity], 0., [cloud],
+                        densities=[cc.Density.DENSITY_KNN, cc.Density.DENSITY_3D], knn=k)
+#---computeFeaturesKnn01-end
+if not ok:
+    raise RuntimeError
+dic = cloud.getScalarFieldDic()
+print(dic)
+for name in ["Planarity (k=12)", "Number of neighbors (k=12)"]:
+    if name not in dic:
+        raise RuntimeError
+nbKnn = cloud.getScalarField(dic["Number of neighbors (k=12)"]).toNpArrayCopy()
+if nbKnn.min() != k or nbKnn.max() != k:
+    raise RuntimeError
+plan = cloud.getScalarField(dic["Planarity (k=12)"]).toNpArrayCopy()
+if np.isnan(plan).any() or plan.min() < 0. or plan.max() > 1.:
+    raise RuntimeError
+vol = [name for name in dic if name.endswith("(k=12)") and name not in ["Planarity (k=12)", "Number of neighbors (k=12)"]]
+if len(vol) != 1:
+    raise RuntimeError
+dens3D = cloud.getScalarField(dic[vol[0]]).toNpArrayCopy()
+if np.isnan(dens3D).any() or dens3D.min() <= 0:
+    raise RuntimeError
+
+# --- single characteristic functions share the same neighbourhood definition
+
+if not cc.computeFeature(cc.GeomFeature.Linearity, 0., [cloud], knn=k):
+    raise RuntimeError
+if not cc.computeCurvature(cc.CurvatureType.MEAN_CURV, 0., [cloud], knn=k):
+    raise RuntimeError
+if not cc.computeRoughness(0., [cloud], knn=k):
+    raise RuntimeError
+dic = cloud.getScalarFieldDic()
+print(dic)
+if "Linearity (k=12)" not in dic:
+    raise RuntimeError
+if len([name for name in dic if name.endswith("(k=12)")]) != 6:
+    raise RuntimeError
+
+# --- hybrid mode: at most k neighbours, within the radius
+
+if not cc.computeFeatures([], radius, [cloud], densities=[cc.Density.DENSITY_KNN]):
+    raise RuntimeError
+#---computeFeaturesKnn02-begin
+if not cc.computeLocalDensity(cc.Density.DENSITY_KNN, radius, [cloud], knn=k):
+    raise RuntimeError
+#---computeFeaturesKnn02-end
+dic = cloud.getScalarFieldDic()
+print(dic)
+sphereName = "Number of neighbors (r=%g)" % radius
+hybridName = "Number of neighbors (r=%g, k=%d)" % (radius, k)
+if sphereName not in dic or hybridName not in dic:
+    raise RuntimeError
+nbSphere = cloud.getScalarField(dic[sphereName]).toNpArrayCopy()
+nbHybrid = cloud.getScalarField(dic[hybridName]).toNpArrayCopy()
+if nbHybrid.max() > k:
+    raise RuntimeError
+if not np.array_equal(nbHybrid, np.minimum(nbSphere, k)):
+    raise RuntimeError
+
+# --- invalid parameters
+
+if cc.computeMultiScaleFeatures([cc.GeomFeature.Planarity], [0.], [cloud]):
+    raise RuntimeError
+if cc.computeFeatures([cc.GeomFeature.Planarity], -1., [cloud], knn=k):
+    raise RuntimeError
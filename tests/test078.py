@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+# --- covariance matrices of random neighbourhoods: isotropic, planar, linear, and degenerate cases
+
+rng = np.random.default_rng(42)
+n = 100000
+pts = rng.normal(size=(n, 20, 3))
+scales = np.array([[1., 1., 1.], [1., 1., 1.e-4], [1., 1.e-4, 1.e-5], [1., 1., 1.], [1., 0.9, 0.1]])
+pts *= scales[np.arange(n) % len(scales)][:, np.newaxis, :]
+rot, _ = np.linalg.qr(rng.normal(size=(n, 3, 3)))
+pts = pts @ rot
+centered = pts - pts.mean(axis=1, keepdims=True)
+matrices = np.einsum('nki,nkj->nij', centered, centered) / 20.
+matrices[3::50] = np.diag([2., 2., 2.])     # triple eigen value
+matrices[8::50] = np.diag([3., 3., 1.])     # double eigen value
+matrices[13::50] = 0.                       # null matrix
+
+#---symEigen01-begin
+t0 = time.time()
+values, vectors = cc.computeSymmetricEigen3x3(matrices)
+t1 = time.time()
+valuesJ, vectorsJ = cc.computeSymmetricEigen3x3(matrices, useJacobi=True)
+t2 = time.time()
+#---symEigen01-end
+print("closed-form: %.0f matrices/s, Jacobi: %.0f matrices/s" % (n / max(t1 - t0, 1.e-9), n / max(t2 - t1, 1.e-9)))
+
+if values.shape != (n, 3) or vectors.shape != (n, 3, 3):
+    raise RuntimeError
+
+scale = np.maximum(np.abs(matrices).max(axis=(1, 2)), 1.e-300)
+
+# decreasing order
+if (np.diff(values, axis=1) > 1.e-12 * scale[:, np.newaxis]).any():
+    raise RuntimeError
+
+# same eigen values as Jacobi and numpy
+ref = np.linalg.eigvalsh(matrices)[:, ::-1]
+errRef = (np.abs(values - ref).max(axis=1) / scale).max()
+errJacobi = (np.abs(values - valuesJ).max(axis=1) / scale).max()
+print("eigen values, max relative error: numpy %g Jacobi %g" % (errRef, errJacobi))
+if errRef > 1.e-10 or errJacobi > 1.e-6:
+    raise RuntimeError
+
+# orthonormal eigen vectors, A.v = l.v
+orth = np.abs(np.einsum('nik,nil->nkl', vectors, vectors) - np.eye(3)).max()
+residual = (np.linalg.norm(matrices @ vectors - vectors * values[:, np.newaxis, :], axis=1).max(axis=1) / scale).max()
+print("eigen vectors: orthonormality %g residual %g" % (orth, residual))
+if orth > 1.e-10 or residual > 1.e-8:
+    raise RuntimeError
+
+# same eigen vectors as Jacobi (up to the sign), when the eigen values are well separated
+gaps = np.minimum(np.abs(np.diff(valuesJ, axis=1, prepend=np.inf)), np.abs(np.diff(valuesJ, axis=1, append=-np.inf))) / scale[:, np.newaxis]
+dots = np.abs(np.einsum('nik,nik->nk', vectors, vectorsJ))
+separated = gaps > 1.e-3
+dev = np.abs(1. - dots[separated]).max()
+print("eigen vectors vs Jacobi: %d separated eigen values, max deviation %g" % (np.count_nonzero(separated), dev))
+if dev > 1.e-6:
+    raise RuntimeError
+
+# --- the geometric features of computeFeatures rely on this solver: compare with the CCCoreLib computation
+# (computeFeature with a radius: Jacobi per point, independent of the closed-form solver)
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+cloud.deleteAllScalarFields()
+radius = 0.06
+ref = cloud.cloneThis()
+features = [cc.GeomFeature.Planarity, cc.GeomFeature.Linearity, cc.GeomFeature.SurfaceVariation, cc.GeomFeature.Verticality]
+for f in features:
+    if not cc.computeFeature(f, radius, [ref]):
+        raise RuntimeError
+if not cc.computeFeatures(features, radius, [cloud]):
+    raise RuntimeError
+dic = cloud.getScalarFieldDic()
+refDic = ref.getScalarFieldDic()
+for name in refDic:
+    a = cloud.getScalarField(dic[name]).toNpArrayCopy().astype(np.float64)
+    b = ref.getScalarField(refDic[name]).toNpArrayCopy().astype(np.float64)
+    close = np.isclose(a, b, rtol=1.e-3, atol=1.e-3, equal_nan=True)
+    ratio = 1. - np.count_nonzero(close) / len(a)
+    print("%s: mismatch ratio %f" % (name, ratio))
+    if ratio > 0.001:
+        raise RuntimeError
+
+if cc.computeSymmetricEigen3x3(np.zeros((0, 3, 3)))[0].shape != (0, 3):
+    raise RuntimeError
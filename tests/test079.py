@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+cloud.deleteAllScalarFields()
+cloud.computeOctree() # not a part of the estimation cost
+
+#---spacing01-begin
+t0 = time.time()
+stats = cc.EstimatePointCloudSpacing(cloud, knn=12, sampleCount=2000)
+t1 = time.time()
+print("spacing: %g, radius for 12 points: median %g, percentiles %g %g %g %g (%d samples, %f s)"
+      % (stats.nearestMedian, stats.median, stats.p10, stats.p25, stats.p75, stats.p90, stats.sampleCount, t1 - t0))
+#---spacing01-end
+if stats.knn != 12 or stats.sampleCount != 2000:
+    raise RuntimeError
+if not (0 < stats.nearestMedian <= stats.median):
+    raise RuntimeError
+if not (stats.p10 <= stats.p25 <= stats.median <= stats.p75 <= stats.p90):
+    raise RuntimeError
+
+# deterministic for a given seed
+again = cc.EstimatePointCloudSpacing(cloud, knn=12, sampleCount=2000)
+if again.median != stats.median or again.p90 != stats.p90:
+    raise RuntimeError
+
+# the median radius holds about 12 points (the point itself included) for the median point of the whole cloud
+radius = cc.EstimatePointCloudRadius([cloud])
+if radius != stats.median:
+    raise RuntimeError
+if not cc.computeLocalDensity(cc.Density.DENSITY_KNN, radius, [cloud]):
+    raise RuntimeError
+dic = cloud.getScalarFieldDic()
+counts = cloud.getScalarField(dic[list(dic.keys())[0]]).toNpArrayCopy()
+print("neighbours within the estimated radius: median %g" % np.median(counts))
+if abs(np.median(counts) - 12) > 2:
+    raise RuntimeError
+cloud.deleteAllScalarFields()
+
+# default radius of the curvature and the density
+if not cc.computeCurvature(cc.CurvatureType.MEAN_CURV, 0., [cloud]):
+    raise RuntimeError
+if not cc.computeLocalDensity(cc.Density.DENSITY_3D, 0., [cloud]):
+    raise RuntimeError
+dic = cloud.getScalarFieldDic()
+print(dic)
+if len(dic) != 2:
+    raise RuntimeError
+cloud.deleteAllScalarFields()
+
+# the entities which are not clouds are skipped by the estimation, no usable cloud: failure
+box = cc.ccBox((1., 2., 3.))
+if not cc.computeCurvature(cc.CurvatureType.MEAN_CURV, 0., [box, cloud]):
+    raise RuntimeError
+if cc.computeCurvature(cc.CurvatureType.MEAN_CURV, 0., [box]):
+    raise RuntimeError
+if cc.computeLocalDensity(cc.Density.DENSITY_3D, 0., [box]):
+    raise RuntimeError
+
+# small cloud: all the points are used
+count = 500
+refCloud = cc.CloudSamplingTools.subsampleCloudRandomly(cloud, count)
+(small, res) = cloud.partialClone(refCloud)
+st = cc.EstimatePointCloudSpacing(small, 6, 2000)
+if st.sampleCount != count:
+    raise RuntimeError
+
+# default radius of the normals
+if not cc.computeNormals([small]):
+    raise RuntimeError
+if not small.hasNormals():
+    raise RuntimeError
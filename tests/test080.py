@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.1))
+coords = cloud.toNpArrayCopy()
+radius = cc.EstimatePointCloudRadius([cloud])
+
+# many small tiles of the cloud
+def makeTiles(n):
+    tiles = []
+    xs = np.linspace(coords[:,0].min(), coords[:,0].max() + 1.e-3, n + 1)
+    ys = np.linspace(coords[:,1].min(), coords[:,1].max() + 1.e-3, n + 1)
+    for i in range(n):
+        for j in range(n):
+            sel = (coords[:,0] >= xs[i]) & (coords[:,0] < xs[i+1]) & (coords[:,1] >= ys[j]) & (coords[:,1] < ys[j+1])
+            if sel.sum() < 10:
+                continue
+            tile = cc.ccPointCloud("tile_%d_%d" % (i, j))
+            tile.coordsFromNPArray_copy(np.ascontiguousarray(coords[sel]))
+            tiles.append(tile)
+    return tiles
+
+tilesSeq = makeTiles(10)
+tilesPar = makeTiles(10)
+print("%d tiles" % len(tilesPar))
+
+# one call per tile: sequential
+t0 = time.time()
+for tile in tilesSeq:
+    if not cc.computeNormals([tile], defaultRadius=radius, orientNormalsMST=False):
+        raise RuntimeError
+t1 = time.time()
+
+#---normalsTiles01-begin
+# one call for all the tiles: the points of all the tiles are shared between the threads
+t2 = time.time()
+ok = cc.computeNormals(tilesPar, defaultRadius=radius, orientNormalsMST=False,
+                       preferredOrientation=cc.Orientation.PLUS_Z)
+t3 = time.time()
+#---normalsTiles01-end
+print("normals: %f s one tile at a time, %f s all tiles together" % (t1 - t0, t3 - t2))
+if not ok:
+    raise RuntimeError
+
+# same normals, up to the sign, oriented towards +Z
+agree = 0
+total = 0
+for seq, par in zip(tilesSeq, tilesPar):
+    if not par.hasNormals():
+        raise RuntimeError
+    ns = seq.normalsToNpArrayCopy()
+    npar = par.normalsToNpArrayCopy()
+    if npar.shape != ns.shape:
+        raise RuntimeError
+    if (npar[:,2] < -1.e-6).any():
+        raise RuntimeError
+    dots = np.abs((ns * npar).sum(axis=1))
+    agree += (dots > 0.999).sum()
+    total += len(dots)
+print("normals agreeing: %d / %d" % (agree, total))
+if agree < 0.99 * total:
+    raise RuntimeError
+
+# a single cloud still follows the original path
+single = makeTiles(1)[0]
+if not cc.computeNormals([single], defaultRadius=radius):
+    raise RuntimeError
+if not single.hasNormals():
+    raise RuntimeError
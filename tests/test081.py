@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+cloud = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.02))
+if not cc.computeNormals([cloud], orientNormals=False):
+    raise RuntimeError
+unoriented = cloud.normalsToNpArrayCopy()
+cloudPar = cloud.cloneThis()
+
+# reference: serial minimum spanning tree
+t0 = time.time()
+if not cloud.orientNormalsWithMST(6):
+    raise RuntimeError
+t1 = time.time()
+
+#---orientParallel01-begin
+t2 = time.time()
+if not cloudPar.orientNormalsWithParallelMST(knn=6):
+    raise RuntimeError
+t3 = time.time()
+#---orientParallel01-end
+print("orientation of %d normals: MST %f s, parallel MST %f s" % (cloud.size(), t1 - t0, t3 - t2))
+
+nMST = cloud.normalsToNpArrayCopy()
+nPar = cloudPar.normalsToNpArrayCopy()
+
+# the normals are only flipped
+if (np.abs((unoriented * nPar).sum(axis=1)) < 0.999).any():
+    raise RuntimeError
+
+# consistency with the MST result: fraction of points with the same orientation, up to a global flip
+same = ((nMST * nPar).sum(axis=1) > 0).mean()
+consistency = max(same, 1. - same)
+print("consistency with MST: %f" % consistency)
+if consistency < 0.95:
+    raise RuntimeError
+
+# invalid inputs
+noNormals = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.1))
+if noNormals.orientNormalsWithParallelMST():
+    raise RuntimeError
+if cloudPar.orientNormalsWithParallelMST(knn=0):
+    raise RuntimeError
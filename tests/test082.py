@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+# a synthetic scan from a sensor at the origin: a cylindrical wall (radius 10) and a floor (z=-2)
+azStep = math.radians(0.2)
+elStep = math.radians(0.2)
+az = np.arange(0., math.pi, azStep)
+el = np.arange(math.radians(-40.), math.radians(30.), elStep)
+cols, rows = np.meshgrid(np.arange(len(az)), np.arange(len(el))[::-1])
+A, E = np.meshgrid(az, el)
+d = np.stack([np.cos(E) * np.cos(A), np.cos(E) * np.sin(A), np.sin(E)], axis=-1).reshape(-1, 3)
+tWall = 10. / np.cos(E.ravel())
+tFloor = np.where(d[:,2] < 0, -2. / np.minimum(d[:,2], -1.e-9), np.inf)
+t = np.minimum(tWall, tFloor)
+coords = (d * t[:,None]).astype(np.float32)
+onFloor = tFloor < tWall
+
+# points in any order, as written by a converter
+order = np.random.default_rng(0).permutation(len(coords))
+coords = coords[order]
+onFloor = onFloor[order]
+rows = rows.ravel()[order]
+cols = cols.ravel()[order]
+
+cloud = cc.ccPointCloud("scan")
+cloud.coordsFromNPArray_copy(coords)
+print("%d points" % cloud.size())
+
+#---scanGrid01-begin
+n = cloud.addScanGridFromIndices(rows.astype(np.int32), cols.astype(np.int32), sensorCenter=(0., 0., 0.))
+#---scanGrid01-end
+if n != cloud.size() or cloud.gridCount() != 1:
+    raise RuntimeError
+
+t0 = time.time()
+if not cc.computeNormals([cloud], useScanGridsForComputation=True):
+    raise RuntimeError
+t1 = time.time()
+octreeCloud = cloud.cloneThis()
+octreeCloud.removeGrids()
+if octreeCloud.gridCount() != 0:
+    raise RuntimeError
+t2 = time.time()
+if not cc.computeNormals([octreeCloud], defaultRadius=0.2, orientNormalsMST=False,
+                         preferredOrientation=cc.Orientation.PLUS_Z):
+    raise RuntimeError
+t3 = time.time()
+print("normals: %f s with the scan grid, %f s with the octree" % (t1 - t0, t3 - t2))
+
+def checkNormals(normals):
+    """expected normals: vertical on the floor, horizontal towards the sensor on the wall"""
+    expected = np.where(onFloor[:,None], np.array([0., 0., 1.]), -coords * np.array([1., 1., 0.]))
+    expected /= np.linalg.norm(expected, axis=1)[:,None]
+    good = ((normals * expected).sum(axis=1) > 0.99).mean()
+    print("normals as expected: %f" % good)
+    return good
+
+if checkNormals(cloud.normalsToNpArrayCopy()) < 0.95:
+    raise RuntimeError
+
+#---scanGrid02-begin
+# the same grid, from the sensor angles
+byAngles = cc.ccPointCloud("scanByAngles")
+byAngles.coordsFromNPArray_copy(coords)
+azimuths = np.arctan2(coords[:,1], coords[:,0]).astype(np.float64)
+elevations = np.arctan2(coords[:,2], np.hypot(coords[:,0], coords[:,1])).astype(np.float64)
+n = byAngles.addScanGridFromAngles(azimuths, elevations, azStep, elStep)
+#---scanGrid02-end
+print("%d points in the grid from the angles" % n)
+if n < 0.99 * byAngles.size():
+    raise RuntimeError
+if not cc.computeNormals([byAngles], useScanGridsForComputation=True):
+    raise RuntimeError
+if checkNormals(byAngles.normalsToNpArrayCopy()) < 0.95:
+    raise RuntimeError
+
+# invalid inputs
+try:
+    cloud.addScanGridFromIndices(rows[:10].astype(np.int32), cols[:10].astype(np.int32))
+    raise RuntimeError
+except ValueError:
+    pass
+try:
+    cloud.addScanGridFromIndices(rows.astype(np.int32), cols.astype(np.int32), width=10)
+    raise RuntimeError
+except ValueError:
+    pass
+try:
+    cloud.addScanGridFromAngles(azimuths, elevations, 0., elStep)
+    raise RuntimeError
+except ValueError:
+    pass
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+##########################################################################
+#                                                                        #
+#                              CloudComPy                                #
+#                                                                        #
+#  This program is free software; you can redistribute it and/or modify  #
+#  it under the terms of the GNU General Public License as published by  #
+#  the Free Software Foundation; either version 3 of the License, or     #
+#  any later version.                                                    #
+#                                                                        #
+#  This program is distributed in the hope that it will be useful,       #
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of        #
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          #
+#  GNU General Public License for more details.                          #
+#                                                                        #
+#  You should have received a copy of the GNU General Public License     #
+#  along with this program. If not, see <https://www.gnu.org/licenses/>. #
+#                                                                        #
+#          Copyright 2020-2021 Paul RASCLE www.openfields.fr             #
+#                                                                        #
+##########################################################################
+
+import os
+import sys
+import math
+import time
+import numpy as np
+
+os.environ["_CCTRACE_"]="ON" # only if you want C++ debug traces
+
+from gendata import getSampleCloud2, dataDir, createSymbolicLinks
+import cloudComPy as cc
+
+createSymbolicLinks() # required for tests on build, before cc.initCC
+
+sample = cc.loadPointCloud(getSampleCloud2(5.0, 0, 0.05))
+coords = sample.toNpArrayCopy()
+radius = cc.EstimatePointCloudRadius([sample])
+
+# an acquisition in two parts: the cloud, then a strip
+xLimit = coords[:,0].min() + 0.9 * (coords[:,0].max() - coords[:,0].min())
+first = coords[coords[:,0] < xLimit]
+second = coords[coords[:,0] >= xLimit]
+cloud = cc.ccPointCloud("cloud")
+cloud.coordsFromNPArray_copy(np.ascontiguousarray(first))
+strip = cc.ccPointCloud("strip")
+strip.coordsFromNPArray_copy(np.ascontiguousarray(second))
+
+if not cc.computeNormals([cloud], defaultRadius=radius, orientNormalsMST=False,
+                         preferredOrientation=cc.Orientation.PLUS_Z):
+    raise RuntimeError
+if not cc.computeFeatures([cc.GeomFeature.Planarity], radius, [cloud]):
+    raise RuntimeError
+sfName = [name for name in cloud.getScalarFieldDic() if name.startswith("Planarity")][0]
+
+#---incremental01-begin
+firstNewPoint = cloud.size()
+cloud.fuse(strip)
+t0 = time.time()
+if not cc.updateNormalsAfterAppend(cloud, firstNewPoint):
+    raise RuntimeError
+if not cc.updateFeaturesAfterAppend([cc.GeomFeature.Planarity], [radius], cloud, firstNewPoint):
+    raise RuntimeError
+t1 = time.time()
+#---incremental01-end
+
+# reference: the whole cloud computed at once (same points, same order)
+full = cc.ccPointCloud("full")
+full.coordsFromNPArray_copy(np.ascontiguousarray(np.concatenate((first, second))))
+t2 = time.time()
+if not cc.computeNormals([full], defaultRadius=radius, orientNormalsMST=False,
+                         preferredOrientation=cc.Orientation.PLUS_Z):
+    raise RuntimeError
+if not cc.computeFeatures([cc.GeomFeature.Planarity], radius, [full]):
+    raise RuntimeError
+t3 = time.time()
+print("%d new points on %d: update %f s, whole cloud %f s" % (cloud.size() - firstNewPoint, cloud.size(), t1 - t0, t3 - t2))
+
+# same features as a whole computation
+dic = cloud.getScalarFieldDic()
+if len([name for name in dic if name.startswith("Planarity")]) != 1:
+    raise RuntimeError
+incremental = cloud.getScalarField(dic[sfName]).toNpArrayCopy()
+reference = full.getScalarField(full.getScalarFieldDic()[sfName]).toNpArrayCopy()
+if not np.allclose(incremental, reference, atol=1.e-5, equal_nan=True):
+    raise RuntimeError
+
+# same normals up to the orientation, the new normals oriented as their former neighbours (+Z)
+nInc = cloud.normalsToNpArrayCopy()
+nRef = full.normalsToNpArrayCopy()
+if (np.abs((nInc * nRef).sum(axis=1)) < 0.999).mean() > 0.01:
+    raise RuntimeError
+if (nInc[firstNewPoint:, 2] < 0).mean() > 0.01:
+    raise RuntimeError
+
+# invalid inputs
+try:
+    cc.updateNormalsAfterAppend(cloud, cloud.size() + 1)
+    raise RuntimeError
+except ValueError:
+    pass